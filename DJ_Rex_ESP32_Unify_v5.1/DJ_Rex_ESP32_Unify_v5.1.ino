@@ -97,6 +97,7 @@
 /////////////////////////////////////////////////////////////////////////////////
 
 
+#include "config.h"  // v5.2: Must precede FastLED.h (render clock hook)
 #include <FastLED.h>
 #include <Preferences.h>
 #include <freertos/FreeRTOS.h>
@@ -104,7 +105,6 @@
 #include <freertos/semphr.h>
 #include <esp_system.h>
 
-#include "config.h"
 #include "globals.h"
 #include "patterns_body.h"
 #include "patterns_mouth.h"
@@ -122,14 +122,24 @@
 #include "pattern_manager.h"
 #include "startup_sequence.h"
 
-// Combined LED array for Eyes + Mouth
-CRGB eyesMouthLEDs[NUM_EYES + NUM_MOUTH_LEDS];
+// v5.2 New modules
+#include "led_output.h"
+#include "frame_profiler.h"
+#include "render_clock.h"
+#include "geometry.h"
+#include "beat_detector.h"
+#include "transition.h"
+#include "pattern_arena.h"
 
 // v5.0: FreeRTOS handles
 #if ENABLE_FREERTOS_AUDIO
 TaskHandle_t audioTaskHandle = NULL;
-SemaphoreHandle_t ledMutex = NULL;
 #endif
+// v5.2: The LED mutex is needed on both boards now that rendering runs in its own task
+SemaphoreHandle_t ledMutex = NULL;
+TaskHandle_t renderTaskHandle = NULL;
+
+void renderTask(void* parameter);
 
 // v5.0: Audio task running on Core 0
 #if ENABLE_FREERTOS_AUDIO
@@ -140,7 +150,10 @@ void audioTask(void* parameter) {
     Serial.println(F("Audio task started on Core 0"));
 
     for (;;) {
+        // v5.2: Sole writer of the audio state; golden-frame runs hold the lock
+        lockAudioUpdates();
         updateAudio();
+        unlockAudioUpdates();
         vTaskDelayUntil(&xLastWakeTime, xFrequency);
     }
 }
@@ -178,27 +191,28 @@ void setup() {
     analogSetAttenuation(ADC_11db);
 
     // v5.0: Create LED mutex for thread safety
-    #if ENABLE_FREERTOS_AUDIO
     ledMutex = xSemaphoreCreateMutex();
     if (ledMutex == NULL) {
         Serial.println(F("ERROR: Failed to create LED mutex!"));
     } else {
         Serial.println(F("LED mutex created"));
     }
-    #endif
 
     initSettings();
 
-    FastLED.addLeds<LED_TYPE, LED_PIN_RIGHT, COLOR_ORDER>(DJLEDs_Right, NUM_LEDS_PER_PANEL);
-    FastLED.addLeds<LED_TYPE, LED_PIN_MIDDLE, COLOR_ORDER>(DJLEDs_Middle, NUM_LEDS_PER_PANEL);
-    FastLED.addLeds<LED_TYPE, LED_PIN_LEFT, COLOR_ORDER>(DJLEDs_Left, NUM_LEDS_PER_PANEL);
-    FastLED.addLeds<LED_TYPE, EYES_MOUTH_PIN, COLOR_ORDER>(eyesMouthLEDs, NUM_EYES + NUM_MOUTH_LEDS);
+    // v5.2: LED output sets up the configured output backend
+    ledOutput.begin();
 
     FastLED.setBrightness(ledBrightness);
 
-    FastLED.clear();
-    FastLED.show();
+    // v5.2: Clear through LedOutput - the parallel backend registers no FastLED controllers
+    for (uint8_t i = 0; i < NUM_LED_OUTPUTS; i++) {
+        fill_solid(ledOutputs[i].leds, ledOutputs[i].count, CRGB::Black);
+    }
+    ledOutput.showAll();
 
+    initializeGeometry();
+    resetFrameClock();  // v5.2: The animation clock starts at the render clock
     initializeHelpers();
     initializeEyes();
     initializeAudio();
@@ -209,6 +223,10 @@ void setup() {
     systemMonitor.begin();
     patternManager.begin();
 
+    #if ENABLE_FRAME_PROFILER
+    frameProfiler.begin();
+    #endif
+
     // v5.0: Run startup sequence if enabled
     if (startupSequenceEnabled) {
         startupSequence.begin();
@@ -235,85 +253,66 @@ void setup() {
     Serial.println(AUDIO_TASK_CORE);
     #endif
 
+    // v5.2: Create the frame-paced render task
+    xTaskCreatePinnedToCore(
+        renderTask,
+        "RenderTask",
+        RENDER_TASK_STACK_SIZE,
+        NULL,
+        RENDER_TASK_PRIORITY,
+        &renderTaskHandle,
+        RENDER_TASK_CORE
+    );
+    Serial.print(F("Render task created on Core "));
+    Serial.print(RENDER_TASK_CORE);
+    Serial.print(F(" ("));
+    Serial.print(targetFPS);
+    Serial.println(F(" fps)"));
+
     Serial.println(F(""));
     Serial.println(F("System ready! Type 'help' for commands."));
     Serial.println(F(""));
     printCurrentSettings();
 }
 
-void mapEyesMouthArrays() {
-    memcpy(&eyesMouthLEDs[0], DJLEDs_Eyes, NUM_EYES * sizeof(CRGB));
-    memcpy(&eyesMouthLEDs[NUM_EYES], DJLEDs_Mouth, NUM_MOUTH_LEDS * sizeof(CRGB));
-}
-
-// Function to start a transition
-void startTransition(uint8_t newPattern) {
-    if (newPattern == currentPattern) return; // Don't transition to the same pattern
-
-    // 1. Copy the current, final LED state to the "old" arrays
-    memcpy(old_DJLEDs_Right, DJLEDs_Right, sizeof(DJLEDs_Right));
-    memcpy(old_DJLEDs_Middle, DJLEDs_Middle, sizeof(DJLEDs_Middle));
-    memcpy(old_DJLEDs_Left, DJLEDs_Left, sizeof(DJLEDs_Left));
-    memcpy(old_DJLEDs_Eyes, DJLEDs_Eyes, sizeof(DJLEDs_Eyes));
-    memcpy(old_DJLEDs_Mouth, DJLEDs_Mouth, sizeof(DJLEDs_Mouth));
-
-    // 2. Set the new pattern
-    currentPattern = newPattern;
-
-    // 3. Start the transition timer
-    transitionActive = true;
-    transitionStartTime = millis();
-}
-
-// Function that handles the blending logic during a transition
-void handleTransition() {
-    if (!transitionActive) {
-        return; // Nothing to do
-    }
-
-    unsigned long elapsed = millis() - transitionStartTime;
-
-    if (elapsed >= transitionDuration) {
-        transitionActive = false; // Transition is over
-        return;
-    }
-
-    // Calculate how far along the blend is (0-255)
-    uint8_t blendAmount = map(elapsed, 0, transitionDuration, 0, 255);
-
-    // Blend each LED array
-    // The "new" pattern has already been calculated and is in the main DJLEDs arrays.
-    // We blend the saved "old" state into the "new" state.
-    blend(old_DJLEDs_Right, DJLEDs_Right, DJLEDs_Right, NUM_LEDS_PER_PANEL, blendAmount);
-    blend(old_DJLEDs_Middle, DJLEDs_Middle, DJLEDs_Middle, NUM_LEDS_PER_PANEL, blendAmount);
-    blend(old_DJLEDs_Left, DJLEDs_Left, DJLEDs_Left, NUM_LEDS_PER_PANEL, blendAmount);
-    blend(old_DJLEDs_Eyes, DJLEDs_Eyes, DJLEDs_Eyes, NUM_EYES, blendAmount);
-    blend(old_DJLEDs_Mouth, DJLEDs_Mouth, DJLEDs_Mouth, NUM_MOUTH_LEDS, blendAmount);
-}
-
 void handlePlaylist() {
     if (!playlistActive || playlistSize == 0) {
         return;
     }
 
-    if (millis() - playlistPatternStartTime >= (playlist[playlistIndex].duration * 1000UL)) {
+    // v5.2: A due switch waits for the next downbeat when the beat detector has a lock
+    uint32_t elapsed = renderMillis() - playlistPatternStartTime;
+    uint32_t duration = playlist[playlistIndex].duration * 1000UL;
+    if (elapsed >= duration && beatDetector.isSwitchPoint(elapsed - duration)) {
         playlistIndex++;
         if (playlistIndex >= playlistSize) {
             playlistIndex = 0;
         }
 
-        // Start a transition instead of changing the pattern directly
-        startTransition(playlist[playlistIndex].pattern);
-        playlistPatternStartTime = millis();
+        // Start a transition instead of changing the pattern directly,
+        // with the entry's own transition where it has one
+        const PlaylistEntry& entry = playlist[playlistIndex];
+        uint8_t mode = (entry.transitionMode != TRANSITION_MODE_DEFAULT) ? entry.transitionMode : transitionMode;
+        uint16_t ms = (entry.transitionMs != TRANSITION_MS_DEFAULT) ? entry.transitionMs : transitionDuration;
+        transitionEngine.start(entry.pattern, mode, ms);
+        playlistPatternStartTime = renderMillis();
 
         Serial.print(F("Playlist: Transitioning to pattern "));
         Serial.println(playlist[playlistIndex].pattern);
     }
 }
 
-void loop() {
-    // v5.0: System monitoring update
-    systemMonitor.update();
+// v5.2: Compute and output exactly one frame
+void renderFrame() {
+    // v5.2: One clock snapshot for everything this frame renders
+    const FrameContext& frame = beginFrame(timeScale);
+
+    #if !ENABLE_FREERTOS_AUDIO
+    // v5.2: No audio task on single-core boards - update the audio state once per frame
+    updateAudio();
+    #endif
+    // v5.2: All patterns of this frame see the same audio features
+    takeAudioSnapshot();
 
     handlePlaylist();
 
@@ -321,50 +320,101 @@ void loop() {
     if (requestedPattern != -1) {
         // v5.0: Log pattern change
         eventLogger.log(EVENT_PATTERN_CHANGE, requestedPattern);
-        startTransition(requestedPattern);
+        transitionEngine.start(requestedPattern);
         requestedPattern = -1; // Reset request
     }
 
-    if (checkSerialCommand()) {
-        processSerialCommand();
-    }
-
     if (demoMode) {
         handleDemoMode();
     }
 
-    // Always run the current pattern logic
-    gPatterns[currentPattern]();
+    PERF_BEGIN(PERF_BODY_PATTERN);
+    bodyArena.render(currentPattern);
+    PERF_END(PERF_BODY_PATTERN);
 
     if (currentPattern != 0) {
+        PERF_BEGIN(PERF_EYES);
         updateEyes();
+        PERF_END(PERF_EYES);
     }
 
     if (mouthEnabled && currentPattern != 0) {
+        PERF_BEGIN(PERF_MOUTH);
         updateMouth();
+        PERF_END(PERF_MOUTH);
     }
 
-    // After calculating the new pattern, apply the transition blend if active
-    handleTransition();
+    // v5.2: During a transition the outgoing pattern renders next, then both
+    // frames are composited into allLEDs
+    PERF_BEGIN(PERF_TRANSITION);
+    transitionEngine.update();
+    PERF_END(PERF_TRANSITION);
+
+    // v5.2: Eyes and mouth render straight into eyesMouthLEDs - no copy needed.
+    // Only outputs whose contents changed are sent.
+    PERF_BEGIN(PERF_LED_SHOW);
+    ledOutput.show();
+    PERF_END(PERF_LED_SHOW);
+
+    // v5.2: One hue step per 20 ms of animation time, at any frame rate
+    static uint16_t hueRest = 0;
+    gHue += advanceBy(hueRest, frame.dt, 1);
+}
+
+// v5.2: Render task - one frame per period, paced by vTaskDelayUntil
+void renderTask(void* parameter) {
+    const uint32_t tickUs = 1000000UL / configTICK_RATE_HZ;
+    TickType_t xLastWakeTime = xTaskGetTickCount();
+    uint32_t deadlineRestUs = 0;  // Frame period not yet covered by whole ticks
 
-    static unsigned long LEDUpdateMillis = 0;
-    if (millis() - LEDUpdateMillis > 20) {
-        LEDUpdateMillis = millis();
+    Serial.println(F("Render task started"));
+
+    for (;;) {
+        // One period drives both the wakeups and the budget; 60 fps alternates
+        // 16 and 17 ms ticks instead of running at 1000 / 16 = 62.5 fps
+        uint32_t framePeriodUs = 1000000UL / targetFPS;
+
+        if (renderPaused) {
+            // A console command owns the LEDs - idle without counting frames
+            vTaskDelay(pdMS_TO_TICKS(LED_MUTEX_TIMEOUT_MS));
+            xLastWakeTime = xTaskGetTickCount();
+            deadlineRestUs = 0;
+            continue;
+        }
 
-        // v5.0: Thread-safe LED update with mutex
-        #if ENABLE_FREERTOS_AUDIO
-        if (ledMutex != NULL && xSemaphoreTake(ledMutex, pdMS_TO_TICKS(LED_MUTEX_TIMEOUT_MS)) == pdTRUE) {
-            mapEyesMouthArrays();
-            FastLED.show();
+        uint32_t frameStart = micros();
+
+        // Serial commands are applied between frames, never in the middle of one
+        if (xSemaphoreTake(ledMutex, pdMS_TO_TICKS(LED_MUTEX_TIMEOUT_MS)) == pdTRUE) {
+            renderFrame();
             xSemaphoreGive(ledMutex);
         }
-        #else
-        mapEyesMouthArrays();
-        FastLED.show();
-        #endif
+
+        if (!renderPaused) {
+            systemMonitor.recordFrame(micros() - frameStart, framePeriodUs);
+        }
+
+        deadlineRestUs += framePeriodUs;
+        TickType_t periodTicks = deadlineRestUs / tickUs;
+        deadlineRestUs -= periodTicks * tickUs;
+        vTaskDelayUntil(&xLastWakeTime, periodTicks);
     }
+}
 
-    EVERY_N_MILLISECONDS(20) {
-        gHue++;
+void loop() {
+    // v5.0: System monitoring update
+    systemMonitor.update();
+
+    // v5.2: Rendering runs in renderTask - the loop only serves the console
+    if (checkSerialCommand()) {
+        // Wait for the current frame to finish (bounded by the frame time)
+        if (xSemaphoreTake(ledMutex, portMAX_DELAY) == pdTRUE) {
+            PERF_BEGIN(PERF_SERIAL_COMMAND);
+            processSerialCommand();
+            PERF_END(PERF_SERIAL_COMMAND);
+            xSemaphoreGive(ledMutex);
+        }
     }
+
+    vTaskDelay(1);
 }
\ No newline at end of file
@@ -0,0 +1,305 @@
+// adc_stream.cpp - v5.2 Continuous DMA ADC Sampling
+#include "adc_stream.h"
+#include "audio.h"
+#include "beat_detector.h"
+#include "render_clock.h"
+#include "audio_replay.h"
+#include "filter_bank.h"
+#include <esp_idf_version.h>
+#include <math.h>
+#include <atomic>
+
+// The continuous ADC driver (esp_adc) ships with ESP-IDF 5.1+ (esp32 core
+// 3.x). Older cores keep the analogRead() path.
+#if ENABLE_ADC_DMA && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 1, 0)
+#define USE_ADC_DMA 1
+#include <esp_adc/adc_continuous.h>
+#include <soc/soc_caps.h>
+#else
+#define USE_ADC_DMA 0
+#endif
+
+AdcStream adcStream;
+
+#if ADC_ISR_RING
+static volatile uint32_t ringOverruns = 0;
+#else
+// Incremented from the driver ISR whenever the DMA pool was full and got flushed
+static volatile uint32_t poolOverruns = 0;
+#endif
+
+#if USE_ADC_DMA
+static adc_unit_t micUnit;
+static adc_channel_t micChannel;
+
+#if ADC_ISR_RING
+static_assert((ADC_RING_SAMPLES & (ADC_RING_SAMPLES - 1)) == 0, "ADC_RING_SAMPLES must be a power of two");
+
+// Single producer (DMA ISR) / single consumer (render loop) ring of raw
+// samples. Each side only writes its own index; indices run freely and are
+// masked on access.
+static uint16_t sampleRing[ADC_RING_SAMPLES];
+static std::atomic<uint32_t> ringHead(0);
+static std::atomic<uint32_t> ringTail(0);
+static volatile uint32_t ringForeignSamples = 0;
+
+static bool IRAM_ATTR onConversionDone(adc_continuous_handle_t /*handle*/, const adc_continuous_evt_data_t* edata, void* /*userData*/) {
+    uint32_t head = ringHead.load(std::memory_order_relaxed);
+    uint32_t tail = ringTail.load(std::memory_order_acquire);
+
+    for (uint32_t i = 0; i + SOC_ADC_DIGI_RESULT_BYTES <= edata->size; i += SOC_ADC_DIGI_RESULT_BYTES) {
+        const adc_digi_output_data_t* data = (const adc_digi_output_data_t*)&edata->conv_frame_buffer[i];
+        if (data->type2.channel != micChannel || data->type2.unit != micUnit) {
+            ringForeignSamples++;
+            continue;
+        }
+        if (head - tail >= ADC_RING_SAMPLES) {
+            ringOverruns++;  // Consumer stalled - drop the newest
+            continue;
+        }
+        sampleRing[head & (ADC_RING_SAMPLES - 1)] = data->type2.data;
+        head++;
+    }
+
+    ringHead.store(head, std::memory_order_release);
+    return false;
+}
+#else
+static bool IRAM_ATTR onPoolOverflow(adc_continuous_handle_t /*handle*/, const adc_continuous_evt_data_t* /*edata*/, void* /*userData*/) {
+    poolOverruns++;
+    return false;
+}
+#endif
+#endif
+
+bool AdcStream::begin() {
+    #if USE_ADC_DMA
+    if (adc_continuous_io_to_channel(MIC_PIN, &micUnit, &micChannel) != ESP_OK || micUnit != ADC_UNIT_1) {
+        Serial.println(F("ERROR: MIC_PIN has no ADC1 channel - DMA sampling disabled"));
+        return false;
+    }
+
+    adc_continuous_handle_cfg_t handleConfig = {};
+    #if ADC_ISR_RING
+    // Samples leave through the interrupt; the driver pool is never read
+    handleConfig.max_store_buf_size = 2 * ADC_DMA_FRAME_SAMPLES * SOC_ADC_DIGI_RESULT_BYTES;
+    #else
+    handleConfig.max_store_buf_size = ADC_DMA_POOL_SAMPLES * SOC_ADC_DIGI_RESULT_BYTES;
+    #endif
+    handleConfig.conv_frame_size = ADC_DMA_FRAME_SAMPLES * SOC_ADC_DIGI_RESULT_BYTES;
+    handleConfig.flags.flush_pool = 1;  // Drop the oldest samples instead of the newest
+
+    adc_continuous_handle_t adcHandle = nullptr;
+    if (adc_continuous_new_handle(&handleConfig, &adcHandle) != ESP_OK) {
+        Serial.println(F("ERROR: Failed to create ADC DMA handle!"));
+        return false;
+    }
+
+    adc_digi_pattern_config_t pattern = {};
+    pattern.atten = ADC_ATTEN_DB_12;  // Same range as analogSetAttenuation(ADC_11db)
+    pattern.channel = micChannel;
+    pattern.unit = micUnit;
+    pattern.bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+
+    adc_continuous_config_t adcConfig = {};
+    adcConfig.pattern_num = 1;
+    adcConfig.adc_pattern = &pattern;
+    adcConfig.sample_freq_hz = ADC_DMA_SAMPLE_RATE;
+    adcConfig.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+    adcConfig.format = ADC_DIGI_OUTPUT_FORMAT_TYPE2;
+
+    adc_continuous_evt_cbs_t callbacks = {};
+    #if ADC_ISR_RING
+    callbacks.on_conv_done = onConversionDone;  // Unread pool overflows are expected here
+    #else
+    callbacks.on_pool_ovf = onPoolOverflow;
+    #endif
+
+    if (adc_continuous_config(adcHandle, &adcConfig) != ESP_OK ||
+        adc_continuous_register_event_callbacks(adcHandle, &callbacks, nullptr) != ESP_OK ||
+        adc_continuous_start(adcHandle) != ESP_OK) {
+        Serial.println(F("ERROR: Failed to start ADC DMA sampling!"));
+        adc_continuous_deinit(adcHandle);
+        return false;
+    }
+
+    memset(history, 0, sizeof(history));
+    handle = adcHandle;
+    running = true;
+
+    Serial.print(F("ADC DMA sampling: "));
+    Serial.print(ADC_DMA_SAMPLE_RATE);
+    Serial.println(F(" Hz"));
+    return true;
+    #else
+    return false;
+    #endif
+}
+
+void AdcStream::service() {
+    // A custom ADC source (golden frames) replaces the microphone and any replay
+    bool overridden = isAdcSourceOverridden();
+
+    #if USE_ADC_DMA
+    if (running) {
+        drainDma(overridden || source != nullptr);
+    }
+    #endif
+    if (source != nullptr) {
+        if (overridden) {
+            sourceLastMs = renderMillis();  // Hold the replay position
+        } else {
+            feedSource();
+        }
+    }
+}
+
+void AdcStream::setSource(AudioSource* newSource) {
+    source = newSource;
+    sourceLastMs = renderMillis();
+    dcValid = false;  // Re-seed the DC estimate from the new input
+}
+
+void AdcStream::feedSource() {
+    uint32_t now = renderMillis();
+    uint32_t owed = (now - sourceLastMs) * (ADC_DMA_SAMPLE_RATE / 1000);
+    sourceLastMs = now;
+
+    // Long gaps (console commands, clock switches) would otherwise burst
+    if (owed > ADC_DMA_POOL_SAMPLES) owed = ADC_DMA_POOL_SAMPLES;
+    for (uint32_t i = 0; i < owed; i++) {
+        processSample(source->nextSample());
+    }
+}
+
+#if USE_ADC_DMA
+void AdcStream::drainDma(bool discard) {
+    #if ADC_ISR_RING
+    uint32_t tail = ringTail.load(std::memory_order_relaxed);
+    uint32_t head = ringHead.load(std::memory_order_acquire);
+    uint32_t pending = head - tail;
+    if (pending > ringHighWater) ringHighWater = pending;
+
+    if (!discard) {
+        for (; tail != head; tail++) {
+            processSample(sampleRing[tail & (ADC_RING_SAMPLES - 1)]);
+        }
+    }
+    ringTail.store(head, std::memory_order_release);
+    foreignSamples = ringForeignSamples;
+    #else
+    uint8_t buffer[ADC_DMA_FRAME_SAMPLES * SOC_ADC_DIGI_RESULT_BYTES];
+    uint32_t length = 0;
+
+    // Drain everything that is ready without blocking
+    for (;;) {
+        esp_err_t result = adc_continuous_read((adc_continuous_handle_t)handle, buffer, sizeof(buffer), &length, 0);
+        if (result == ESP_ERR_TIMEOUT) break;
+        if (result != ESP_OK) {
+            readErrors++;
+            break;
+        }
+        if (discard) continue;
+
+        for (uint32_t i = 0; i + SOC_ADC_DIGI_RESULT_BYTES <= length; i += SOC_ADC_DIGI_RESULT_BYTES) {
+            const adc_digi_output_data_t* data = (const adc_digi_output_data_t*)&buffer[i];
+            if (data->type2.channel != micChannel || data->type2.unit != micUnit) {
+                foreignSamples++;
+                continue;
+            }
+            processSample(data->type2.data);
+        }
+    }
+    #endif
+}
+#endif
+
+void AdcStream::processSample(int raw) {
+    samplesRead++;
+    lastSample = raw;
+
+    // Running DC high-pass: dc += (x - dc) / 2^ADC_DC_SHIFT
+    if (!dcValid) {
+        dcQ16 = raw << 16;
+        dcValid = true;
+    }
+    dcQ16 += ((raw << 16) - dcQ16) >> ADC_DC_SHIFT;
+    int ac = raw - (dcQ16 >> 16);
+
+    #if ENABLE_FILTER_BANK
+    filterBank.processSample(ac);
+    #endif
+
+    history[historyIndex] = ac;
+    historyIndex = (historyIndex + 1) % ADC_HISTORY_SAMPLES;
+
+    uint16_t level = abs(ac);
+    blockSumSquares += (uint32_t)level * level;
+    if (level > blockPeakAcc) blockPeakAcc = level;
+
+    if (++blockCount >= ADC_BLOCK_SAMPLES) {
+        blockRms = (uint16_t)sqrtf((float)(blockSumSquares / blockCount));
+        blockPeak = blockPeakAcc;
+        adcDCOffset = dcQ16 >> 16;  // Keeps the single-sample consumers centered
+        blockSumSquares = 0;
+        blockPeakAcc = 0;
+        blockCount = 0;
+        blocksDone++;
+
+        beatDetector.processBlock(blockRms);
+    }
+}
+
+void AdcStream::copyHistory(int16_t* out, uint16_t count) const {
+    uint16_t index = (historyIndex + ADC_HISTORY_SAMPLES - count) % ADC_HISTORY_SAMPLES;
+    for (uint16_t i = 0; i < count; i++) {
+        out[i] = history[index];
+        index = (index + 1) % ADC_HISTORY_SAMPLES;
+    }
+}
+
+void AdcStream::printStatus() {
+    Serial.println(F("=== ADC Sampling ==="));
+    if (source != nullptr) {
+        Serial.print(F("Input: replay ("));
+        Serial.print(source->getName());
+        Serial.println(F(") - microphone samples discarded"));
+    }
+    if (!running) {
+        Serial.println(USE_ADC_DMA ? F("Mode: analogRead (DMA off)") : F("Mode: analogRead (no DMA driver in this core)"));
+        Serial.println(F("===================="));
+        return;
+    }
+    Serial.print(F("Mode: DMA @ "));
+    Serial.print(ADC_DMA_SAMPLE_RATE);
+    Serial.println(ADC_ISR_RING ? F(" Hz (ISR ring)") : F(" Hz"));
+    Serial.print(F("Samples: "));
+    Serial.print(samplesRead);
+    Serial.print(F(" ("));
+    Serial.print(blocksDone);
+    Serial.println(F(" blocks)"));
+    Serial.print(F("DC Offset: "));
+    Serial.println(dcQ16 >> 16);
+    Serial.print(F("Block RMS/Peak: "));
+    Serial.print(blockRms);
+    Serial.print(F("/"));
+    Serial.println(blockPeak);
+    #if ADC_ISR_RING
+    Serial.print(F("Ring Overruns: "));
+    Serial.println(ringOverruns);
+    Serial.print(F("Ring High Water: "));
+    Serial.print(ringHighWater);
+    Serial.print(F("/"));
+    Serial.println(ADC_RING_SAMPLES);
+    #else
+    Serial.print(F("Pool Overruns: "));
+    Serial.println(poolOverruns);
+    #endif
+    Serial.print(F("Read Errors: "));
+    Serial.println(readErrors);
+    if (foreignSamples > 0) {
+        Serial.print(F("Foreign Samples: "));
+        Serial.println(foreignSamples);
+    }
+    Serial.println(F("===================="));
+}
@@ -0,0 +1,75 @@
+// adc_stream.h - v5.2 Continuous DMA ADC Sampling
+#ifndef ADC_STREAM_H
+#define ADC_STREAM_H
+
+#include "config.h"
+
+#define ADC_HISTORY_SAMPLES SPECTRUM_FFT_SIZE
+
+class AudioSource;
+
+// Samples MIC_PIN continuously at ADC_DMA_SAMPLE_RATE into the driver's DMA
+// pool. service() drains the pool, removes the DC offset with a running
+// high-pass and reduces every ADC_BLOCK_SAMPLES samples to RMS and peak,
+// which also feeds the beat detector.
+// Called from the audio task on the S3 and once per frame on the C3, where
+// the DMA interrupt has already moved the samples into a ring (ADC_ISR_RING).
+// An attached AudioSource (replay) replaces the microphone samples; it works
+// without DMA as well.
+class AdcStream {
+public:
+    bool begin();
+    void service();
+
+    // Samples are flowing (DMA or an attached replay source)
+    bool isRunning() const { return running || source != nullptr; }
+
+    // nullptr returns to the microphone. Samples are pulled at
+    // ADC_DMA_SAMPLE_RATE of render time, so the virtual clock speeds them up.
+    void setSource(AudioSource* newSource);
+    AudioSource* getSource() const { return source; }
+
+    // Latest completed block (DC removed, 12-bit scale)
+    uint16_t getRms() const { return blockRms; }
+    uint16_t getPeak() const { return blockPeak; }
+    int getLastSample() const { return lastSample; }  // Raw, for readAdcSample()
+
+    // Copy the newest count DC-free samples, oldest first (count <= ADC_HISTORY_SAMPLES)
+    void copyHistory(int16_t* out, uint16_t count) const;
+
+    void printStatus();
+
+private:
+    void drainDma(bool discard);
+    void feedSource();
+    void processSample(int raw);
+
+    bool running = false;
+    void* handle = nullptr;
+
+    AudioSource* volatile source = nullptr;
+    uint32_t sourceLastMs = 0;
+
+    bool dcValid = false;
+    int32_t dcQ16 = 0;  // DC estimate in 1/65536 LSB
+    uint32_t blockSumSquares = 0;
+    uint16_t blockPeakAcc = 0;
+    uint16_t blockCount = 0;
+
+    volatile uint16_t blockRms = 0;
+    volatile uint16_t blockPeak = 0;
+    volatile int lastSample = 2048;
+
+    int16_t history[ADC_HISTORY_SAMPLES];
+    uint16_t historyIndex = 0;
+
+    uint32_t samplesRead = 0;
+    uint32_t blocksDone = 0;
+    uint32_t foreignSamples = 0;  // Results for another channel/unit
+    uint32_t readErrors = 0;
+    uint16_t ringHighWater = 0;  // Most samples pending at one service() call
+};
+
+extern AdcStream adcStream;
+
+#endif
@@ -1,8 +1,26 @@
 #include "audio.h"
+#include "render_clock.h"
+#include "spectrum.h"
+#include "adc_stream.h"
+#include "beat_detector.h"
+#include "auto_gain.h"
+#include "filter_bank.h"
+#include "audio_routing.h"
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
 
 // v5.0.1: ADC DC-offset (calibrated at startup)
 int adcDCOffset = 2048; // Default, will be calibrated
 
+// v5.2: Published audio features (sequence lock: odd while the writer is busy)
+static AudioFeatures publishedAudio;
+static std::atomic<uint32_t> publishSequence(0);
+static SemaphoreHandle_t audioUpdateMutex = NULL;
+static int lastProcessedLevel = 0;
+
+AudioFeatures frameAudio;
+
 // v5.0.1: Calibrate ADC DC-offset by averaging mic readings
 void calibrateADCOffset() {
     Serial.println(F("Calibrating ADC DC-offset..."));
@@ -11,7 +29,7 @@ void calibrateADCOffset() {
     const int samples = 200; // 200 samples over ~200ms
 
     for (int i = 0; i < samples; i++) {
-        sum += analogRead(MIC_PIN);
+        sum += readAdcSample();
         delay(1); // 1ms between samples
     }
 
@@ -22,8 +40,17 @@ void calibrateADCOffset() {
 }
 
 void initializeAudio() {
-    // v5.0.1: Calibrate DC offset first
-    calibrateADCOffset();
+    audioUpdateMutex = xSemaphoreCreateMutex();
+
+    // v5.2: Coefficients must be ready before the first DMA sample arrives
+    filterBank.begin();
+
+    // v5.2: Continuous DMA sampling tracks the DC offset itself; the one-shot
+    // calibration is only needed for the analogRead fallback
+    if (!adcStream.begin()) {
+        // v5.0.1: Calibrate DC offset first
+        calibrateADCOffset();
+    }
 
     // Initialize audio samples
     for (int i = 0; i < 10; i++) {
@@ -32,17 +59,32 @@ void initializeAudio() {
     audioSampleIdx = 0;
     averageAudio = 0;
 
+    // v5.2: FFT tables and band edges
+    spectrumAnalyzer.begin();
+
     // v5.1: Log audio input mode
     Serial.print(F("Audio input mode: "));
     Serial.println(AudioInputModeNames[audioInputMode]);
 }
 
+// v5.1: Apply sensitivity with input-mode-specific mapping range
+// Line-In has a stronger signal, so we use a wider input range
+static int mapAudioLevel(int level) {
+    int mapRange = (audioInputMode == INPUT_LINE_IN) ? LINE_IN_MAP_RANGE : MIC_MAP_RANGE;
+    return map(level, 0, mapRange, 0, audioSensitivity * 100);
+}
+
 int readAudioLevel() {
-    if (millis() - lastAudioRead > 10) {
-        int reading = analogRead(MIC_PIN);
-        // v5.0.1: Use calibrated DC-offset instead of hardcoded 2048
-        audioLevel = abs(reading - adcDCOffset);
-        lastAudioRead = millis();
+    if (renderMillis() - lastAudioRead > 10) {
+        if (adcStream.isRunning() && !isAdcSourceOverridden()) {
+            // v5.2: RMS of the last DMA block instead of one point of the waveform
+            audioLevel = adcStream.getRms();
+        } else {
+            int reading = readAdcSample();
+            // v5.0.1: Use calibrated DC-offset instead of hardcoded 2048
+            audioLevel = abs(reading - adcDCOffset);
+        }
+        lastAudioRead = renderMillis();
         
         // Update auto gain if enabled
         if (audioAutoGain) {
@@ -66,43 +108,150 @@ int processAudioLevel() {
     }
     averageAudio = total / 10;
     
-    // v5.1: Apply sensitivity with input-mode-specific mapping range
-    // Line-In has a stronger signal, so we use a wider input range
-    int mapRange = (audioInputMode == INPUT_LINE_IN) ? LINE_IN_MAP_RANGE : MIC_MAP_RANGE;
-    audio = map(audio, 0, mapRange, 0, audioSensitivity * 100);
+    audio = mapAudioLevel(audio);
     audio = constrain(audio, 0, audioThreshold * 2);
     
     return audio;
 }
 
 void updateAutoGain() {
-    // Track min/max levels
-    if (audioLevel < audioMinLevel) audioMinLevel = audioLevel;
-    if (audioLevel > audioMaxLevel) audioMaxLevel = audioLevel;
-
-    // Adjust threshold based on dynamic range
-    static unsigned long lastGainUpdate = 0;
-    if (millis() - lastGainUpdate > 1000) { // Update every second
-        lastGainUpdate = millis();
-
-        int range = audioMaxLevel - audioMinLevel;
-        if (range > 50) { // Minimum range to avoid noise
-            audioThreshold = audioMinLevel + (range / 2);
+    // v5.2: Percentile AGC on the mapped (unclamped) level, which is what
+    // audioThreshold is compared against
+    autoGain.update(mapAudioLevel(audioLevel));
+}
 
-            // Slowly decay min/max for adaptation
-            audioMinLevel += 10;
-            audioMaxLevel -= 10;
+static void publishAudioFeatures() {
+    AudioFeatures features;
+    features.level = lastProcessedLevel;
+    features.rawLevel = audioLevel;
+    features.average = averageAudio;
+    features.peak = adcStream.getPeak();
+    features.threshold = audioThreshold;
+    for (uint8_t b = 0; b < SPECTRUM_BANDS; b++) {
+        features.bands[b] = spectrumAnalyzer.getBand(b);
+        features.bandPeaks[b] = spectrumAnalyzer.getPeak(b);
+    }
 
-            // Constrain threshold
-            audioThreshold = constrain(audioThreshold, 50, 500);
+    // v5.2: Filter-bank envelopes on the same 0-255 = 0 .. threshold scale as level8
+    for (uint8_t b = 0; b < FILTER_BANK_BANDS; b++) {
+        int32_t level = 0;
+        if (audioMode != AUDIO_OFF && audioThreshold > 0) {
+            level = (int32_t)mapAudioLevel(filterBank.getEnvelope(b)) * 255 / audioThreshold;
         }
+        features.filterBands[b] = min<int32_t>(level, 255);
     }
+    features.bass8 = features.filterBands[0];
+    features.treble8 = features.filterBands[FILTER_BANK_BANDS - 1];
+    features.mid8 = 0;
+    for (uint8_t b = 1; b < FILTER_BANK_BANDS - 1; b++) {
+        features.mid8 = max(features.mid8, features.filterBands[b]);
+    }
+
+    features.beatLocked = beatDetector.isLocked();
+    features.bpm10 = beatDetector.getBpm10();
+    features.beatCount = beatDetector.getBeatCount();
+
+    uint32_t sequence = publishSequence.load(std::memory_order_relaxed);
+    features.sequence = (sequence + 2) / 2;
+
+    publishSequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    publishedAudio = features;
+    publishSequence.store(sequence + 2, std::memory_order_release);
 }
 
 // v5.0: Main audio update function for FreeRTOS task
 void updateAudio() {
+    // v5.2: Drain the DMA pool even with audio off (keeps the DC estimate current)
+    adcStream.service();
+
     // Process audio level if audio mode is enabled
     if (audioMode != AUDIO_OFF) {
-        processAudioLevel();
+        lastProcessedLevel = processAudioLevel();
+        spectrumAnalyzer.update();
+    } else {
+        lastProcessedLevel = 0;
+    }
+
+    publishAudioFeatures();
+}
+
+// v5.2: Per-frame envelope state (render side only)
+static uint16_t fastEnvelopeQ8 = 0;
+static uint16_t slowEnvelopeQ8 = 0;
+static uint8_t peakHold = 0;
+static bool gateOpen = false;
+static uint32_t lastEnvelopeMs = 0;
+
+void resetAudioEnvelopes() {
+    fastEnvelopeQ8 = 0;
+    slowEnvelopeQ8 = 0;
+    peakHold = 0;
+    gateOpen = false;
+    lastEnvelopeMs = renderMillis();
+    audioRouter.reset();
+}
+
+// One-pole follower: move 'elapsed / tau' of the way toward the input (Q8)
+static uint16_t followEnvelope(uint16_t envelopeQ8, uint8_t input, uint32_t elapsedMs, uint16_t tauMs) {
+    int32_t target = (int32_t)input << 8;
+    int32_t step = min<uint32_t>((elapsedMs << 8) / tauMs, 256);
+    return envelopeQ8 + (((target - envelopeQ8) * step) >> 8);
+}
+
+static void updateAudioEnvelopes() {
+    uint32_t now = renderMillis();
+    uint32_t elapsed = now - lastEnvelopeMs;
+    lastEnvelopeMs = now;
+
+    uint8_t input = 0;
+    if (audioMode != AUDIO_OFF && frameAudio.threshold > 0) {
+        input = min<uint32_t>((uint32_t)frameAudio.level * 255 / frameAudio.threshold, 255);
+    }
+
+    uint16_t tau = (input > (fastEnvelopeQ8 >> 8)) ? AUDIO_ATTACK_MS : AUDIO_RELEASE_MS;
+    fastEnvelopeQ8 = followEnvelope(fastEnvelopeQ8, input, elapsed, tau);
+    slowEnvelopeQ8 = followEnvelope(slowEnvelopeQ8, input, elapsed, AUDIO_SLOW_MS);
+
+    uint8_t fast = fastEnvelopeQ8 >> 8;
+    uint8_t decay = min<uint32_t>(elapsed * AUDIO_PEAK_DECAY / 1000, 255);
+    peakHold = max(fast, qsub8(peakHold, decay));
+
+    if (fast >= AUDIO_GATE_OPEN) gateOpen = true;
+    else if (fast < AUDIO_GATE_CLOSE) gateOpen = false;
+
+    frameAudio.level8 = fast;
+    frameAudio.slow8 = slowEnvelopeQ8 >> 8;
+    frameAudio.peak8 = peakHold;
+    frameAudio.gate = gateOpen;
+}
+
+void takeAudioSnapshot() {
+    // Retry while the writer is mid-update; after a few tries keep the previous frame's copy
+    for (uint8_t attempt = 0; attempt < 8; attempt++) {
+        uint32_t before = publishSequence.load(std::memory_order_acquire);
+        if (before & 1) continue;
+
+        AudioFeatures copy = publishedAudio;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (publishSequence.load(std::memory_order_relaxed) == before) {
+            frameAudio = copy;
+            break;
+        }
+    }
+
+    updateAudioEnvelopes();
+    audioRouter.evaluate();
+}
+
+void lockAudioUpdates() {
+    if (audioUpdateMutex != NULL) {
+        xSemaphoreTake(audioUpdateMutex, portMAX_DELAY);
+    }
+}
+
+void unlockAudioUpdates() {
+    if (audioUpdateMutex != NULL) {
+        xSemaphoreGive(audioUpdateMutex);
     }
 }
\ No newline at end of file
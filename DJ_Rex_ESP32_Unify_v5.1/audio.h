@@ -10,8 +10,55 @@ int processAudioLevel();
 void updateAutoGain();
 
 // v5.0: FreeRTOS audio task function
+// v5.2: The only writer of the audio state - runs in the audio task (S3) or at
+// the start of each frame (C3) and publishes an AudioFeatures snapshot
 void updateAudio();
 
+// v5.2: Audio features of one update, published through a sequence lock so
+// the renderer always sees a consistent set without blocking the audio task
+struct AudioFeatures {
+    uint32_t sequence;     // Publish counter
+    int level;             // Sensitivity-mapped level (0 .. 2x threshold)
+    int rawLevel;          // DC-free input level
+    int average;           // Average of the last 10 raw levels
+    uint16_t peak;         // Peak of the last ADC block (0 without DMA sampling)
+    uint16_t threshold;
+    uint8_t bands[SPECTRUM_BANDS];
+    uint8_t bandPeaks[SPECTRUM_BANDS];
+    uint8_t filterBands[FILTER_BANK_BANDS];  // Biquad envelopes, 0-255 = 0 .. threshold
+    uint8_t bass8;         // Lowest filter band
+    uint8_t mid8;          // Loudest of the middle bands
+    uint8_t treble8;       // Highest filter band
+    bool beatLocked;
+    uint16_t bpm10;        // BPM x 10
+    uint32_t beatCount;
+
+    // Per-frame stage (render side, filled by takeAudioSnapshot). 0-255 is
+    // 0 .. audioThreshold; audioMode AUDIO_OFF reads as silence.
+    uint8_t level8;        // Fast envelope (attack AUDIO_ATTACK_MS, release AUDIO_RELEASE_MS)
+    uint8_t slow8;         // Slow envelope (AUDIO_SLOW_MS)
+    uint8_t peak8;         // Peak hold, falls AUDIO_PEAK_DECAY per second
+    bool gate;             // Fast envelope above the noise gate (with hysteresis)
+};
+
+// Render side: copy of the latest features plus the per-frame envelopes,
+// taken once per frame (patterns read the routed per-zone values from audioRouter)
+extern AudioFeatures frameAudio;
+void takeAudioSnapshot();
+void resetAudioEnvelopes();
+
+// Serializes updateAudio() between the audio task and golden-frame runs
+void lockAudioUpdates();
+void unlockAudioUpdates();
+
+// v5.2: Integer log2 in 1/8 octave steps (0 for values below 2)
+inline uint8_t log2Eighths(uint32_t value) {
+    if (value < 2) return 0;
+    uint8_t msb = 31 - __builtin_clz(value);
+    uint8_t fraction = (msb >= 3) ? (value >> (msb - 3)) & 0x07 : (value << (3 - msb)) & 0x07;
+    return msb * 8 + fraction;
+}
+
 // v5.0.1: ADC DC-offset calibration
 void calibrateADCOffset();
 extern int adcDCOffset;
@@ -0,0 +1,366 @@
+// audio_replay.cpp - v5.2 Replayable Audio Sources
+#include "audio_replay.h"
+#include "globals.h"
+#include "audio.h"
+#include "adc_stream.h"
+#include "render_clock.h"
+#include "spectrum.h"
+#include "beat_detector.h"
+#include "filter_bank.h"
+#include "helpers.h"
+#include "patterns_mouth.h"
+#include "pattern_registry.h"
+#include "transition.h"
+#include "pattern_arena.h"
+
+AudioReplay audioReplay;
+
+// Own generator for the emulated ADC noise - leaves the pattern RNG untouched
+static uint16_t noiseSeed = 1;
+
+int emulateAdcSample(int32_t pcmQ15) {
+    int32_t fullScale = (audioInputMode == INPUT_LINE_IN) ? REPLAY_LINE_IN_FULL_SCALE : REPLAY_MIC_FULL_SCALE;
+    noiseSeed = noiseSeed * 2053 + 13849;
+    int32_t sample = REPLAY_DC_OFFSET + ((pcmQ15 * fullScale) >> 15) + (noiseSeed >> 14) - 1;  // +-2 LSB noise
+    return constrain(sample, 0, 4095);
+}
+
+static uint16_t readLe16(const uint8_t* p) {
+    return p[0] | (p[1] << 8);
+}
+
+static uint32_t readLe32(const uint8_t* p) {
+    return readLe16(p) | ((uint32_t)readLe16(p + 2) << 16);
+}
+
+// =============================================================================
+// WAV SOURCE
+// =============================================================================
+
+bool WavSource::open(const uint8_t* data, uint32_t length) {
+    close();
+    if (length < 12 || memcmp(data, "RIFF", 4) != 0 || memcmp(data + 8, "WAVE", 4) != 0) {
+        return false;
+    }
+
+    uint16_t format = 0, channelCount = 0, bits = 0;
+    uint32_t rate = 0, dataSize = 0;
+    const uint8_t* samples = nullptr;
+
+    uint32_t offset = 12;
+    while (offset + 8 <= length) {
+        const uint8_t* chunk = data + offset;
+        uint32_t size = readLe32(chunk + 4);
+        uint32_t available = length - offset - 8;
+
+        if (memcmp(chunk, "fmt ", 4) == 0 && size >= 16 && available >= 16) {
+            format = readLe16(chunk + 8);
+            channelCount = readLe16(chunk + 10);
+            rate = readLe32(chunk + 12);
+            bits = readLe16(chunk + 22);
+        } else if (memcmp(chunk, "data", 4) == 0) {
+            samples = chunk + 8;
+            dataSize = min(size, available);  // A truncated file plays what is there
+        }
+        if (size >= available) break;
+        offset += 8 + size + (size & 1);  // Chunks are word aligned
+    }
+
+    if (format != 1 || (bits != 8 && bits != 16) || channelCount < 1 || channelCount > 2 ||
+        rate == 0 || samples == nullptr) {
+        return false;
+    }
+
+    channels = channelCount;
+    bytesPerSample = bits / 8;
+    frames = dataSize / (channels * bytesPerSample);
+    if (frames == 0) return false;
+
+    sampleRate = rate;
+    stepQ16 = ((uint64_t)rate << 16) / ADC_DMA_SAMPLE_RATE;
+    positionQ16 = 0;
+    pcm = samples;
+    return true;
+}
+
+void WavSource::close() {
+    pcm = nullptr;
+    frames = 0;
+    sampleRate = 0;
+    channels = 0;
+    bytesPerSample = 0;
+}
+
+int WavSource::nextSample() {
+    if (pcm == nullptr) return REPLAY_DC_OFFSET;
+
+    uint32_t frame = positionQ16 >> 16;
+    if (frame >= frames) {
+        positionQ16 %= (uint64_t)frames << 16;  // Loop, even when one step spans the file
+        frame = positionQ16 >> 16;
+    }
+    positionQ16 += stepQ16;
+
+    // Mix to mono in Q15
+    const uint8_t* p = pcm + frame * channels * bytesPerSample;
+    int32_t sum = 0;
+    for (uint8_t c = 0; c < channels; c++) {
+        if (bytesPerSample == 1) {
+            sum += ((int32_t)p[c] - 128) * 256;
+        } else {
+            sum += (int16_t)readLe16(p + c * 2);
+        }
+    }
+    return emulateAdcSample(sum / channels);
+}
+
+// =============================================================================
+// CLICK TRACK SOURCE
+// =============================================================================
+
+int ClickTrackSource::nextSample() {
+    const uint32_t beatSamples = (uint32_t)ADC_DMA_SAMPLE_RATE * 60 / bpm;
+    const uint32_t clickSamples = (uint32_t)ADC_DMA_SAMPLE_RATE * REPLAY_CLICK_MS / 1000;
+
+    uint32_t beat = sampleCount / beatSamples;
+    uint32_t t = sampleCount % beatSamples;
+    sampleCount++;
+
+    int32_t pcm = 0;
+    if (t < clickSamples) {
+        // 80 Hz kick with a linear decay, accented on the downbeat
+        int32_t amplitude = (beat % BEATS_PER_BAR == 0) ? 32767 : 20000;
+        amplitude = amplitude * (int32_t)(clickSamples - t) / (int32_t)clickSamples;
+        uint16_t phase = t * (65536UL * 80 / ADC_DMA_SAMPLE_RATE);
+        pcm = ((int32_t)sin16(phase) * amplitude) >> 15;
+    }
+    return emulateAdcSample(pcm);
+}
+
+// =============================================================================
+// REPLAY CONTROL
+// =============================================================================
+
+bool AudioReplay::loadWav(uint32_t size) {
+    stop();
+    if (size < 44 || size > REPLAY_MAX_WAV_BYTES) {
+        Serial.print(F("Invalid size! Use 44-"));
+        Serial.print(REPLAY_MAX_WAV_BYTES);
+        Serial.println(F(" bytes"));
+        return false;
+    }
+
+    wavBuffer = (uint8_t*)malloc(size);
+    if (wavBuffer == nullptr) {
+        Serial.println(F("ERROR: Not enough memory for the WAV file!"));
+        return false;
+    }
+    wavBufferSize = size;
+
+    Serial.print(F("Send "));
+    Serial.print(size);
+    Serial.println(F(" bytes of WAV data now..."));
+
+    // Wall-clock timeout - the render clock may be virtual
+    uint32_t received = 0;
+    uint32_t lastByteMs = millis();
+    while (received < size && millis() - lastByteMs < REPLAY_UPLOAD_TIMEOUT_MS) {
+        int available = Serial.available();
+        if (available > 0 && received == 0) {
+            // Skip what is left of the command's line ending ("RIFF" comes first)
+            int c = Serial.read();
+            if (c != '\r' && c != '\n') wavBuffer[received++] = c;
+            lastByteMs = millis();
+        } else if (available > 0) {
+            received += Serial.readBytes(wavBuffer + received, min<uint32_t>(available, size - received));
+            lastByteMs = millis();
+        } else {
+            delay(1);
+        }
+    }
+
+    if (received < size) {
+        Serial.print(F("ERROR: Upload timed out after "));
+        Serial.print(received);
+        Serial.println(F(" bytes"));
+        stop();
+        return false;
+    }
+    if (!wav.open(wavBuffer, size)) {
+        Serial.println(F("ERROR: Not a PCM WAV file (8/16-bit, mono/stereo)"));
+        stop();
+        return false;
+    }
+
+    Serial.print(F("WAV loaded: "));
+    Serial.print(wav.getSampleRate());
+    Serial.print(F(" Hz, "));
+    Serial.print(wav.getDurationMs());
+    Serial.println(F(" ms"));
+    return true;
+}
+
+bool AudioReplay::playWav() {
+    if (!wav.isOpen()) {
+        Serial.println(F("No WAV loaded - use 'replay load <bytes>' first"));
+        return false;
+    }
+    wav.rewind();
+    lockAudioUpdates();
+    adcStream.setSource(&wav);
+    unlockAudioUpdates();
+    Serial.println(F("Replaying WAV in place of the microphone (loops)"));
+    return true;
+}
+
+void AudioReplay::playClicks(uint8_t bpm) {
+    clicks.setTempo(bpm);
+    clicks.rewind();
+    lockAudioUpdates();
+    adcStream.setSource(&clicks);
+    unlockAudioUpdates();
+    Serial.print(F("Replaying click track at "));
+    Serial.print(bpm);
+    Serial.println(F(" BPM in place of the microphone"));
+}
+
+void AudioReplay::stop() {
+    // The audio task may be pulling samples - detach before freeing the buffer
+    lockAudioUpdates();
+    adcStream.setSource(nullptr);
+    unlockAudioUpdates();
+
+    wav.close();
+    free(wavBuffer);
+    wavBuffer = nullptr;
+    wavBufferSize = 0;
+}
+
+void AudioReplay::runBenchmark(uint16_t seconds) {
+    AudioSource* source = adcStream.getSource();
+    if (source == nullptr) {
+        Serial.println(F("No replay source - use 'replay wav' or 'replay clicks <bpm>' first"));
+        return;
+    }
+
+    Serial.println(F("=== Replay Benchmark ==="));
+    Serial.print(F("Source: "));
+    Serial.print(source->getName());
+    Serial.print(F(", body pattern "));
+    Serial.print(currentPattern);
+    Serial.print(F(", mouth pattern "));
+    Serial.println(mouthPattern);
+
+    // Same audio -> pattern path as renderFrame(), on the virtual clock
+    transitionEngine.finish();
+    lockAudioUpdates();
+    setRenderClockVirtual(renderMillis());
+    source->rewind();
+    adcStream.setSource(source);
+    spectrumAnalyzer.reset();
+    beatDetector.reset();
+    filterBank.reset();
+    resetAudioEnvelopes();
+
+    const uint32_t frames = (uint32_t)seconds * FRAMES_PER_SECOND;
+    uint32_t totalUs = 0, maxUs = 0;
+    uint32_t levelSum = 0, gateFrames = 0;
+
+    for (uint32_t f = 0; f < frames; f++) {
+        advanceRenderClock(FRAME_DELAY_MS);
+        beginFrame(timeScale);
+
+        uint32_t start = micros();
+        updateAudio();
+        takeAudioSnapshot();
+        bodyArena.render(currentPattern);
+        updateMouth();
+        uint32_t elapsed = micros() - start;
+
+        totalUs += elapsed;
+        if (elapsed > maxUs) maxUs = elapsed;
+        levelSum += frameAudio.level8;
+        if (frameAudio.gate) gateFrames++;
+
+        // Let the idle task run once per audio second (task watchdog)
+        if (f % FRAMES_PER_SECOND == FRAMES_PER_SECOND - 1) delay(1);
+    }
+
+    Serial.print(F("Audio: "));
+    Serial.print(seconds);
+    Serial.print(F(" s in "));
+    Serial.print(totalUs / 1000);
+    Serial.print(F(" ms ("));
+    Serial.print((uint32_t)seconds * 1000000UL / max<uint32_t>(totalUs, 1));
+    Serial.println(F("x real time)"));
+    Serial.print(F("Frame: avg "));
+    Serial.print(totalUs / frames);
+    Serial.print(F(" us, max "));
+    Serial.print(maxUs);
+    Serial.println(F(" us"));
+    Serial.print(F("Level: avg "));
+    Serial.print(levelSum / frames);
+    Serial.print(F("/255, gate open "));
+    Serial.print(gateFrames * 100 / frames);
+    Serial.println(F("%"));
+    Serial.print(F("Beats: "));
+    Serial.print(beatDetector.getBeatCount());
+    Serial.print(F(", tempo "));
+    Serial.print(beatDetector.getBpm10() / 10);
+    Serial.print(F("."));
+    Serial.print(beatDetector.getBpm10() % 10);
+    Serial.println(beatDetector.isLocked() ? F(" BPM (locked)") : F(" BPM (not locked)"));
+    Serial.print(F("Threshold: "));
+    Serial.println(audioThreshold);
+    Serial.println(F("========================"));
+
+    // Back to live playback from the start of the source
+    setRenderClockLive();
+    resetFrameClock();
+    source->rewind();
+    adcStream.setSource(source);
+    beatDetector.reset();
+    resetAudioEnvelopes();
+    initializeHelpers();
+    resetPatternArenas();  // Patterns restart their timers on the live clock
+    unlockAudioUpdates();
+}
+
+void AudioReplay::printStatus() {
+    Serial.println(F("=== Audio Replay ==="));
+    AudioSource* source = adcStream.getSource();
+    Serial.print(F("Input: "));
+    if (source == nullptr) {
+        Serial.println(F("Microphone pin"));
+    } else {
+        Serial.print(source->getName());
+        if (source == &clicks) {
+            Serial.print(F(" @ "));
+            Serial.print(clicks.getTempo());
+            Serial.print(F(" BPM"));
+        }
+        Serial.println();
+    }
+    Serial.print(F("WAV: "));
+    if (wav.isOpen()) {
+        Serial.print(wav.getSampleRate());
+        Serial.print(F(" Hz, "));
+        Serial.print(wav.getBits());
+        Serial.print(F("-bit, "));
+        Serial.print(wav.getChannels());
+        Serial.print(F(" ch, "));
+        Serial.print(wav.getDurationMs());
+        Serial.print(F(" ms ("));
+        Serial.print(wavBufferSize);
+        Serial.println(F(" bytes)"));
+    } else {
+        Serial.println(F("none loaded"));
+    }
+    Serial.print(F("Emulated ADC: "));
+    Serial.print(AudioInputModeNames[audioInputMode]);
+    Serial.print(F(", +-"));
+    Serial.print(audioInputMode == INPUT_LINE_IN ? REPLAY_LINE_IN_FULL_SCALE : REPLAY_MIC_FULL_SCALE);
+    Serial.print(F(" around "));
+    Serial.println(REPLAY_DC_OFFSET);
+    Serial.println(F("===================="));
+}
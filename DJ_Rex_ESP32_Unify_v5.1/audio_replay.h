@@ -0,0 +1,85 @@
+// audio_replay.h - v5.2 Replayable Audio Sources
+#ifndef AUDIO_REPLAY_H
+#define AUDIO_REPLAY_H
+
+#include "config.h"
+
+// Produces raw 12-bit ADC samples at ADC_DMA_SAMPLE_RATE. Attached to the ADC
+// stream it replaces the microphone for the whole audio path (block RMS,
+// beat detector, spectrum history, auto gain), paced by the render clock.
+class AudioSource {
+public:
+    virtual ~AudioSource() {}
+    virtual const char* getName() const = 0;
+    virtual void rewind() = 0;
+    virtual int nextSample() = 0;
+};
+
+// PCM WAV image in memory (8-bit unsigned or 16-bit signed, mono or stereo,
+// any sample rate). Loops at the end; resampled by nearest sample.
+class WavSource : public AudioSource {
+public:
+    bool open(const uint8_t* data, uint32_t length);
+    void close();
+    bool isOpen() const { return pcm != nullptr; }
+    uint32_t getSampleRate() const { return sampleRate; }
+    uint8_t getChannels() const { return channels; }
+    uint8_t getBits() const { return bytesPerSample * 8; }
+    uint32_t getDurationMs() const { return sampleRate ? (uint64_t)frames * 1000 / sampleRate : 0; }
+
+    const char* getName() const override { return "WAV"; }
+    void rewind() override { positionQ16 = 0; }
+    int nextSample() override;
+
+private:
+    const uint8_t* pcm = nullptr;
+    uint32_t frames = 0;
+    uint32_t sampleRate = 0;
+    uint8_t channels = 0;
+    uint8_t bytesPerSample = 0;
+    uint64_t positionQ16 = 0;  // In source frames
+    uint32_t stepQ16 = 0;      // Source frames per ADC sample
+};
+
+// Decaying kick on every beat (accented downbeat) over a quiet noise floor
+class ClickTrackSource : public AudioSource {
+public:
+    void setTempo(uint8_t bpm) { this->bpm = bpm; }
+    uint8_t getTempo() const { return bpm; }
+
+    const char* getName() const override { return "Click track"; }
+    void rewind() override { sampleCount = 0; }
+    int nextSample() override;
+
+private:
+    uint8_t bpm = 120;
+    uint32_t sampleCount = 0;
+};
+
+// Owns the replay sources and the serial-facing replay commands
+class AudioReplay {
+public:
+    // Receives a WAV file of the given size over Serial (binary, right after the command)
+    bool loadWav(uint32_t size);
+    bool playWav();
+    void playClicks(uint8_t bpm);
+    void stop();  // Back to the microphone, frees the WAV buffer
+
+    // Runs the attached source through audio + current patterns on the virtual
+    // clock as fast as possible and reports speed and detection results
+    void runBenchmark(uint16_t seconds);
+    void printStatus();
+
+private:
+    WavSource wav;
+    ClickTrackSource clicks;
+    uint8_t* wavBuffer = nullptr;
+    uint32_t wavBufferSize = 0;
+};
+
+// Emulated analog front end: Q15 PCM around the bias, scaled to the input mode's range
+int emulateAdcSample(int32_t pcmQ15);
+
+extern AudioReplay audioReplay;
+
+#endif
@@ -0,0 +1,187 @@
+// audio_routing.cpp - v5.2 Zone-Level Audio Routing
+#include "audio_routing.h"
+#include "globals.h"
+#include "audio.h"
+#include "render_clock.h"
+
+AudioRouter audioRouter;
+
+#define ROUTE_GAIN_UNITY 16
+
+// Names used by the "route" command and in the table printout
+static const char* const zoneNames[NUM_AUDIO_ZONES] = {
+    "rsides", "msides", "lsides", "rblocks", "mblocks", "lblocks", "eyes", "mouth"
+};
+static const char* const sourceNames[NUM_ROUTE_SOURCES] = {
+    "off", "level", "slow", "peak", "beat", "bass", "mid", "treble", "band"
+};
+static const char* const curveNames[NUM_ROUTE_CURVES] = {
+    "linear", "square", "sqrt", "step"
+};
+
+void AudioRouter::loadPreset(uint8_t mode) {
+    if (mode == AUDIO_CUSTOM) return;
+
+    const AudioRoute off = {ROUTE_OFF, 0, ROUTE_GAIN_UNITY, CURVE_LINEAR};
+    const AudioRoute level = {ROUTE_LEVEL, 0, ROUTE_GAIN_UNITY, CURVE_LINEAR};
+    AudioRoute sides = off, blocks = off, mouth = off;
+
+    switch (mode) {
+        case AUDIO_MOUTH_ONLY:
+            mouth = level;
+            break;
+        case AUDIO_BODY_SIDES:
+            sides = level;
+            break;
+        case AUDIO_BODY_ALL:
+            sides = level;
+            blocks = level;
+            break;
+        case AUDIO_ALL:
+            sides = level;
+            blocks = level;
+            mouth = level;
+            break;
+        case AUDIO_BANDS:
+            sides = {ROUTE_MID, 0, ROUTE_GAIN_UNITY, CURVE_LINEAR};
+            blocks = {ROUTE_BASS, 0, ROUTE_GAIN_UNITY, CURVE_LINEAR};
+            mouth = {ROUTE_TREBLE, 0, ROUTE_GAIN_UNITY, CURVE_LINEAR};
+            break;
+        default:  // AUDIO_OFF
+            break;
+    }
+
+    for (uint8_t panel = 0; panel < 3; panel++) {
+        routes[sideZone(panel)] = sides;
+        routes[blockZone(panel)] = blocks;
+    }
+    routes[AUDIO_ZONE_EYES] = off;
+    routes[AUDIO_ZONE_MOUTH] = mouth;
+}
+
+void AudioRouter::setRoute(uint8_t zone, const AudioRoute& route) {
+    routes[zone] = route;
+}
+
+void AudioRouter::setRoutes(const AudioRoute* table) {
+    for (uint8_t zone = 0; zone < NUM_AUDIO_ZONES; zone++) {
+        AudioRoute route = table[zone];
+        if (route.source >= NUM_ROUTE_SOURCES) route.source = ROUTE_OFF;
+        if (route.band >= SPECTRUM_BANDS) route.band = 0;
+        if (route.curve >= NUM_ROUTE_CURVES) route.curve = CURVE_LINEAR;
+        routes[zone] = route;
+    }
+}
+
+void AudioRouter::reset() {
+    beatPrimed = false;
+    lastBeatMs = 0;
+    memset(levels, 0, sizeof(levels));
+}
+
+uint8_t AudioRouter::sourceValue(const AudioRoute& route, uint8_t beatPulse) const {
+    if (route.source == ROUTE_BEAT) return beatPulse;
+    if (!frameAudio.gate) return 0;  // Everything else stays dark below the noise gate
+
+    switch (route.source) {
+        case ROUTE_LEVEL:    return frameAudio.level8;
+        case ROUTE_SLOW:     return frameAudio.slow8;
+        case ROUTE_PEAK:     return frameAudio.peak8;
+        case ROUTE_BASS:     return frameAudio.bass8;
+        case ROUTE_MID:      return frameAudio.mid8;
+        case ROUTE_TREBLE:   return frameAudio.treble8;
+        case ROUTE_SPECTRUM: return frameAudio.bands[route.band];
+        default:             return 0;
+    }
+}
+
+void AudioRouter::evaluate() {
+    uint32_t now = renderMillis();
+
+    // Beat pulse: 255 on each new beat, falling to 0 over AUDIO_BEAT_PULSE_MS.
+    // The first frame after a reset only takes over the count.
+    if (!beatPrimed) {
+        lastBeatCount = frameAudio.beatCount;
+        lastBeatMs = now - AUDIO_BEAT_PULSE_MS;
+        beatPrimed = true;
+    } else if (frameAudio.beatCount != lastBeatCount) {
+        lastBeatCount = frameAudio.beatCount;
+        lastBeatMs = now;
+    }
+    uint32_t sinceBeat = now - lastBeatMs;
+    uint8_t beatPulse = (sinceBeat < AUDIO_BEAT_PULSE_MS) ? 255 - sinceBeat * 255 / AUDIO_BEAT_PULSE_MS : 0;
+
+    for (uint8_t zone = 0; zone < NUM_AUDIO_ZONES; zone++) {
+        const AudioRoute& route = routes[zone];
+        if (route.source == ROUTE_OFF) {
+            levels[zone] = 0;
+            continue;
+        }
+
+        uint8_t value = min<uint32_t>((uint32_t)sourceValue(route, beatPulse) * route.gain / ROUTE_GAIN_UNITY, 255);
+        switch (route.curve) {
+            case CURVE_SQUARE: value = scale8(value, value); break;
+            case CURVE_SQRT:   value = sqrt16((uint16_t)value * 255); break;
+            case CURVE_STEP:   value = (value >= 128) ? 255 : 0; break;
+            default: break;
+        }
+        levels[zone] = value;
+    }
+}
+
+void AudioRouter::printRoutes() {
+    Serial.println(F("=== Audio Routing ==="));
+    Serial.print(F("Mode: "));
+    Serial.println(AudioModeNames[audioMode]);
+    for (uint8_t zone = 0; zone < NUM_AUDIO_ZONES; zone++) {
+        const AudioRoute& route = routes[zone];
+        Serial.print(F("  "));
+        Serial.print(zoneNames[zone]);
+        for (uint8_t pad = strlen(zoneNames[zone]); pad < 8; pad++) Serial.print(' ');
+        Serial.print(sourceNames[route.source]);
+        if (route.source == ROUTE_SPECTRUM) Serial.print(route.band);
+        if (route.source != ROUTE_OFF) {
+            Serial.print(F(" x"));
+            Serial.print(route.gain / ROUTE_GAIN_UNITY);
+            Serial.print(F("."));
+            uint8_t hundredths = (route.gain % ROUTE_GAIN_UNITY) * 100 / ROUTE_GAIN_UNITY;
+            if (hundredths < 10) Serial.print('0');
+            Serial.print(hundredths);
+            Serial.print(' ');
+            Serial.print(curveNames[route.curve]);
+            Serial.print(F(" -> "));
+            Serial.print(levels[zone]);
+        }
+        Serial.println();
+    }
+    Serial.println(F("====================="));
+}
+
+int AudioRouter::findZone(const char* name) {
+    for (uint8_t zone = 0; zone < NUM_AUDIO_ZONES; zone++) {
+        if (strcmp(name, zoneNames[zone]) == 0) return zone;
+    }
+    return -1;
+}
+
+// "band3" selects FFT band 3; every other source has a plain name
+int AudioRouter::findSource(const char* name, uint8_t* band) {
+    *band = 0;
+    if (strncmp(name, "band", 4) == 0 && name[4] != '\0') {
+        int index = atoi(name + 4);
+        if (index < 0 || index >= SPECTRUM_BANDS) return -1;
+        *band = index;
+        return ROUTE_SPECTRUM;
+    }
+    for (uint8_t source = 0; source < ROUTE_SPECTRUM; source++) {
+        if (strcmp(name, sourceNames[source]) == 0) return source;
+    }
+    return -1;
+}
+
+int AudioRouter::findCurve(const char* name) {
+    for (uint8_t curve = 0; curve < NUM_ROUTE_CURVES; curve++) {
+        if (strcmp(name, curveNames[curve]) == 0) return curve;
+    }
+    return -1;
+}
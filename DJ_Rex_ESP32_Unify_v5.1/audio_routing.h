@@ -0,0 +1,88 @@
+// audio_routing.h - v5.2 Zone-Level Audio Routing
+#ifndef AUDIO_ROUTING_H
+#define AUDIO_ROUTING_H
+
+#include "config.h"
+
+// Zones that react to audio. Panel order matches getLEDArray(): 0 = Right,
+// 1 = Middle, 2 = Left.
+enum AudioZone {
+    AUDIO_ZONE_SIDES = 0,      // + panel (side LEDs)
+    AUDIO_ZONE_BLOCKS = 3,     // + panel (blocks)
+    AUDIO_ZONE_EYES = 6,
+    AUDIO_ZONE_MOUTH = 7,
+    NUM_AUDIO_ZONES = 8
+};
+
+// Feature a zone follows
+enum AudioRouteSource {
+    ROUTE_OFF = 0,
+    ROUTE_LEVEL,       // Fast envelope
+    ROUTE_SLOW,        // Slow envelope
+    ROUTE_PEAK,        // Peak hold
+    ROUTE_BEAT,        // Pulse on every detected beat
+    ROUTE_BASS,        // Filter bank: lowest band
+    ROUTE_MID,         // Filter bank: loudest middle band
+    ROUTE_TREBLE,      // Filter bank: highest band
+    ROUTE_SPECTRUM,    // FFT band 'band'
+    NUM_ROUTE_SOURCES
+};
+
+// Response curve applied after the gain
+enum AudioRouteCurve {
+    CURVE_LINEAR = 0,
+    CURVE_SQUARE,      // Punchier: quiet parts stay dark
+    CURVE_SQRT,        // More sensitive: quiet parts light up
+    CURVE_STEP,        // On above half scale
+    NUM_ROUTE_CURVES
+};
+
+struct AudioRoute {
+    uint8_t source;    // AudioRouteSource
+    uint8_t band;      // ROUTE_SPECTRUM only
+    uint8_t gain;      // x/16 (16 = 1.0)
+    uint8_t curve;     // AudioRouteCurve
+};
+
+inline uint8_t sideZone(uint8_t panel) { return AUDIO_ZONE_SIDES + panel; }
+inline uint8_t blockZone(uint8_t panel) { return AUDIO_ZONE_BLOCKS + panel; }
+
+// Maps every zone to an audio feature. evaluate() runs once per frame in
+// takeAudioSnapshot() and leaves one 0-255 value per zone, so patterns read
+// a number instead of branching on audioMode. The AudioMode values are
+// presets of this table; editing a route switches to AUDIO_CUSTOM.
+class AudioRouter {
+public:
+    void loadPreset(uint8_t mode);  // AUDIO_CUSTOM keeps the current table
+    void setRoute(uint8_t zone, const AudioRoute& route);
+    const AudioRoute& getRoute(uint8_t zone) const { return routes[zone]; }
+
+    // Whole table, for the settings
+    const AudioRoute* getRoutes() const { return routes; }
+    void setRoutes(const AudioRoute* table);
+
+    void evaluate();  // Reads frameAudio
+    void reset();     // Clears the beat pulse
+
+    uint8_t getLevel(uint8_t zone) const { return levels[zone]; }
+    bool isRouted(uint8_t zone) const { return routes[zone].source != ROUTE_OFF; }
+
+    void printRoutes();
+
+    static int findZone(const char* name);
+    static int findSource(const char* name, uint8_t* band);
+    static int findCurve(const char* name);
+
+private:
+    uint8_t sourceValue(const AudioRoute& route, uint8_t beatPulse) const;
+
+    AudioRoute routes[NUM_AUDIO_ZONES] = {};
+    uint8_t levels[NUM_AUDIO_ZONES] = {};
+    uint32_t lastBeatCount = 0;
+    uint32_t lastBeatMs = 0;
+    bool beatPrimed = false;
+};
+
+extern AudioRouter audioRouter;
+
+#endif
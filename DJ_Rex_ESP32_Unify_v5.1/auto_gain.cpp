@@ -0,0 +1,130 @@
+// auto_gain.cpp - v5.2 Percentile-Based Automatic Gain Control
+#include "auto_gain.h"
+#include "globals.h"
+#include "audio.h"
+#include "render_clock.h"
+
+AutoGain autoGain;
+
+// Inverse of log2Eighths(): value at the given 1/8 octave step
+static uint32_t pow2Eighths(uint8_t eighths) {
+    return ((uint32_t)(8 + (eighths & 0x07)) << (eighths >> 3)) >> 3;
+}
+
+static uint8_t levelBin(int level) {
+    return min<uint8_t>(log2Eighths(max(level, 0)) >> 1, AGC_HISTOGRAM_BINS - 1);
+}
+
+void AutoGain::reset() {
+    memset(modes, 0, sizeof(modes));
+    activeMode = 0xFF;
+}
+
+void AutoGain::activate(uint8_t mode) {
+    ModeState& state = modes[mode];
+    if (!state.primed) {
+        // Start from the current (stored or manual) threshold
+        state.thresholdLogQ16 = (uint32_t)log2Eighths(audioThreshold) << 16;
+        state.thresholdMin = audioThreshold;
+        state.thresholdMax = audioThreshold;
+        state.primed = true;
+    }
+    activeMode = mode;
+    audioThreshold = getThreshold(mode);
+}
+
+void AutoGain::decay(ModeState& state) {
+    for (uint8_t b = 0; b < AGC_HISTOGRAM_BINS; b++) {
+        state.histogram[b] -= state.histogram[b] >> 4;
+    }
+}
+
+uint8_t AutoGain::percentileBin(const ModeState& state) const {
+    uint32_t total = 0;
+    for (uint8_t b = 0; b < AGC_HISTOGRAM_BINS; b++) {
+        total += state.histogram[b];
+    }
+    uint32_t target = total * AGC_PERCENTILE / 100;
+    uint32_t sum = 0;
+    for (uint8_t b = 0; b < AGC_HISTOGRAM_BINS; b++) {
+        sum += state.histogram[b];
+        if (sum > target) return b;
+    }
+    return AGC_HISTOGRAM_BINS - 1;
+}
+
+uint16_t AutoGain::getThreshold(uint8_t mode) const {
+    uint32_t threshold = pow2Eighths(modes[mode].thresholdLogQ16 >> 16);
+    return constrain(threshold, AGC_MIN_THRESHOLD, AGC_MAX_THRESHOLD);
+}
+
+void AutoGain::update(int level) {
+    uint32_t now = renderMillis();
+    if (audioInputMode != activeMode) {
+        // Input switched - continue with that input's own state
+        activate(audioInputMode);
+        lastUpdateMs = now;
+        lastDecayMs = now;
+    }
+    ModeState& state = modes[activeMode];
+
+    state.histogram[levelBin(level)] += 16;
+    if (now - lastDecayMs >= AGC_DECAY_MS) {
+        lastDecayMs = now;
+        decay(state);
+    }
+
+    // Follow the percentile in the log domain: fast attack, slow release
+    state.targetBin = percentileBin(state);
+    int32_t targetQ16 = (int32_t)(state.targetBin * 2 + 1) << 16;  // Bin center in 1/8 octaves
+    int32_t difference = targetQ16 - (int32_t)state.thresholdLogQ16;
+    uint16_t tau = (difference > 0) ? AGC_ATTACK_MS : AGC_RELEASE_MS;
+    uint32_t stepQ16 = (min<uint32_t>(now - lastUpdateMs, tau) << 16) / tau;
+    state.thresholdLogQ16 += (int64_t)difference * stepQ16 / 65536;
+    lastUpdateMs = now;
+
+    audioThreshold = getThreshold(activeMode);
+    state.thresholdMin = min<uint16_t>(state.thresholdMin, audioThreshold);
+    state.thresholdMax = max<uint16_t>(state.thresholdMax, audioThreshold);
+}
+
+void AutoGain::printStatus() {
+    Serial.println(F("=== Auto Gain ==="));
+    Serial.print(F("Enabled: "));
+    Serial.println(audioAutoGain ? "YES" : "NO");
+    for (uint8_t mode = 0; mode < NUM_AUDIO_INPUT_MODES; mode++) {
+        ModeState& state = modes[mode];
+        Serial.print(AudioInputModeNames[mode]);
+        Serial.println(mode == activeMode ? F(" (active)") : F(""));
+        if (!state.primed) {
+            Serial.println(F("  No data yet"));
+            continue;
+        }
+        Serial.print(F("  Threshold: "));
+        Serial.print(getThreshold(mode));
+        Serial.print(F(" (range "));
+        Serial.print(state.thresholdMin);
+        Serial.print(F("-"));
+        Serial.print(state.thresholdMax);
+        Serial.println(F(" since last report)"));
+        Serial.print(F("  P"));
+        Serial.print(AGC_PERCENTILE);
+        Serial.print(F(" level: "));
+        Serial.println(pow2Eighths(state.targetBin * 2 + 1));
+
+        // Histogram as one digit per bin (0-9, relative to the fullest bin)
+        uint16_t fullest = 1;
+        for (uint8_t b = 0; b < AGC_HISTOGRAM_BINS; b++) {
+            fullest = max(fullest, state.histogram[b]);
+        }
+        Serial.print(F("  Histogram: "));
+        for (uint8_t b = 0; b < AGC_HISTOGRAM_BINS; b++) {
+            Serial.print((char)('0' + (uint32_t)state.histogram[b] * 9 / fullest));
+        }
+        Serial.println();
+
+        state.thresholdMin = getThreshold(mode);
+        state.thresholdMax = state.thresholdMin;
+    }
+    Serial.println(F("================="));
+}
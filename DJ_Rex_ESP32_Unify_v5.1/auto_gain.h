@@ -0,0 +1,44 @@
+// auto_gain.h - v5.2 Percentile-Based Automatic Gain Control
+#ifndef AUTO_GAIN_H
+#define AUTO_GAIN_H
+
+#include "config.h"
+
+// Keeps a decaying histogram of recent levels in the log domain and moves
+// audioThreshold toward the AGC_PERCENTILE level - quickly up, slowly down -
+// so single spikes do not swing it and loud passages do not pin it.
+// Each audio input mode keeps its own histogram and threshold; switching
+// the input restores that mode's threshold immediately.
+class AutoGain {
+public:
+    void reset();
+
+    // Feed one sensitivity-mapped level (called once per new ADC reading)
+    void update(int level);
+
+    uint16_t getThreshold(uint8_t mode) const;
+    void printStatus();
+
+private:
+    struct ModeState {
+        uint16_t histogram[AGC_HISTOGRAM_BINS];
+        uint32_t thresholdLogQ16; // 1/8 octaves, Q16 (fine enough for slow releases at 10ms steps)
+        uint8_t targetBin;
+        bool primed;
+        uint16_t thresholdMin;    // Range since the last status report
+        uint16_t thresholdMax;
+    };
+
+    void activate(uint8_t mode);
+    void decay(ModeState& state);
+    uint8_t percentileBin(const ModeState& state) const;
+
+    ModeState modes[NUM_AUDIO_INPUT_MODES] = {};
+    uint8_t activeMode = 0xFF;
+    uint32_t lastUpdateMs = 0;
+    uint32_t lastDecayMs = 0;
+};
+
+extern AutoGain autoGain;
+
+#endif
@@ -0,0 +1,223 @@
+// beat_detector.cpp - v5.2 Beat/Onset Detector & Tempo Tracker
+#include "beat_detector.h"
+#include "globals.h"
+#include "audio.h"
+#include "render_clock.h"
+
+BeatDetector beatDetector;
+
+#define BEAT_CENTER_LAG (60000 / (120 * BEAT_BLOCK_MS))  // 120 BPM
+#define BEAT_MIN_ACC 4096                                 // Below this the tempo peak is noise
+
+void BeatDetector::reset() {
+    bool sync = beatSync;
+    *this = BeatDetector();
+    beatSync = sync;
+}
+
+void BeatDetector::processBlock(uint16_t rms) {
+    blockIndex++;
+
+    // Onset strength: rise of the log energy (1/8 octaves, Q4) above its short-term average
+    int16_t energyQ4 = log2Eighths(rms) * 16;
+    int16_t rise = energyQ4 - energyAvgQ4;
+    energyAvgQ4 += (energyQ4 - energyAvgQ4) / 8;
+    uint8_t onset = constrain(rise / 2, 0, 255);
+
+    // Strong onsets stand out from the recent onset level
+    bool strong = onset > 16 && onset * 16 > onsetAvgQ4 * 3;
+    onsetAvgQ4 += (onset * 16 - onsetAvgQ4) / 16;
+    if (strong) lastOnsetBlock = blockIndex;
+
+    // Running autocorrelation: lagAcc[i] ~ sum of onset(t) * onset(t - lag), decaying
+    historyPos = (historyPos + 1) % BEAT_HISTORY_SIZE;
+    onsetHistory[historyPos] = onset;
+    for (uint8_t i = 0; i < BEAT_NUM_LAGS; i++) {
+        uint8_t lag = BEAT_MIN_LAG + i;
+        uint8_t past = onsetHistory[(historyPos + BEAT_HISTORY_SIZE - lag) % BEAT_HISTORY_SIZE];
+        lagAcc[i] = lagAcc[i] - (lagAcc[i] >> BEAT_ACC_SHIFT) + (uint16_t)onset * past;
+    }
+
+    updateTempo();
+    trackBeat(strong);
+}
+
+void BeatDetector::updateTempo() {
+    uint32_t sum = 0;
+    uint32_t bestWeighted = 0;
+    uint8_t best = 0;
+    for (uint8_t i = 0; i < BEAT_NUM_LAGS; i++) {
+        sum += lagAcc[i];
+        // Include the neighbours - a fractional period spreads over two lags.
+        // Mild preference for periods near 120 BPM against half/double tempo ambiguity.
+        uint32_t spread = lagAcc[i] + (i > 0 ? lagAcc[i - 1] : 0) + (i < BEAT_NUM_LAGS - 1 ? lagAcc[i + 1] : 0);
+        uint16_t weight = 256 - abs((int)(BEAT_MIN_LAG + i) - BEAT_CENTER_LAG) * 2;
+        uint32_t weighted = (spread >> 8) * weight;
+        if (weighted > bestWeighted) {
+            bestWeighted = weighted;
+            best = i;
+        }
+    }
+
+    // Settle on the strongest single lag of the winning neighbourhood
+    uint8_t center = best;
+    if (center > 0 && lagAcc[center - 1] > lagAcc[best]) best = center - 1;
+    if (center < BEAT_NUM_LAGS - 1 && lagAcc[center + 1] > lagAcc[best]) best = center + 1;
+
+    uint32_t mean = sum / BEAT_NUM_LAGS;
+    confidence = min<uint32_t>(lagAcc[best] * 16 / (mean + 1), 255);
+
+    bool recentOnset = (blockIndex - lastOnsetBlock) * BEAT_BLOCK_MS < BEAT_LOST_MS;
+    locked = recentOnset && lagAcc[best] > BEAT_MIN_ACC && confidence >= BEAT_LOCK_RATIO * 16;
+    if (!locked) {
+        bpm10 = 0;
+        hasPhase = false;
+        return;
+    }
+
+    // Parabolic interpolation between the neighbouring lags for a fractional period
+    int32_t periodEstimate = (int32_t)(BEAT_MIN_LAG + best) << 8;
+    if (best > 0 && best < BEAT_NUM_LAGS - 1) {
+        int64_t left = lagAcc[best - 1];
+        int64_t center = lagAcc[best];
+        int64_t right = lagAcc[best + 1];
+        int64_t curvature = left - 2 * center + right;
+        if (curvature < 0) {
+            periodEstimate += (int32_t)((left - right) * 128 / curvature);
+        }
+    }
+
+    // Follow small tempo drifts smoothly, jump on tempo changes
+    int32_t difference = periodEstimate - (int32_t)periodQ8;
+    if (periodQ8 == 0 || abs(difference) > (int32_t)periodQ8 / 8) {
+        periodQ8 = periodEstimate;
+    } else {
+        periodQ8 += difference / 4;
+    }
+
+    bpm10 = (600000UL * 256) / (periodQ8 * BEAT_BLOCK_MS);
+    periodMs = (periodQ8 * BEAT_BLOCK_MS) >> 8;
+    beatsPerMinute = getBpm();
+}
+
+void BeatDetector::trackBeat(bool strongOnset) {
+    if (!locked) return;
+
+    uint32_t nowQ8 = blockIndex << 8;
+    if (!hasPhase) {
+        // Start counting on the first strong onset - it becomes the downbeat
+        if (!strongOnset) return;
+        hasPhase = true;
+        nextBeatQ8 = nowQ8;
+        beatInBar = BEATS_PER_BAR - 1;
+    } else if (strongOnset) {
+        // Pull the predicted beat halfway toward a nearby onset
+        int32_t error = (int32_t)(nowQ8 - nextBeatQ8);
+        if (error < -(int32_t)periodQ8 / 2) {
+            error += periodQ8;  // Late onset of the beat that already fired
+        }
+        if (abs(error) < (int32_t)periodQ8 / 4) {
+            nextBeatQ8 += error / 2;
+        }
+    }
+
+    if ((int32_t)(nowQ8 - nextBeatQ8) >= 0) {
+        nextBeatQ8 += periodQ8;
+        beatInBar = (beatInBar + 1) % BEATS_PER_BAR;
+
+        uint32_t now = renderMillis();
+        lastBeatMs = now;
+        beatCount++;
+        if (beatInBar == 0) {
+            lastDownbeatMs = now;
+            downbeatCount++;
+        }
+    }
+}
+
+uint8_t BeatDetector::getBeatPhase() const {
+    if (!locked) return 0;
+    uint32_t elapsed = renderMillis() - lastBeatMs;
+    if (elapsed >= periodMs) return 255;
+    return (elapsed * 256) / periodMs;
+}
+
+bool BeatDetector::isSwitchPoint(uint32_t overdueMs) const {
+    if (!beatSync || !locked || overdueMs >= BEAT_SYNC_MAX_WAIT_MS) {
+        return true;
+    }
+    // A downbeat since the switch became due
+    return renderMillis() - lastDownbeatMs <= overdueMs;
+}
+
+void BeatDetector::printStatus() {
+    Serial.println(F("=== Beat Detector ==="));
+    Serial.print(F("Tempo: "));
+    if (locked) {
+        Serial.print(bpm10 / 10);
+        Serial.print(F("."));
+        Serial.print(bpm10 % 10);
+        Serial.println(F(" BPM"));
+    } else {
+        Serial.println(F("no lock"));
+    }
+    Serial.print(F("Confidence: "));
+    Serial.print(confidence / 16);
+    Serial.print(F("."));
+    Serial.print((confidence % 16) * 10 / 16);
+    Serial.print(F("x (lock at "));
+    Serial.print(BEAT_LOCK_RATIO);
+    Serial.println(F("x)"));
+    Serial.print(F("Beats: "));
+    Serial.print(beatCount);
+    Serial.print(F(" ("));
+    Serial.print(downbeatCount);
+    Serial.println(F(" downbeats)"));
+    Serial.print(F("Beat Sync: "));
+    Serial.println(beatSync ? "ON (playlist/demo switch on downbeats)" : "OFF");
+    Serial.println(F("====================="));
+}
+
+void BeatDetector::runSelfTest() {
+    static const uint8_t testBpms[] = {80, 100, 120, 128, 140, 170};
+    const uint16_t blocks = 1000;  // 10 seconds of audio blocks
+
+    Serial.println(F("=== Beat Self-Test ==="));
+    uint8_t passed = 0;
+    for (uint8_t t = 0; t < ARRAY_SIZE(testBpms); t++) {
+        BeatDetector detector;
+        uint32_t lastClick = 0xFFFFFFFF;
+
+        uint32_t start = micros();
+        for (uint16_t b = 0; b < blocks; b++) {
+            // One loud block per beat over a low noise floor
+            uint32_t beat = (uint32_t)b * BEAT_BLOCK_MS * testBpms[t] / 60000;
+            uint16_t rms = (beat != lastClick) ? 1200 : 20 + random8(8);
+            lastClick = beat;
+            detector.processBlock(rms);
+        }
+        uint32_t perBlockUs = (micros() - start) / blocks;
+
+        int16_t error = (int16_t)detector.getBpm10() - testBpms[t] * 10;
+        bool ok = detector.isLocked() && abs(error) <= 20;
+        if (ok) passed++;
+
+        Serial.print(testBpms[t]);
+        Serial.print(F(" BPM -> "));
+        Serial.print(detector.getBpm10() / 10);
+        Serial.print(F("."));
+        Serial.print(detector.getBpm10() % 10);
+        Serial.print(F(" BPM, "));
+        Serial.print(detector.getBeatCount());
+        Serial.print(F(" beats, "));
+        Serial.print(perBlockUs);
+        Serial.print(F(" us/block "));
+        Serial.println(ok ? "PASS" : "FAIL");
+    }
+    Serial.print(F("Result: "));
+    Serial.print(passed);
+    Serial.print(F("/"));
+    Serial.print(ARRAY_SIZE(testBpms));
+    Serial.println(F(" passed"));
+    Serial.println(F("======================"));
+}
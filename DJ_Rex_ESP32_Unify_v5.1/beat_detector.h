@@ -0,0 +1,75 @@
+// beat_detector.h - v5.2 Beat/Onset Detector & Tempo Tracker
+#ifndef BEAT_DETECTOR_H
+#define BEAT_DETECTOR_H
+
+#include "config.h"
+
+#define BEAT_NUM_LAGS (BEAT_MAX_LAG - BEAT_MIN_LAG + 1)
+#define BEAT_HISTORY_SIZE (BEAT_MAX_LAG + 1)
+
+// Energy-based onset detector with a running autocorrelation tempo estimate.
+// processBlock() is fed one RMS value per ADC block and does a fixed amount
+// of work (one pass over BEAT_NUM_LAGS). Beats are predicted from the tempo
+// and pulled toward strong onsets; every BEATS_PER_BAR-th beat after locking
+// counts as a downbeat.
+class BeatDetector {
+public:
+    void reset();
+    void processBlock(uint16_t rms);
+
+    bool isLocked() const { return locked; }
+    uint16_t getBpm10() const { return bpm10; }                // BPM x 10, 0 without lock
+    uint8_t getBpm() const { return (bpm10 + 5) / 10; }
+    uint8_t getBeatPhase() const;                              // 0-255 since the last beat
+    uint32_t getBeatCount() const { return beatCount; }        // Increments on every beat
+    uint32_t getDownbeatCount() const { return downbeatCount; }
+    uint8_t getConfidence() const { return confidence; }
+
+    // Downbeat switching for the playlist and demo mode: true when a switch
+    // that has been due for overdueMs should happen now
+    void setBeatSync(bool enabled) { beatSync = enabled; }
+    bool isBeatSync() const { return beatSync; }
+    bool isSwitchPoint(uint32_t overdueMs) const;
+
+    void printStatus();
+
+    // Feed synthetic click tracks and compare the tempo estimates
+    static void runSelfTest();
+
+private:
+    void updateTempo();
+    void trackBeat(bool strongOnset);
+
+    // Onset detection
+    int16_t energyAvgQ4 = 0;
+    int16_t onsetAvgQ4 = 0;
+    uint8_t onsetHistory[BEAT_HISTORY_SIZE] = {};
+    uint8_t historyPos = 0;
+
+    // Tempo (autocorrelation of the onset signal per candidate period)
+    uint32_t lagAcc[BEAT_NUM_LAGS] = {};
+    uint32_t periodQ8 = 0;  // Beat period in 1/256 blocks
+    uint8_t confidence = 0;
+
+    // Beat phase
+    uint32_t blockIndex = 0;
+    uint32_t nextBeatQ8 = 0;
+    uint32_t lastOnsetBlock = 0;
+    bool hasPhase = false;
+    uint8_t beatInBar = 0;
+
+    // Published state (read by the render side)
+    volatile bool locked = false;
+    volatile uint16_t bpm10 = 0;
+    volatile uint32_t beatCount = 0;
+    volatile uint32_t downbeatCount = 0;
+    volatile uint32_t lastBeatMs = 0;
+    volatile uint32_t lastDownbeatMs = 0;
+    volatile uint32_t periodMs = 500;
+
+    bool beatSync = true;
+};
+
+extern BeatDetector beatDetector;
+
+#endif
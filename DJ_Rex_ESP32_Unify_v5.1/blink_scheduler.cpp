@@ -0,0 +1,117 @@
+// blink_scheduler.cpp - v5.2 Deadline Scheduler for Blinking Side LEDs and Blocks
+#include "blink_scheduler.h"
+
+static_assert(NUM_BLINK_SLOTS <= 64, "Blink slots must fit into the 64-bit masks");
+
+void BlinkScheduler::reset() {
+    heapSize = 0;
+    onMask = 0;
+}
+
+void BlinkScheduler::schedule(uint8_t slot, uint32_t now, uint16_t interval) {
+    if (heapSize >= NUM_BLINK_SLOTS) return;
+
+    heap[heapSize].deadline = now + interval + 1;
+    heap[heapSize].slot = slot;
+    siftUp(heapSize);
+    heapSize++;
+}
+
+uint64_t BlinkScheduler::collectDue(uint32_t now) {
+    uint64_t due = 0;
+    while (heapSize > 0 && !before(now, heap[0].deadline)) {
+        due |= 1ULL << heap[0].slot;
+        heap[0] = heap[--heapSize];
+        siftDown(0);
+    }
+    return due;
+}
+
+void BlinkScheduler::siftUp(uint8_t pos) {
+    Entry entry = heap[pos];
+    while (pos > 0) {
+        uint8_t parent = (pos - 1) / 2;
+        if (!before(entry.deadline, heap[parent].deadline)) break;
+        heap[pos] = heap[parent];
+        pos = parent;
+    }
+    heap[pos] = entry;
+}
+
+void BlinkScheduler::siftDown(uint8_t pos) {
+    Entry entry = heap[pos];
+    while (true) {
+        uint8_t child = pos * 2 + 1;
+        if (child >= heapSize) break;
+        if (child + 1 < heapSize && before(heap[child + 1].deadline, heap[child].deadline)) {
+            child++;
+        }
+        if (!before(heap[child].deadline, entry.deadline)) break;
+        heap[pos] = heap[child];
+        pos = child;
+    }
+    heap[pos] = entry;
+}
+
+bool BlinkScheduler::isOn(uint8_t slot) const {
+    return (onMask >> slot) & 1;
+}
+
+void BlinkScheduler::setOn(uint8_t slot, bool on) {
+    if (on) {
+        onMask |= 1ULL << slot;
+    } else {
+        onMask &= ~(1ULL << slot);
+    }
+}
+
+void BlinkScheduler::fadeOffLeds(uint8_t panel, CRGB* leds, uint8_t fadeAmount) const {
+    // Build a per-LED mask of the panel's LEDs that are off
+    uint32_t slots = (uint32_t)(onMask >> (panel * BLINK_SLOTS_PER_PANEL));
+    uint32_t offLeds = ~slots & ((1UL << SIDE_LEDS_COUNT) - 1);
+    for (uint8_t block = 0; block < BLINK_BLOCKS_PER_PANEL; block++) {
+        if (!((slots >> (SIDE_LEDS_COUNT + block)) & 1)) {
+            offLeds |= ((1UL << LEDS_PER_BLOCK) - 1) << blockStart(block);
+        }
+    }
+
+    // Scale each run of consecutive off LEDs in one call (same math as fadeToBlackBy)
+    uint8_t scale = 255 - fadeAmount;
+    uint8_t pos = 0;
+    while (offLeds != 0) {
+        while (!(offLeds & 1)) {
+            offLeds >>= 1;
+            pos++;
+        }
+        uint8_t runStart = pos;
+        while (offLeds & 1) {
+            offLeds >>= 1;
+            pos++;
+        }
+        nscale8(&leds[runStart], pos - runStart, scale);
+    }
+}
+
+uint8_t BlinkScheduler::sideSlot(uint8_t panel, uint8_t led) {
+    return panel * BLINK_SLOTS_PER_PANEL + led;
+}
+
+uint8_t BlinkScheduler::blockSlot(uint8_t panel, uint8_t block) {
+    return panel * BLINK_SLOTS_PER_PANEL + SIDE_LEDS_COUNT + block;
+}
+
+uint8_t BlinkScheduler::blockStart(uint8_t block) {
+    return BLOCK1_START + block * LEDS_PER_BLOCK;
+}
+
+int8_t BlinkScheduler::slotForLed(uint8_t panel, uint8_t pos) {
+    if (pos < SIDE_LEDS_COUNT) {
+        return sideSlot(panel, pos);
+    }
+    for (uint8_t block = 0; block < BLINK_BLOCKS_PER_PANEL; block++) {
+        if (pos == blockStart(block)) {
+            return blockSlot(panel, block);
+        }
+    }
+    return -1;
+}
@@ -0,0 +1,55 @@
+// blink_scheduler.h - v5.2 Deadline Scheduler for Blinking Side LEDs and Blocks
+#ifndef BLINK_SCHEDULER_H
+#define BLINK_SCHEDULER_H
+
+#include "config.h"
+#include "globals.h"
+
+// One slot per independently blinking unit: 8 side LEDs + 3 blocks per panel
+#define BLINK_BLOCKS_PER_PANEL 3
+#define BLINK_SLOTS_PER_PANEL (SIDE_LEDS_COUNT + BLINK_BLOCKS_PER_PANEL)
+#define NUM_BLINK_SLOTS (3 * BLINK_SLOTS_PER_PANEL)
+
+// Keeps the next on/off deadline of every slot in a min-heap, so a frame
+// only touches the slots that actually switch. On/off state is a bitset.
+class BlinkScheduler {
+public:
+    void reset();
+
+    // Next deadline of a slot: switches once more than interval ms passed
+    void schedule(uint8_t slot, uint32_t now, uint16_t interval);
+
+    // Remove all slots whose deadline passed; bit n set = slot n is due
+    uint64_t collectDue(uint32_t now);
+
+    bool isOn(uint8_t slot) const;
+    void setOn(uint8_t slot, bool on);
+
+    // Fade every LED of a panel whose side LED or block is off, one run at a time
+    void fadeOffLeds(uint8_t panel, CRGB* leds, uint8_t fadeAmount) const;
+
+    // Slot helpers
+    static uint8_t sideSlot(uint8_t panel, uint8_t led);
+    static uint8_t blockSlot(uint8_t panel, uint8_t block);
+    static int8_t slotForLed(uint8_t panel, uint8_t pos);  // -1 if pos starts no slot
+    static uint8_t blockStart(uint8_t block);
+
+private:
+    struct Entry {
+        uint32_t deadline;
+        uint8_t slot;
+    };
+
+    Entry heap[NUM_BLINK_SLOTS];
+    uint8_t heapSize = 0;
+    uint64_t onMask = 0;
+
+    // Wrap-safe deadline order (deadlines are at most 30s apart)
+    static bool before(uint32_t a, uint32_t b) {
+        return (int32_t)(a - b) < 0;
+    }
+    void siftUp(uint8_t pos);
+    void siftDown(uint8_t pos);
+};
+
+#endif
@@ -2,6 +2,10 @@
 #define CONFIG_H
 
 #include <Arduino.h>
+
+// v5.2: FastLED timing functions use the animation clock (render_clock.cpp).
+// config.h must therefore be included before FastLED.h.
+#define USE_GET_MILLISECOND_TIMER
 #include <FastLED.h>
 
 // =============================================================================
@@ -36,6 +40,8 @@
 #define NUM_EYES 2
 #define NUM_MOUTH_LEDS 80
 #define TOTAL_BODY_LEDS 60
+#define NUM_EYES_MOUTH_LEDS (NUM_EYES + NUM_MOUTH_LEDS)  // Daisy-chained on EYES_MOUTH_PIN
+#define NUM_TOTAL_LEDS (TOTAL_BODY_LEDS + NUM_EYES_MOUTH_LEDS)  // v5.2: Flat frame buffer
 
 // =============================================================================
 // PIN DEFINITIONS - Board Specific
@@ -80,23 +86,50 @@
 
 // Mouth layout
 #define MOUTH_ROWS 12
-#define NUM_MOUTH_PATTERNS 15  // v5.0: Added Matrix, Heartbeat, Spectrum
 
 // Color configuration
 #define NUM_STANDARD_COLORS 20
 #define RANDOM_COLOR_INDEX 19
 
 // Timing
-#define FRAMES_PER_SECOND 30
+// v5.2: Default render rate of the frame-paced render task (one frame per LED output)
+#define FRAMES_PER_SECOND 50
 #define FRAME_DELAY_MS (1000 / FRAMES_PER_SECOND)
+#define MIN_FRAMES_PER_SECOND 10
+#define MAX_FRAMES_PER_SECOND 100
+// v5.2: Patterns advance by elapsed time, not per frame. Amounts that used to
+// apply once per frame (fades, chances, steps) apply once per reference frame.
+#define REFERENCE_FRAME_MS 20
+#define MAX_FRAME_DT_MS 250                // Longer stalls don't jump the animations
+#define TIME_SCALE_DEFAULT 100             // Animation speed in % of real time
+#define MIN_TIME_SCALE 10
+#define MAX_TIME_SCALE 400
 #define ARRAY_SIZE(A) (sizeof(A) / sizeof((A)[0]))
 #define DECAYTIME 80
 
+// v5.2: Transitions render the outgoing pattern live next to the incoming one.
+// If that extra work (second render + composite) exceeds the budget for a few
+// frames in a row, the rest of the fade uses the last outgoing frame instead.
+#define TRANSITION_BUDGET_US 5000          // A quarter of a 50 fps frame
+#define TRANSITION_OVER_BUDGET_FRAMES 3
+#define TRANSITION_DURATION_MS 1000        // Default length (0 = cut)
+#define MAX_TRANSITION_MS 10000
+// Share of the transition each LED takes to fade, out of 255 (the rest is
+// the spread of the start times across the LEDs)
+#define TRANSITION_STAGGER_WIDTH 128
+#define TRANSITION_WIPE_WIDTH 64
+#define TRANSITION_DISSOLVE_WIDTH 32
+
+// v5.2: Pattern state arena - two slots per pattern table (live pattern and
+// the outgoing one of a transition), each sized for the table's largest state
+#define PATTERN_ARENA_MAX_BYTES 1024       // Compile-time limit for all four slots
+
 // =============================================================================
 // v5.0 NEW: FREERTOS & THREAD SAFETY
 // =============================================================================
 // Automatically enabled on dual-core ESP32-S3, disabled on single-core ESP32-C3
-// to prevent LED flickering on single-core chips
+// to prevent LED flickering on single-core chips (the C3 samples audio from the
+// ADC DMA interrupt instead, see ADC_ISR_RING)
 #if IS_DUAL_CORE
     #define ENABLE_FREERTOS_AUDIO true
     #define AUDIO_TASK_CORE 0  // Run audio task on Core 0, main loop on Core 1
@@ -108,6 +141,103 @@
 #define AUDIO_TASK_PRIORITY 2
 #define AUDIO_SAMPLE_INTERVAL_MS 5
 
+// v5.2: Continuous ADC sampling via DMA. The audio level is the RMS of each
+// block after a running DC high-pass; the spectrum reads the sample history.
+// Needs the esp_adc driver of ESP-IDF 5.1+ (esp32 core 3.x); older cores and
+// ENABLE_ADC_DMA false keep the analogRead() path.
+#define ENABLE_ADC_DMA true
+#define ADC_DMA_SAMPLE_RATE 10000      // Hz
+#define ADC_DMA_FRAME_SAMPLES 64       // Samples per DMA transfer
+#define ADC_DMA_POOL_SAMPLES 1024      // Driver ring (~100ms) - older samples are dropped and counted
+#define ADC_BLOCK_SAMPLES 100          // 10ms blocks reduced to RMS/peak
+#define ADC_DC_SHIFT 12                // DC tracking time constant: 2^12 samples (~0.4s)
+
+// v5.2: Without an audio task the DMA conversion-done interrupt copies samples
+// into a lock-free ring that the render loop drains once per frame, so sampling
+// continues during FastLED.show() and long frames
+#define ADC_ISR_RING (!ENABLE_FREERTOS_AUDIO)
+#define ADC_RING_SAMPLES 2048          // Power of two (~200ms at 10 kHz, 4KB)
+
+// v5.2: Per-frame audio envelopes (render side, frame-rate independent)
+#define AUDIO_ATTACK_MS 10             // Fast envelope rise
+#define AUDIO_RELEASE_MS 150           // Fast envelope fall
+#define AUDIO_SLOW_MS 1000             // Slow envelope (average loudness)
+#define AUDIO_PEAK_DECAY 200           // Peak fall per second (0-255 scale)
+#define AUDIO_GATE_OPEN 24             // Gate opens above this fast level (0-255)
+#define AUDIO_GATE_CLOSE 12            // ... and closes below this one
+
+// v5.2: Audio routing - per-zone values evaluated once per frame
+#define AUDIO_BEAT_PULSE_MS 250        // "beat" source falls from 255 to 0 in this time
+#define EYE_AUDIO_FLOOR 64             // Eye brightness scale at silence when the eyes are routed
+
+// v5.2: Beat detector - runs once per ADC block (DMA sampling only)
+#define BEAT_BLOCK_MS (ADC_BLOCK_SAMPLES * 1000 / ADC_DMA_SAMPLE_RATE)
+#define BEAT_MIN_BPM 70
+#define BEAT_MAX_BPM 180
+#define BEAT_MIN_LAG (60000 / (BEAT_MAX_BPM * BEAT_BLOCK_MS))     // Beat period in blocks
+#define BEAT_MAX_LAG (60000 / (BEAT_MIN_BPM * BEAT_BLOCK_MS))
+#define BEAT_ACC_SHIFT 8               // Tempo memory: 2^8 blocks (~2.5s)
+#define BEAT_LOCK_RATIO 3              // Tempo peak must be this many times the lag average
+#define BEAT_LOST_MS 3000              // Lose the lock after this long without onsets
+#define BEATS_PER_BAR 4
+#define BEAT_SYNC_MAX_WAIT_MS 4000     // Longest a due playlist/demo switch waits for a downbeat
+
+// v5.2: Biquad filter bank - runs on every DMA sample and keeps a rectified
+// envelope per band. Band 0 is a low-pass, the last a high-pass, the others
+// band-passes between log-spaced edges. Much cheaper than the FFT.
+#define ENABLE_FILTER_BANK true
+#define FILTER_BANK_BANDS 3            // 3-6 (bass / mid(s) / treble)
+#define FILTER_BANK_MIN_HZ 60
+#define FILTER_BANK_MAX_HZ 4000
+#define FILTER_INPUT_SHIFT 2           // 12-bit samples scaled to 14 bits for precision
+#define FILTER_ATTACK_SHIFT 3          // Envelope rise: 2^3 samples (~1ms)
+#define FILTER_RELEASE_SHIFT 10        // Envelope fall: 2^10 samples (~100ms)
+
+// v5.2: Spectrum analyzer - fixed-point FFT over the newest ADC samples.
+// The C3 has no audio task, so it runs a smaller transform at a lower rate
+// in the render task (and keeps the burst capture short without DMA).
+#define SPECTRUM_BANDS 8               // Log-spaced output bands (8-16)
+#define SPECTRUM_SAMPLE_RATE ADC_DMA_SAMPLE_RATE  // Burst capture only without the DMA stream
+#if IS_DUAL_CORE
+    #define SPECTRUM_FFT_BITS 7        // 128 points, 12.8ms capture, 78 Hz per bin
+    #define SPECTRUM_INTERVAL_MS 25
+#else
+    #define SPECTRUM_FFT_BITS 6        // 64 points, 6.4ms capture, 156 Hz per bin
+    #define SPECTRUM_INTERVAL_MS 100
+#endif
+#define SPECTRUM_FFT_SIZE (1 << SPECTRUM_FFT_BITS)
+#define SPECTRUM_MIN_FREQ 60           // Lower edge of the first band (Hz)
+#define SPECTRUM_FLOOR 24              // Noise floor in 1/8 octaves (3 octaves above 1 LSB)
+#define SPECTRUM_DECAY 12              // Band fall per update (0-255 scale)
+#define SPECTRUM_PEAK_HOLD_MS 400
+#define SPECTRUM_PEAK_DECAY 6          // Peak fall per update after the hold time
+
+// v5.2: Render task - computes and outputs exactly one frame per tick.
+// Runs next to the Arduino loop (Core 1 on S3), which only handles the console.
+#if IS_DUAL_CORE
+    #define RENDER_TASK_CORE 1
+#else
+    #define RENDER_TASK_CORE 0
+#endif
+#define RENDER_TASK_STACK_SIZE 8192
+#define RENDER_TASK_PRIORITY 3
+
+// v5.2: LED output - only resend outputs whose contents changed
+#define LED_SELECTIVE_SHOW true
+#define LED_REFRESH_INTERVAL_MS 1000  // Resend unchanged outputs at least this often (0 = never)
+
+// v5.2: LED output backend. Parallel RMT needs one RMT TX channel per output
+// (S3: 4) and esp32 core 3.x; boards with fewer channels (C3: 2) and older
+// cores build the FastLED backend instead.
+#define LED_BACKEND_FASTLED 0        // FastLED controllers, outputs sent one after another
+#define LED_BACKEND_PARALLEL_RMT 1   // One RMT channel per output, all outputs sent at once
+#ifndef LED_OUTPUT_BACKEND
+#define LED_OUTPUT_BACKEND LED_BACKEND_PARALLEL_RMT
+#endif
+// Applied by both backends (FastLED's defaults leave the colors as they are)
+#define LED_COLOR_CORRECTION UncorrectedColor
+#define LED_COLOR_TEMPERATURE UncorrectedTemperature
+
 // Mutex timeouts
 #define LED_MUTEX_TIMEOUT_MS 100
 #define PATTERN_CHANGE_TIMEOUT_MS 200
@@ -124,6 +254,28 @@
 #define HEALTH_CHECK_INTERVAL_MS 60000
 #define MAX_CONSECUTIVE_ERRORS 5
 
+// v5.2: Frame profiler - CPU cycle timing of every render stage, per pattern.
+// Off by default: the per-pattern tables take ~6 KB of RAM. When false the
+// instrumentation compiles out completely.
+#define ENABLE_FRAME_PROFILER false
+#define PERF_HISTOGRAM_BUCKETS 16
+#define PERF_HISTOGRAM_MIN_SHIFT 10   // First bucket: < 2^10 cycles (~4us @ 240MHz)
+
+// v5.2: Golden frames - deterministic render of every pattern, hashed per frame
+#define GOLDEN_FRAMES 32              // Frames per pattern (stored hashes: 4 bytes each)
+#define GOLDEN_FRAME_MS 20            // Virtual time between frames
+#define GOLDEN_SEED 1337              // RNG seed for FastLED and Arduino random()
+#define GOLDEN_CLOCK_START 0x80000000UL  // Far from live millis() so every timer fires on frame 0
+
+// v5.2: Audio replay - a WAV clip or a generated click track replaces the
+// microphone for the whole audio path (live or accelerated on the virtual clock)
+#define REPLAY_MAX_WAV_BYTES 98304    // Upload buffer (heap, freed by "replay off")
+#define REPLAY_UPLOAD_TIMEOUT_MS 5000 // Gap between bytes that aborts an upload
+#define REPLAY_DC_OFFSET 2150         // Emulated front-end bias (VCC/2 at 12dB attenuation)
+#define REPLAY_MIC_FULL_SCALE (MIC_MAP_RANGE / 2)          // PCM full scale in ADC counts
+#define REPLAY_LINE_IN_FULL_SCALE (LINE_IN_MAP_RANGE / 2)
+#define REPLAY_CLICK_MS 60            // Kick length of the generated click track
+
 // =============================================================================
 // v5.0 NEW: PRESET MANAGER (10 slots instead of 3)
 // =============================================================================
@@ -163,8 +315,28 @@ enum AudioMode {
     AUDIO_MOUTH_ONLY = 1,
     AUDIO_BODY_SIDES = 2,
     AUDIO_BODY_ALL = 3,
-    AUDIO_ALL = 4
+    AUDIO_ALL = 4,
+    AUDIO_BANDS = 5,    // v5.2: Bass -> blocks, mids -> side LEDs, highs -> mouth
+    AUDIO_CUSTOM = 6    // v5.2: Routing table edited with "route" (saved with the settings)
 };
+#define NUM_AUDIO_MODES 7
+
+// =============================================================================
+// v5.2: TRANSITION MODES
+// =============================================================================
+enum TransitionMode {
+    TRANSITION_FADE = 0,      // Linear crossfade
+    TRANSITION_EASED = 1,     // Crossfade with ease-in/ease-out
+    TRANSITION_STAGGER = 2,   // Panels one after another, left to right
+    TRANSITION_WIPE = 3,      // Soft edge sweeping left to right across the droid
+    TRANSITION_DISSOLVE = 4,  // Every LED switches at its own random moment
+    TRANSITION_BLACK = 5      // Fade out to black, then fade in
+};
+#define NUM_TRANSITION_MODES 6
+
+// Playlist entries without their own transition use the global setting
+#define TRANSITION_MODE_DEFAULT 0xFF
+#define TRANSITION_MS_DEFAULT 0xFFFF
 
 // =============================================================================
 // v5.1 NEW: AUDIO INPUT MODES
@@ -173,6 +345,17 @@ enum AudioInputMode {
     INPUT_MIC = 0,
     INPUT_LINE_IN = 1
 };
+#define NUM_AUDIO_INPUT_MODES 2
+
+// v5.2: Automatic gain control - audioThreshold follows a percentile of a
+// decaying log-level histogram, with separate state per input mode
+#define AGC_HISTOGRAM_BINS 48          // Quarter-octave bins of the mapped level
+#define AGC_PERCENTILE 90              // Threshold target: this percentile of recent levels
+#define AGC_DECAY_MS 500               // Histogram counts x15/16 this often (~8s memory)
+#define AGC_ATTACK_MS 300              // Threshold rise time constant
+#define AGC_RELEASE_MS 4000            // Threshold fall time constant
+#define AGC_MIN_THRESHOLD 50
+#define AGC_MAX_THRESHOLD 500
 
 // v5.1: Line-In default sensitivity (lower than mic due to stronger signal)
 #define LINE_IN_DEFAULT_SENSITIVITY 3
@@ -180,7 +363,6 @@ enum AudioInputMode {
 #define LINE_IN_MAP_RANGE 4095
 #define MIC_MAP_RANGE 2048
 
-// Pattern count
-#define NUM_PATTERNS 20  // v5.0: Added Plasma, Fire, Twinkle
+// v5.2: Pattern counts (NUM_PATTERNS, NUM_MOUTH_PATTERNS) are derived in pattern_registry.h
 
 #endif
\ No newline at end of file
@@ -1,61 +1,37 @@
 #include "demo.h"
 #include "helpers.h"
+#include "render_clock.h"
+#include "pattern_registry.h"
+#include "beat_detector.h"
+#include "transition.h"
 
-// v5.0: Extended demo patterns list (skip Off pattern and some less interesting ones)
-static const uint8_t demoBodyPatterns[] = {
-    1,  // Random Blocks
-    5,  // Rainbow
-    6,  // Rainbow Glitter
-    7,  // Confetti
-    8,  // Juggle
-    11, // Knight Rider
-    12, // Breathing
-    13, // Matrix Rain
-    17, // Plasma (v5.0)
-    18, // Fire (v5.0)
-    19, // Twinkle (v5.0)
-    9,  // Audio Sync
-    15  // Audio VU Meter
-};
-static const uint8_t numDemoBodyPatterns = sizeof(demoBodyPatterns) / sizeof(demoBodyPatterns[0]);
-
-// v5.0: Extended mouth demo patterns
-static const uint8_t demoMouthPatterns[] = {
-    1,  // Talk
-    2,  // Smile
-    4,  // Rainbow
-    6,  // Wave
-    7,  // Pulse
-    11, // Sparkle
-    12, // Matrix (v5.0)
-    13, // Heartbeat (v5.0)
-    3,  // Audio Reactive
-    14  // Spectrum (v5.0)
-};
-static const uint8_t numDemoMouthPatterns = sizeof(demoMouthPatterns) / sizeof(demoMouthPatterns[0]);
+// v5.2: Demo pattern lists are built from the registry's demoEligible flags
 
 void handleDemoMode() {
     if (!demoMode) return;
 
-    if (millis() - lastDemoChange >= (demoTime * 1000UL)) {
-        lastDemoChange = millis();
+    // v5.2: Switch on the next downbeat once due (see BeatDetector::isSwitchPoint)
+    uint32_t elapsed = renderMillis() - lastDemoChange;
+    uint32_t duration = demoTime * 1000UL;
+    if (elapsed >= duration && beatDetector.isSwitchPoint(elapsed - duration)) {
+        lastDemoChange = renderMillis();
         demoStep++;
 
         // Cycle through demo body patterns
         static uint8_t bodyDemoIndex = 0;
-        bodyDemoIndex = (bodyDemoIndex + 1) % numDemoBodyPatterns;
-        currentPattern = demoBodyPatterns[bodyDemoIndex];
+        bodyDemoIndex = (bodyDemoIndex + 1) % demoBodyPatterns.count;
+        transitionEngine.start(demoBodyPatterns.index[bodyDemoIndex]);
 
         Serial.print(F("Demo: "));
-        Serial.println(patternNames[currentPattern]);
+        Serial.println(bodyPatterns[currentPattern].name);
 
         // Cycle mouth patterns with body patterns
         static uint8_t mouthDemoIndex = 0;
-        mouthDemoIndex = (mouthDemoIndex + 1) % numDemoMouthPatterns;
-        mouthPattern = demoMouthPatterns[mouthDemoIndex];
+        mouthDemoIndex = (mouthDemoIndex + 1) % demoMouthPatterns.count;
+        transitionEngine.startMouth(demoMouthPatterns.index[mouthDemoIndex]);
 
         Serial.print(F("  Mouth: "));
-        Serial.println(MouthPatternNames[mouthPattern]);
+        Serial.println(mouthPatterns[mouthPattern].name);
 
         // Vary colors every few cycles
         if (demoStep % 3 == 0) {
@@ -1,10 +1,31 @@
 #include "eyes.h"
 #include "helpers.h"
+#include "render_clock.h"
+#include "audio_routing.h"
+
+// v5.2: Scale the eyes with their routed audio value (EYE_AUDIO_FLOOR at silence).
+// The flicker animation works on the LED values in place, so the unscaled
+// colors are kept and restored at the start of the next update.
+static CRGB eyesBeforeAudio[NUM_EYES];
+static bool eyesAudioScaled = false;
+
+// v5.2: Fraction of a flicker brightness step (one step per reference frame)
+static uint16_t flickerRest = 0;
+
+static void applyEyeAudio() {
+    if (!audioRouter.isRouted(AUDIO_ZONE_EYES)) return;
+    uint8_t scale = EYE_AUDIO_FLOOR + scale8(audioRouter.getLevel(AUDIO_ZONE_EYES), 255 - EYE_AUDIO_FLOOR);
+    for (int pos = 0; pos < NUM_EYES; pos++) {
+        eyesBeforeAudio[pos] = DJLEDs_Eyes[pos];
+        DJLEDs_Eyes[pos].nscale8(scale);
+    }
+    eyesAudioScaled = true;
+}
 
 void initializeEyes() {
     for (byte x = 0; x < NUM_EYES; x++) {
         EyesIntervalTime[x] = random(eyeFlickerMinTime, eyeFlickerMaxTime);
-        EyesLEDMillis[x] = millis();
+        EyesLEDMillis[x] = frameContext().now;
         EyesLEDOn[x] = 0;
         EyesLEDBrightness[x] = ledBrightness;
         EyesLEDMinBrightness[x] = ledBrightness;
@@ -12,8 +33,16 @@ void initializeEyes() {
 }
 
 void updateEyes() {
+    const FrameContext& frame = frameContext();
     CRGB eyeColors[NUM_EYES];
 
+    if (eyesAudioScaled) {
+        for (int pos = 0; pos < NUM_EYES; pos++) {
+            DJLEDs_Eyes[pos] = eyesBeforeAudio[pos];
+        }
+        eyesAudioScaled = false;
+    }
+
     // Determine the color for each eye based on the current eyeMode
     switch (eyeMode) {
         case 0: // Single Color
@@ -64,20 +93,26 @@ void updateEyes() {
             // Apply static brightness setting
             DJLEDs_Eyes[pos].fadeToBlackBy(255 - eyeStaticBrightness);
         }
+        applyEyeAudio();
         return;
     }
     
     // Original flicker animation
+    uint16_t steps = advanceBy(flickerRest, frame.dt, 1);
     for (int pos = 0; pos < NUM_EYES; pos++) {
         if (!EyesLEDOn[pos]) {
             DJLEDs_Eyes[pos].maximizeBrightness(EyesLEDBrightness[pos]);
-            if (EyesLEDBrightness[pos] < ledBrightness) EyesLEDBrightness[pos]++;
+            if (EyesLEDBrightness[pos] < ledBrightness) {
+                EyesLEDBrightness[pos] = min(EyesLEDBrightness[pos] + steps, (int)ledBrightness);
+            }
         } else {
             DJLEDs_Eyes[pos].maximizeBrightness(EyesLEDBrightness[pos]);
-            if (EyesLEDBrightness[pos] > EyesLEDMinBrightness[pos]) EyesLEDBrightness[pos]--;
+            if (EyesLEDBrightness[pos] > EyesLEDMinBrightness[pos]) {
+                EyesLEDBrightness[pos] = max(EyesLEDBrightness[pos] - steps, (int)EyesLEDMinBrightness[pos]);
+            }
         }
         
-        if (millis() - EyesLEDMillis[pos] > EyesIntervalTime[pos]) {
+        if (frame.now - EyesLEDMillis[pos] > EyesIntervalTime[pos]) {
             if (!EyesLEDOn[pos]) {
                 DJLEDs_Eyes[pos] = eyeColors[pos]; // Use the color determined by eyeMode
 
@@ -87,16 +122,17 @@ void updateEyes() {
                 DJLEDs_Eyes[pos].b = min(255, (DJLEDs_Eyes[pos].b * eyeBrightness) / 100);
                 
                 EyesIntervalTime[pos] = random(eyeFlickerMinTime, eyeFlickerMaxTime);
-                EyesLEDMillis[pos] = millis();
+                EyesLEDMillis[pos] = frame.now;
                 EyesLEDOn[pos] = 1;
                 EyesLEDMinBrightness[pos] = random(ledBrightness * 0.2, ledBrightness);
             } else {
                 EyesIntervalTime[pos] = random(eyeFlickerMinTime, eyeFlickerMaxTime + 400);
-                EyesLEDMillis[pos] = millis();
+                EyesLEDMillis[pos] = frame.now;
                 EyesLEDOn[pos] = 0;
             }
         }
     }
+    applyEyeAudio();
 }
 
 // NEW: Function to print current eye flicker settings
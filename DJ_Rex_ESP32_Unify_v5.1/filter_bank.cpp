@@ -0,0 +1,155 @@
+// filter_bank.cpp - v5.2 Fixed-Point Biquad Filter Bank
+#include "filter_bank.h"
+#include <math.h>
+
+FilterBank filterBank;
+
+enum BiquadType { BIQUAD_LOWPASS, BIQUAD_BANDPASS, BIQUAD_HIGHPASS };
+
+static int16_t toQ14(float value) {
+    return (int16_t)lroundf(value * 16384.0f);
+}
+
+void FilterBank::begin() {
+    // Log-spaced band edges between FILTER_BANK_MIN_HZ and FILTER_BANK_MAX_HZ
+    float ratio = powf((float)FILTER_BANK_MAX_HZ / FILTER_BANK_MIN_HZ, 1.0f / FILTER_BANK_BANDS);
+    for (uint8_t b = 0; b <= FILTER_BANK_BANDS; b++) {
+        bandEdgeHz[b] = (uint16_t)(FILTER_BANK_MIN_HZ * powf(ratio, b) + 0.5f);
+    }
+
+    for (uint8_t b = 0; b < FILTER_BANK_BANDS; b++) {
+        // RBJ cookbook biquads: the outer bands are Butterworth low/high-pass at
+        // the inner edge, the others band-pass (0 dB peak) across their edges
+        BiquadType type = (b == 0) ? BIQUAD_LOWPASS : (b == FILTER_BANK_BANDS - 1) ? BIQUAD_HIGHPASS : BIQUAD_BANDPASS;
+        float frequency, q;
+        if (type == BIQUAD_LOWPASS) {
+            frequency = bandEdgeHz[1];
+            q = 0.7071f;
+        } else if (type == BIQUAD_HIGHPASS) {
+            frequency = bandEdgeHz[FILTER_BANK_BANDS - 1];
+            q = 0.7071f;
+        } else {
+            frequency = sqrtf((float)bandEdgeHz[b] * bandEdgeHz[b + 1]);
+            q = frequency / (bandEdgeHz[b + 1] - bandEdgeHz[b]);
+        }
+
+        float w0 = 2.0f * (float)M_PI * frequency / ADC_DMA_SAMPLE_RATE;
+        float cosW0 = cosf(w0);
+        float alpha = sinf(w0) / (2.0f * q);
+        float a0 = 1.0f + alpha;
+        float b0, b1, b2;
+        if (type == BIQUAD_LOWPASS) {
+            b0 = (1.0f - cosW0) / 2.0f;
+            b1 = 1.0f - cosW0;
+            b2 = b0;
+        } else if (type == BIQUAD_HIGHPASS) {
+            b0 = (1.0f + cosW0) / 2.0f;
+            b1 = -(1.0f + cosW0);
+            b2 = b0;
+        } else {
+            b0 = alpha;
+            b1 = 0.0f;
+            b2 = -alpha;
+        }
+
+        Biquad& filter = filters[b];
+        filter.b0 = toQ14(b0 / a0);
+        filter.b1 = toQ14(b1 / a0);
+        filter.b2 = toQ14(b2 / a0);
+        filter.a1 = toQ14(-2.0f * cosW0 / a0);
+        filter.a2 = toQ14((1.0f - alpha) / a0);
+    }
+    reset();
+}
+
+void FilterBank::reset() {
+    x1 = 0;
+    x2 = 0;
+    for (uint8_t b = 0; b < FILTER_BANK_BANDS; b++) {
+        filters[b].y1 = 0;
+        filters[b].y2 = 0;
+        envelopeQ8[b] = 0;
+    }
+}
+
+void FilterBank::processSample(int sample) {
+    // 14-bit input keeps every sum below 2^31 with Q14 coefficients
+    int32_t x = constrain(sample, -2048, 2047) * (1 << FILTER_INPUT_SHIFT);
+
+    for (uint8_t b = 0; b < FILTER_BANK_BANDS; b++) {
+        Biquad& f = filters[b];
+        int32_t y = (f.b0 * x + f.b1 * x1 + f.b2 * x2 - f.a1 * f.y1 - f.a2 * f.y2) >> 14;
+        f.y2 = f.y1;
+        f.y1 = y;
+
+        // Rectified envelope: fast attack, slow release
+        uint32_t target = (uint32_t)abs(y) << 8;
+        uint32_t envelope = envelopeQ8[b];
+        if (target > envelope) {
+            envelope += (target - envelope) >> FILTER_ATTACK_SHIFT;
+        } else {
+            envelope -= (envelope - target) >> FILTER_RELEASE_SHIFT;
+        }
+        envelopeQ8[b] = envelope;
+    }
+    x2 = x1;
+    x1 = x;
+}
+
+void FilterBank::runBenchmark(uint32_t samples) {
+    FilterBank bank;
+    bank.begin();
+
+    Serial.println(F("=== Filter Bank Benchmark ==="));
+    Serial.print(FILTER_BANK_BANDS);
+    Serial.print(F(" biquads @ "));
+    Serial.print(ADC_DMA_SAMPLE_RATE);
+    Serial.println(F(" Hz"));
+
+    // Response to a +-1000 count tone at each band's center (rows) per band (columns)
+    Serial.println(F("Tone response (envelope per band):"));
+    for (uint8_t t = 0; t < FILTER_BANK_BANDS; t++) {
+        uint16_t hz = (t == 0) ? bank.bandEdgeHz[0] * 2 :
+                      (t == FILTER_BANK_BANDS - 1) ? bank.bandEdgeHz[FILTER_BANK_BANDS] :
+                      (uint16_t)sqrtf((float)bank.bandEdgeHz[t] * bank.bandEdgeHz[t + 1]);
+        uint16_t step = (uint32_t)hz * 65536UL / ADC_DMA_SAMPLE_RATE;
+        uint16_t phase = 0;
+
+        bank.reset();
+        for (uint16_t i = 0; i < ADC_DMA_SAMPLE_RATE / 2; i++) {  // 0.5s settles every envelope
+            bank.processSample(((int32_t)sin16(phase) * 1000) >> 15);
+            phase += step;
+        }
+
+        Serial.print(F("  "));
+        Serial.print(hz);
+        Serial.print(F(" Hz:"));
+        for (uint8_t b = 0; b < FILTER_BANK_BANDS; b++) {
+            Serial.print(' ');
+            Serial.print(bank.getEnvelope(b));
+        }
+        Serial.println();
+    }
+
+    // Cost on broadband input
+    bank.reset();
+    uint16_t noise = 1;
+    uint32_t startCycles = ESP.getCycleCount();
+    for (uint32_t i = 0; i < samples; i++) {
+        noise = noise * 2053 + 13849;
+        bank.processSample((int16_t)noise >> 4);
+    }
+    uint32_t cycles = ESP.getCycleCount() - startCycles;
+
+    uint32_t perSample = cycles / samples;
+    Serial.print(F("Cost: "));
+    Serial.print(perSample);
+    Serial.print(F(" cycles/sample, "));
+    // Share of one core at the ADC sample rate, in 0.1%
+    uint32_t permille = (uint64_t)perSample * ADC_DMA_SAMPLE_RATE * 1000 / (ESP.getCpuFreqMHz() * 1000000UL);
+    Serial.print(permille / 10);
+    Serial.print(F("."));
+    Serial.print(permille % 10);
+    Serial.println(F("% CPU"));
+    Serial.println(F("============================="));
+}
@@ -0,0 +1,43 @@
+// filter_bank.h - v5.2 Fixed-Point Biquad Filter Bank
+#ifndef FILTER_BANK_H
+#define FILTER_BANK_H
+
+#include "config.h"
+
+static_assert(FILTER_BANK_BANDS >= 3 && FILTER_BANK_BANDS <= 6, "FILTER_BANK_BANDS must be 3-6");
+
+// FILTER_BANK_BANDS Q14 biquads (Direct Form I, shared input history) fed
+// with every DC-free ADC sample from AdcStream::processSample(). Each band
+// keeps a rectified attack/release envelope; updateAudio() publishes them as
+// the bass/mid/treble levels of the frame's AudioFeatures.
+class FilterBank {
+public:
+    void begin();   // Computes the coefficients (float, once)
+    void reset();   // Clears filter and envelope state
+
+    void processSample(int sample);
+
+    // Envelope of one band in ADC counts (follows the amplitude peaks)
+    uint16_t getEnvelope(uint8_t band) const {
+        return envelopeQ8[band] >> (8 + FILTER_INPUT_SHIFT);
+    }
+    uint16_t getBandLowHz(uint8_t band) const { return bandEdgeHz[band]; }
+
+    // Tone response per band and cycles per sample on this chip
+    static void runBenchmark(uint32_t samples);
+
+private:
+    struct Biquad {
+        int16_t b0, b1, b2, a1, a2;  // Q14, a0 normalized to 1
+        int32_t y1, y2;
+    };
+
+    Biquad filters[FILTER_BANK_BANDS];
+    int32_t x1 = 0, x2 = 0;
+    volatile uint32_t envelopeQ8[FILTER_BANK_BANDS] = {};
+    uint16_t bandEdgeHz[FILTER_BANK_BANDS + 1];
+};
+
+extern FilterBank filterBank;
+
+#endif
@@ -0,0 +1,114 @@
+// frame_profiler.cpp - v5.2 Per-Stage Frame Profiler
+#include "frame_profiler.h"
+
+#if ENABLE_FRAME_PROFILER
+
+#include "globals.h"
+
+FrameProfiler frameProfiler;
+
+static const char* const stageNames[NUM_PERF_STAGES] = {
+    "Body Pattern",
+    "Eyes",
+    "Mouth",
+    "Transition",
+    "LED Show",
+    "Serial Command"
+};
+
+void FrameProfiler::begin() {
+    reset();
+    Serial.println(F("Frame Profiler initialized"));
+}
+
+uint8_t FrameProfiler::bucketFor(uint32_t cycles) {
+    uint8_t bits = 0;
+    while (cycles > 0) {
+        bits++;
+        cycles >>= 1;
+    }
+    if (bits <= PERF_HISTOGRAM_MIN_SHIFT) return 0;
+    uint8_t bucket = bits - PERF_HISTOGRAM_MIN_SHIFT;
+    return bucket < PERF_HISTOGRAM_BUCKETS ? bucket : PERF_HISTOGRAM_BUCKETS - 1;
+}
+
+void FrameProfiler::record(uint8_t stage, uint8_t pattern, uint32_t cycles) {
+    if (stage >= NUM_PERF_STAGES || pattern >= NUM_PATTERNS) return;
+
+    StageStats& s = stats[stage][pattern];
+    if (s.count == 0 || cycles < s.minCycles) s.minCycles = cycles;
+    if (cycles > s.maxCycles) s.maxCycles = cycles;
+    s.sumCycles += cycles;
+    s.count++;
+
+    uint8_t bucket = bucketFor(cycles);
+    if (s.histogram[bucket] < 0xFFFF) {
+        s.histogram[bucket]++;
+    }
+}
+
+void FrameProfiler::reset() {
+    memset(stats, 0, sizeof(stats));
+}
+
+void FrameProfiler::printStats(const StageStats& s) {
+    uint32_t cyclesPerUs = ESP.getCpuFreqMHz();
+
+    Serial.print(s.count);
+    Serial.print(F("x  min "));
+    Serial.print(s.minCycles / cyclesPerUs);
+    Serial.print(F(" / avg "));
+    Serial.print((uint32_t)(s.sumCycles / s.count) / cyclesPerUs);
+    Serial.print(F(" / max "));
+    Serial.print(s.maxCycles / cyclesPerUs);
+    Serial.print(F(" us  |"));
+
+    // Only print the populated range of buckets
+    int8_t first = -1, last = -1;
+    for (uint8_t b = 0; b < PERF_HISTOGRAM_BUCKETS; b++) {
+        if (s.histogram[b] > 0) {
+            if (first < 0) first = b;
+            last = b;
+        }
+    }
+    for (int8_t b = first; b >= 0 && b <= last; b++) {
+        Serial.print(' ');
+        Serial.print(s.histogram[b]);
+    }
+    Serial.print(F(" |  first bucket <"));
+    Serial.print((1UL << (PERF_HISTOGRAM_MIN_SHIFT + (first > 0 ? first : 0))) / cyclesPerUs);
+    Serial.println(F("us"));
+}
+
+void FrameProfiler::printStatus() {
+    Serial.println(F("=== Frame Profiler ==="));
+    Serial.print(F("CPU: "));
+    Serial.print(ESP.getCpuFreqMHz());
+    Serial.println(F(" MHz, histogram buckets double per step"));
+
+    for (uint8_t stage = 0; stage < NUM_PERF_STAGES; stage++) {
+        Serial.print(stageNames[stage]);
+        Serial.println(F(":"));
+
+        bool any = false;
+        for (uint8_t pattern = 0; pattern < NUM_PATTERNS; pattern++) {
+            const StageStats& s = stats[stage][pattern];
+            if (s.count == 0) continue;
+
+            any = true;
+            Serial.print(F("  "));
+            if (pattern < 10) Serial.print(' ');
+            Serial.print(pattern);
+            Serial.print(F(" "));
+            Serial.print(bodyPatterns[pattern].name);
+            Serial.print(F(": "));
+            printStats(s);
+        }
+        if (!any) {
+            Serial.println(F("  (no samples)"));
+        }
+    }
+    Serial.println(F("======================"));
+}
+
+#endif
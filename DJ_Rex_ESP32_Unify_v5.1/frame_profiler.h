@@ -0,0 +1,59 @@
+// frame_profiler.h - v5.2 Per-Stage Frame Profiler
+#ifndef FRAME_PROFILER_H
+#define FRAME_PROFILER_H
+
+#include "config.h"
+#include "pattern_registry.h"
+
+// Profiled stages of a frame
+enum PerfStage {
+    PERF_BODY_PATTERN = 0,
+    PERF_EYES,
+    PERF_MOUTH,
+    PERF_TRANSITION,
+    PERF_LED_SHOW,
+    PERF_SERIAL_COMMAND,
+    NUM_PERF_STAGES
+};
+
+#if ENABLE_FRAME_PROFILER
+
+#include <Arduino.h>
+
+class FrameProfiler {
+public:
+    void begin();
+    // Add one measurement (in CPU cycles) of a stage while a pattern is active
+    void record(uint8_t stage, uint8_t pattern, uint32_t cycles);
+    void reset();
+    void printStatus();
+
+private:
+    struct StageStats {
+        uint32_t count;
+        uint32_t minCycles;
+        uint32_t maxCycles;
+        uint64_t sumCycles;
+        uint16_t histogram[PERF_HISTOGRAM_BUCKETS];  // log2 buckets, saturating
+    };
+
+    StageStats stats[NUM_PERF_STAGES][NUM_PATTERNS];
+
+    static uint8_t bucketFor(uint32_t cycles);
+    void printStats(const StageStats& s);
+};
+
+extern FrameProfiler frameProfiler;
+
+// Time the code between PERF_BEGIN and PERF_END (same scope) for the current pattern
+#define PERF_BEGIN(stage) uint32_t perfStart_##stage = ESP.getCycleCount()
+#define PERF_END(stage) frameProfiler.record(stage, currentPattern, ESP.getCycleCount() - perfStart_##stage)
+
+#else
+
+#define PERF_BEGIN(stage)
+#define PERF_END(stage)
+
+#endif
+
+#endif
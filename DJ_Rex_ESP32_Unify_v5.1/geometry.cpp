@@ -0,0 +1,20 @@
+// geometry.cpp - v5.2 Physical LED Geometry & Coordinate Rendering
+#include "geometry.h"
+#include <math.h>
+
+LedPixel ledPixels[NUM_TOTAL_LEDS];
+
+void initializeGeometry() {
+    for (uint8_t i = 0; i < NUM_TOTAL_LEDS; i++) {
+        const LedPoint& point = ledGeometry.points[i];
+        int16_t dx = (int16_t)point.x - GEO_CENTER_X;
+        int16_t dy = (int16_t)point.y - GEO_CENTER_Y;
+
+        ledPixels[i].x = point.x;
+        ledPixels[i].y = point.y;
+        ledPixels[i].row = point.row;
+        ledPixels[i].col = point.col;
+        ledPixels[i].radius = sqrt16((uint16_t)(dx * dx + dy * dy));
+        ledPixels[i].angle = (uint8_t)(int16_t)(atan2f(dy, dx) * (128.0f / (float)M_PI));
+    }
+}
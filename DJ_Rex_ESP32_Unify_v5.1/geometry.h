@@ -0,0 +1,143 @@
+// geometry.h - v5.2 Physical LED Geometry & Coordinate Rendering
+// Every index of the flat frame buffer (allLEDs) has a fixed position on
+// the droid, seen from the front: x = 0 (left) .. 255 (right),
+// y = 0 (top of the head) .. 255 (bottom of the body panels).
+//
+//   Eyes       y  16             Eye 2 (x 104)   Eye 1 (x 152)
+//   Mouth      y  36 .. 124      12 rows, centered on x 128, 8 units apart
+//   Side LEDs  y 152             8 per panel, 9 units apart
+//   Blocks     y 196 / 212       3 blocks of 2x2 per panel
+//   Panels     Left x 8..80, Middle x 92..164, Right x 176..248
+//
+// Assumed wiring: side LEDs and mouth rows left to right, block LEDs row by row.
+#ifndef GEOMETRY_H
+#define GEOMETRY_H
+
+#include "config.h"
+#include "globals.h"
+
+// Zones of the flat frame buffer (bit mask for renderCoordinates)
+enum LedZone {
+    ZONE_BODY  = 0x01,
+    ZONE_EYES  = 0x02,
+    ZONE_MOUTH = 0x04,
+    ZONE_ALL   = 0x07
+};
+
+#define ZONE_BODY_START 0
+#define ZONE_EYES_START TOTAL_BODY_LEDS
+#define ZONE_MOUTH_START (TOTAL_BODY_LEDS + NUM_EYES)
+
+struct LedPoint {
+    uint8_t x;
+    uint8_t y;
+    uint8_t row;  // Grid row within the zone (body: 0 = sides, 1-2 = blocks; mouth: 0-11)
+    uint8_t col;  // Grid column within the zone (body: 0-23 across all panels; mouth: 0-7)
+};
+
+// ---------------------------------------------------------------------------
+// Compile-time coordinate table
+// ---------------------------------------------------------------------------
+
+#define GEO_CENTER_X 128
+#define GEO_CENTER_Y 128
+#define GEO_PANEL_WIDTH 72
+#define GEO_PANEL_GAP 12
+#define GEO_SIDE_Y 152
+#define GEO_BLOCK_Y 196
+#define GEO_EYES_Y 16
+#define GEO_MOUTH_Y 36
+#define GEO_MOUTH_PITCH 8
+
+constexpr LedPoint bodyLedPoint(uint8_t panel, uint8_t pos) {
+    // Panels are stored Right, Middle, Left - the Left panel is leftmost
+    uint8_t column = 2 - panel;
+    uint8_t originX = 8 + column * (GEO_PANEL_WIDTH + GEO_PANEL_GAP);
+
+    if (pos < SIDE_LEDS_COUNT) {
+        return {(uint8_t)(originX + 4 + pos * 9), GEO_SIDE_Y, 0, (uint8_t)(column * SIDE_LEDS_COUNT + pos)};
+    }
+
+    uint8_t block = (pos - SIDE_LEDS_COUNT) / LEDS_PER_BLOCK;
+    uint8_t led = (pos - SIDE_LEDS_COUNT) % LEDS_PER_BLOCK;
+    uint8_t blockCol = column * 6 + block * 2 + (led % 2);
+    return {(uint8_t)(originX + 8 + block * 24 + (led % 2) * 16), (uint8_t)(GEO_BLOCK_Y + (led / 2) * 16),
+            (uint8_t)(1 + led / 2), blockCol};
+}
+
+constexpr LedPoint mouthLedPoint(uint8_t index) {
+    uint8_t row = 0;
+    while (row + 1 < MOUTH_ROWS && index >= mouthRowStart[row + 1]) {
+        row++;
+    }
+    uint8_t ledInRow = index - mouthRowStart[row];
+    uint8_t count = mouthRowLeds[row];
+    // Rows are centered: shorter rows start further in
+    uint8_t col = (8 - count) / 2 + ledInRow;
+    return {(uint8_t)(GEO_CENTER_X - 28 + col * GEO_MOUTH_PITCH), (uint8_t)(GEO_MOUTH_Y + row * GEO_MOUTH_PITCH), row, col};
+}
+
+struct GeometryTable {
+    LedPoint points[NUM_TOTAL_LEDS];
+};
+
+constexpr GeometryTable buildGeometry() {
+    GeometryTable table = {};
+    for (uint8_t i = 0; i < TOTAL_BODY_LEDS; i++) {
+        table.points[ZONE_BODY_START + i] = bodyLedPoint(i / NUM_LEDS_PER_PANEL, i % NUM_LEDS_PER_PANEL);
+    }
+    // Eye 1 (index 0) is the droid's right eye, on the right as seen from the front
+    table.points[ZONE_EYES_START] = {152, GEO_EYES_Y, 0, 1};
+    table.points[ZONE_EYES_START + 1] = {104, GEO_EYES_Y, 0, 0};
+    for (uint8_t i = 0; i < NUM_MOUTH_LEDS; i++) {
+        table.points[ZONE_MOUTH_START + i] = mouthLedPoint(i);
+    }
+    return table;
+}
+
+inline constexpr GeometryTable ledGeometry = buildGeometry();
+
+static_assert(ledGeometry.points[ZONE_MOUTH_START + NUM_MOUTH_LEDS - 1].row == MOUTH_ROWS - 1,
+              "Mouth row table does not cover all mouth LEDs");
+
+// ---------------------------------------------------------------------------
+// Runtime cache of derived per-pixel values
+// ---------------------------------------------------------------------------
+
+struct LedPixel {
+    uint8_t x;
+    uint8_t y;
+    uint8_t row;
+    uint8_t col;
+    uint8_t radius;  // Distance from the droid center (GEO_CENTER_X/Y)
+    uint8_t angle;   // Angle around the droid center, 0-255 = full turn
+};
+
+extern LedPixel ledPixels[NUM_TOTAL_LEDS];
+
+// Fill the per-pixel cache (call once at startup)
+void initializeGeometry();
+
+// Evaluate shader(pixel) for every LED of the selected zones in one pass over
+// the current render target (renderLEDs). Inlined, so a lambda shader costs
+// no call per LED.
+template <typename Shader>
+inline void renderCoordinates(uint8_t zones, Shader shader) {
+    if (zones & ZONE_BODY) {
+        for (uint8_t i = ZONE_BODY_START; i < ZONE_EYES_START; i++) {
+            renderLEDs[i] = shader(ledPixels[i]);
+        }
+    }
+    if (zones & ZONE_EYES) {
+        for (uint8_t i = ZONE_EYES_START; i < ZONE_MOUTH_START; i++) {
+            renderLEDs[i] = shader(ledPixels[i]);
+        }
+    }
+    if (zones & ZONE_MOUTH) {
+        for (uint8_t i = ZONE_MOUTH_START; i < NUM_TOTAL_LEDS; i++) {
+            renderLEDs[i] = shader(ledPixels[i]);
+        }
+    }
+}
+
+#endif
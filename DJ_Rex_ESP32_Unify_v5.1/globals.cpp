@@ -19,6 +19,15 @@ uint8_t confettiColor2 = 3;
 uint8_t eyeColorIndex = 14;
 uint8_t solidMode = 0;
 
+// v5.2: Render task frame rate
+uint8_t targetFPS = FRAMES_PER_SECOND;
+uint16_t timeScale = TIME_SCALE_DEFAULT;
+volatile bool renderPaused = false;
+
+// v5.2: Default transition
+uint8_t transitionMode = TRANSITION_FADE;
+uint16_t transitionDuration = TRANSITION_DURATION_MS;
+
 // Brightness controls
 uint8_t eyeBrightness = 125;
 uint8_t bodyBrightness = 100;
@@ -52,19 +61,7 @@ uint8_t knightColorIndex = 0;
 uint8_t breathingColorIndex = 2;
 uint8_t matrixColorIndex = 11;
 uint8_t strobeColorIndex = 3;
-uint8_t knightPos = 0;
-bool knightDir = true;
-uint8_t breathingBright = 0;
-bool breathingUp = true;
-bool strobeState = false;
-unsigned long knightMillis = 0;
-unsigned long breathingMillis = 0;
-unsigned long matrixMillis = 0;
-unsigned long strobeMillis = 0;
-uint16_t knightInterval = 100;
-uint16_t strobeInterval = 100;
-uint8_t matrixDrops[3][8];
-uint8_t matrixBright[3][8];
+// v5.2: Pattern animation state lives in the pattern arena (pattern_arena.h)
 
 // Mouth parameters
 uint8_t mouthPattern = 1;
@@ -81,8 +78,6 @@ uint8_t pulseSpeed = 5;
 // Flash pattern
 uint8_t flashColorIndex = 0;
 uint8_t flashSpeed = 5;
-bool flashState = false;
-unsigned long lastFlashTime = 0;
 
 // Short Circuit
 uint8_t shortColorIndex = 3;
@@ -106,34 +101,34 @@ volatile uint8_t audioSampleIdx = 0;
 uint8_t audioMode = AUDIO_ALL;
 uint8_t audioSensitivity = 5;
 bool audioAutoGain = true;
-volatile int audioMinLevel = 4095;
-volatile int audioMaxLevel = 0;
 
 // v5.1: Audio input mode
 uint8_t audioInputMode = INPUT_MIC;
 
-// Timing arrays
-uint16_t IntervalTime[TOTAL_BODY_LEDS];
-unsigned long LEDMillis[TOTAL_BODY_LEDS];
-bool LEDOn[TOTAL_BODY_LEDS];
-
 // LED arrays
-CRGB DJLEDs_Right[NUM_LEDS_PER_PANEL];
-CRGB DJLEDs_Middle[NUM_LEDS_PER_PANEL];
-CRGB DJLEDs_Left[NUM_LEDS_PER_PANEL];
-CRGB DJLEDs_Eyes[NUM_EYES];
-CRGB DJLEDs_Mouth[NUM_MOUTH_LEDS];
-
-//Arrays for transition state
-CRGB old_DJLEDs_Right[NUM_LEDS_PER_PANEL];
-CRGB old_DJLEDs_Middle[NUM_LEDS_PER_PANEL];
-CRGB old_DJLEDs_Left[NUM_LEDS_PER_PANEL];
-CRGB old_DJLEDs_Eyes[NUM_EYES];
-CRGB old_DJLEDs_Mouth[NUM_MOUTH_LEDS];
+// v5.2: One flat frame buffer - body panels first, then the eyes+mouth chain
+// (eyes = chain LEDs 0-1, mouth = chain LEDs 2-81)
+CRGB allLEDs[NUM_TOTAL_LEDS];
+CRGB* const eyesMouthLEDs = &allLEDs[TOTAL_BODY_LEDS];
+
+// v5.2: Render target views (retargeted by the transition engine)
+CRGB* renderLEDs = allLEDs;
+CRGB* DJLEDs_Right = &allLEDs[0];
+CRGB* DJLEDs_Middle = &allLEDs[NUM_LEDS_PER_PANEL];
+CRGB* DJLEDs_Left = &allLEDs[2 * NUM_LEDS_PER_PANEL];
+CRGB* DJLEDs_Eyes = &allLEDs[TOTAL_BODY_LEDS];
+CRGB* DJLEDs_Mouth = &allLEDs[TOTAL_BODY_LEDS + NUM_EYES];
+
+void setRenderTarget(CRGB* frame) {
+    renderLEDs = frame;
+    DJLEDs_Right = &frame[0];
+    DJLEDs_Middle = &frame[NUM_LEDS_PER_PANEL];
+    DJLEDs_Left = &frame[2 * NUM_LEDS_PER_PANEL];
+    DJLEDs_Eyes = &frame[TOTAL_BODY_LEDS];
+    DJLEDs_Mouth = &frame[TOTAL_BODY_LEDS + NUM_EYES];
+}
 
 //Transition control variables
-bool transitionActive = false;
-unsigned long transitionStartTime = 0;
 int8_t requestedPattern = -1; // -1 means no request
 
 // Eyes variables
@@ -147,9 +142,6 @@ uint8_t EyesLEDMinBrightness[NUM_EYES];
 uint8_t gHue = 0;
 uint8_t gSat = 0;
 bool updown = 0;
-unsigned long FadeMillis = 0;
-uint16_t DecayTime = DECAYTIME;
-uint16_t FadeInterval = 0;
 
 // Playlist-Definition und Initialisierung
 PlaylistEntry playlist[10] = {
@@ -163,10 +155,6 @@ bool playlistActive = false; // Playlist ist standardmäßig aus
 uint8_t playlistIndex = 0;
 unsigned long playlistPatternStartTime = 0;
 
-// Mouth layout
-const uint8_t mouthRowLeds[MOUTH_ROWS] = {8, 8, 8, 8, 8, 8, 8, 8, 6, 4, 4, 2};
-const uint8_t mouthRowStart[MOUTH_ROWS] = {0, 8, 16, 24, 32, 40, 48, 56, 64, 70, 74, 78};
-
 // Extended color palette
 const CRGB StandardColors[NUM_STANDARD_COLORS] = {
     CRGB::Red, CRGB::Green, CRGB::Blue, CRGB(255, 230, 240), CRGB(255, 180, 0), CRGB::Cyan, CRGB::Magenta,
@@ -184,12 +172,6 @@ const char* SideColorModeNames[5] = {
     "Random from 3", "Cycle through 3", "Color 1 only", "Color 2 only", "Color 3 only"
 };
 
-const char* MouthPatternNames[NUM_MOUTH_PATTERNS] = {
-    "Off", "Talk", "Smile", "Audio Reactive", "Rainbow", "Debug",
-    "Wave", "Pulse", "VU Meter Horiz", "VU Meter Vert", "Frown", "Sparkle",
-    "Matrix", "Heartbeat", "Spectrum"  // v5.0 new patterns
-};
-
 const char* EyeModeNames[3] = {
     "Single Color", "Dual Color", "Alternating"
 };
@@ -198,8 +180,8 @@ const char* MouthSplitNames[5] = {
     "Off", "Vertical", "Horizontal", "Inner/Outer", "Random"
 };
 
-const char* AudioModeNames[5] = {
-    "Off", "Mouth Only", "Body Sides Only", "Body All", "Everything"
+const char* AudioModeNames[NUM_AUDIO_MODES] = {
+    "Off", "Mouth Only", "Body Sides Only", "Body All", "Everything", "Band Split", "Custom"
 };
 
 // v5.1: Audio input mode names
@@ -207,12 +189,5 @@ const char* AudioInputModeNames[2] = {
     "Microphone", "Line-In"
 };
 
-const char* patternNames[NUM_PATTERNS] = {
-    "LEDs Off", "Random Blocks", "Solid Color", "Short Circuit", "Confetti Red/White", "Rainbow", "Rainbow with Glitter",
-    "Confetti", "Juggle", "Audio Sync", "Solid Flash", "Knight Rider", "Breathing", "Matrix Rain", "Strobe",
-    "Audio VU Meter", "Custom Block Sequence",
-    "Plasma", "Fire", "Twinkle"  // v5.0 new patterns
-};
-
 // v5.0: Startup sequence control
 bool startupSequenceEnabled = STARTUP_SEQUENCE_ENABLED;
\ No newline at end of file
@@ -1,9 +1,9 @@
 #ifndef GLOBALS_H
 #define GLOBALS_H
 
+#include "config.h"
 #include <FastLED.h>
 #include <Preferences.h>
-#include "config.h"
 
 // Settings storage
 extern Preferences preferences;
@@ -24,6 +24,19 @@ extern uint8_t confettiColor2;
 extern uint8_t eyeColorIndex;
 extern uint8_t solidMode;
 
+// v5.2: Render task frame rate (frames per second)
+extern uint8_t targetFPS;
+
+// v5.2: Set while a long console command owns the LEDs; the render task idles
+extern volatile bool renderPaused;
+
+// v5.2: Animation speed in % of real time (patterns, eyes, mouth)
+extern uint16_t timeScale;
+
+// v5.2: Transition used for pattern changes (playlist entries can override it)
+extern uint8_t transitionMode;
+extern uint16_t transitionDuration;  // ms, 0 = cut
+
 // Brightness controls
 extern uint8_t eyeBrightness;
 extern uint8_t bodyBrightness;
@@ -57,19 +70,7 @@ extern uint8_t knightColorIndex;
 extern uint8_t breathingColorIndex;
 extern uint8_t matrixColorIndex;
 extern uint8_t strobeColorIndex;
-extern uint8_t knightPos;
-extern bool knightDir;
-extern uint8_t breathingBright;
-extern bool breathingUp;
-extern bool strobeState;
-extern unsigned long knightMillis;
-extern unsigned long breathingMillis;
-extern unsigned long matrixMillis;
-extern unsigned long strobeMillis;
-extern uint16_t knightInterval;
-extern uint16_t strobeInterval;
-extern uint8_t matrixDrops[3][8];
-extern uint8_t matrixBright[3][8];
+// v5.2: Pattern animation state lives in the pattern arena (pattern_arena.h)
 
 // Mouth-specific parameters
 extern uint8_t mouthPattern;
@@ -86,8 +87,6 @@ extern uint8_t pulseSpeed;       // NEU
 // Solid Flash pattern variables
 extern uint8_t flashColorIndex;
 extern uint8_t flashSpeed;
-extern bool flashState;
-extern unsigned long lastFlashTime;
 
 // Short Circuit pattern variables
 extern uint8_t shortColorIndex;
@@ -126,44 +125,33 @@ extern volatile uint8_t audioSampleIdx;
 extern uint8_t audioMode;
 extern uint8_t audioSensitivity;
 extern bool audioAutoGain;
-extern volatile int audioMinLevel;
-extern volatile int audioMaxLevel;
 
 // v5.1: Audio input mode (Microphone or Line-In)
 extern uint8_t audioInputMode;
 
-// Timing arrays
-extern uint16_t IntervalTime[TOTAL_BODY_LEDS];
-extern unsigned long LEDMillis[TOTAL_BODY_LEDS];
-extern bool LEDOn[TOTAL_BODY_LEDS];
-
 // LED arrays
-extern CRGB DJLEDs_Right[NUM_LEDS_PER_PANEL];
-extern CRGB DJLEDs_Middle[NUM_LEDS_PER_PANEL];
-extern CRGB DJLEDs_Left[NUM_LEDS_PER_PANEL];
-extern CRGB DJLEDs_Eyes[NUM_EYES];
-extern CRGB DJLEDs_Mouth[NUM_MOUTH_LEDS];
+// v5.2: All 142 LEDs live in one flat frame buffer (see geometry.h for the
+// physical position of every index). The eyes+mouth chain is contiguous,
+// so eyesMouthLEDs is exactly what is sent on EYES_MOUTH_PIN.
+extern CRGB allLEDs[NUM_TOTAL_LEDS];
+extern CRGB* const eyesMouthLEDs;  // allLEDs[60 .. 141]
+
+// v5.2: Patterns render through these views of the current render target.
+// Outside a transition the target is allLEDs; during one, the transition
+// engine points them at the scratch frame of the pattern being rendered.
+extern CRGB* renderLEDs;     // Whole target, indexed like allLEDs
+extern CRGB* DJLEDs_Right;   // renderLEDs[0 .. 19]
+extern CRGB* DJLEDs_Middle;  // renderLEDs[20 .. 39]
+extern CRGB* DJLEDs_Left;    // renderLEDs[40 .. 59]
+extern CRGB* DJLEDs_Eyes;    // renderLEDs[60 .. 61]
+extern CRGB* DJLEDs_Mouth;   // renderLEDs[62 .. 141]
+
+void setRenderTarget(CRGB* frame);
 
 // ...
-// LED arrays
-extern CRGB DJLEDs_Right[NUM_LEDS_PER_PANEL];
-extern CRGB DJLEDs_Middle[NUM_LEDS_PER_PANEL];
-extern CRGB DJLEDs_Left[NUM_LEDS_PER_PANEL];
-extern CRGB DJLEDs_Eyes[NUM_EYES];
-extern CRGB DJLEDs_Mouth[NUM_MOUTH_LEDS];
-
-//Arrays to store the state of the old pattern for transitions
-extern CRGB old_DJLEDs_Right[NUM_LEDS_PER_PANEL];
-extern CRGB old_DJLEDs_Middle[NUM_LEDS_PER_PANEL];
-extern CRGB old_DJLEDs_Left[NUM_LEDS_PER_PANEL];
-extern CRGB old_DJLEDs_Eyes[NUM_EYES];
-extern CRGB old_DJLEDs_Mouth[NUM_MOUTH_LEDS];
-
 //Transition control variables
-extern bool transitionActive;
-extern unsigned long transitionStartTime;
+// v5.2: Transition state lives in the TransitionEngine (transition.h)
 extern int8_t requestedPattern; // Used to trigger a transition from serial commands
-const uint16_t transitionDuration = 1000; // Define const here to make it visible everywhere
 
 // Eyes variables
 extern uint16_t EyesIntervalTime[NUM_EYES];
@@ -176,30 +164,27 @@ extern uint8_t EyesLEDMinBrightness[NUM_EYES];
 extern uint8_t gHue;
 extern uint8_t gSat;
 extern bool updown;
-extern unsigned long FadeMillis;
-extern uint16_t DecayTime;
-extern uint16_t FadeInterval;
 
-// Mouth constants
-extern const uint8_t mouthRowLeds[MOUTH_ROWS];
-extern const uint8_t mouthRowStart[MOUTH_ROWS];
+// Mouth constants (v5.2: constexpr so the geometry table can be built at compile time)
+inline constexpr uint8_t mouthRowLeds[MOUTH_ROWS] = {8, 8, 8, 8, 8, 8, 8, 8, 6, 4, 4, 2};
+inline constexpr uint8_t mouthRowStart[MOUTH_ROWS] = {0, 8, 16, 24, 32, 40, 48, 56, 64, 70, 74, 78};
 
 // Color constants
 extern const CRGB StandardColors[NUM_STANDARD_COLORS];
 extern const char* ColorNames[NUM_STANDARD_COLORS];
 extern const char* SideColorModeNames[5];
-extern const char* MouthPatternNames[NUM_MOUTH_PATTERNS];
 extern const char* EyeModeNames[3];
 extern const char* MouthSplitNames[5];
-extern const char* AudioModeNames[5];
+extern const char* AudioModeNames[NUM_AUDIO_MODES];
 extern const char* AudioInputModeNames[2];  // v5.1
-extern const char* patternNames[NUM_PATTERNS];
 
 
 // Playlist
 struct PlaylistEntry {
     uint8_t pattern;
     uint16_t duration; // in Sekunden
+    uint8_t transitionMode = TRANSITION_MODE_DEFAULT;  // v5.2: Transition into this entry
+    uint16_t transitionMs = TRANSITION_MS_DEFAULT;      // v5.2: Its length in ms
 };
 
 extern PlaylistEntry playlist[10];
@@ -208,10 +193,6 @@ extern bool playlistActive;
 extern uint8_t playlistIndex;
 extern unsigned long playlistPatternStartTime;
 
-// Pattern function list
-typedef void (*SimplePatternList[])();
-extern SimplePatternList gPatterns;
-
 // v5.0: Startup sequence control
 extern bool startupSequenceEnabled;
 
@@ -0,0 +1,330 @@
+// golden_frames.cpp - v5.2 Golden-Frame Regression Check
+#include "golden_frames.h"
+#include "patterns_body.h"
+#include "patterns_mouth.h"
+#include "helpers.h"
+#include "audio.h"
+#include "render_clock.h"
+#include "led_output.h"
+#include "pattern_registry.h"
+#include "spectrum.h"
+#include "beat_detector.h"
+#include "filter_bank.h"
+#include "transition.h"
+#include "pattern_arena.h"
+#include <Preferences.h>
+
+GoldenFrames goldenFrames;
+
+// Deterministic audio input: triangle wave around the DC offset
+static uint32_t syntheticSampleCount = 0;
+
+static int readSyntheticSample() {
+    uint16_t phase = (syntheticSampleCount++ * 37) % 800;
+    int level = (phase < 400) ? phase : 800 - phase;
+    return adcDCOffset + level - 200;
+}
+
+void GoldenFrames::beginRun() {
+    // Patterns must render into allLEDs, not into a transition frame
+    transitionEngine.finish();
+
+    saved.pattern = currentPattern;
+    saved.mouthPattern = mouthPattern;
+    saved.hue = gHue;
+    saved.autoGain = audioAutoGain;
+    saved.threshold = audioThreshold;
+    memcpy(saved.body[0], DJLEDs_Right, sizeof(saved.body[0]));
+    memcpy(saved.body[1], DJLEDs_Middle, sizeof(saved.body[1]));
+    memcpy(saved.body[2], DJLEDs_Left, sizeof(saved.body[2]));
+    memcpy(saved.mouth, DJLEDs_Mouth, sizeof(saved.mouth));
+
+    // The audio task would otherwise consume synthetic samples at its own pace
+    lockAudioUpdates();
+
+    setAdcSource(readSyntheticSample);
+}
+
+void GoldenFrames::endRun() {
+    currentPattern = saved.pattern;
+    mouthPattern = saved.mouthPattern;
+    gHue = saved.hue;
+    audioAutoGain = saved.autoGain;
+    audioThreshold = saved.threshold;
+    memcpy(DJLEDs_Right, saved.body[0], sizeof(saved.body[0]));
+    memcpy(DJLEDs_Middle, saved.body[1], sizeof(saved.body[1]));
+    memcpy(DJLEDs_Left, saved.body[2], sizeof(saved.body[2]));
+    memcpy(DJLEDs_Mouth, saved.mouth, sizeof(saved.mouth));
+
+    setAdcSource(nullptr);
+    setRenderClockLive();
+    resetFrameClock();
+    initializeHelpers();  // Re-seeds random()
+    resetPatternArenas();  // Patterns restart their timers on the live clock
+
+    unlockAudioUpdates();
+}
+
+void GoldenFrames::resetRenderState() {
+    setRenderClockVirtual(GOLDEN_CLOCK_START);
+    resetFrameClock();
+
+    random16_set_seed(GOLDEN_SEED);
+    initializeHelpers();
+    randomSeed(GOLDEN_SEED);  // initializeHelpers() seeds from esp_random()
+
+    resetPatternArenas();  // Every pattern enters fresh on its first frame
+
+    gHue = 0;
+    audioAutoGain = false;
+    syntheticSampleCount = 0;
+    for (int i = 0; i < 10; i++) {
+        audioSamples[i] = 0;
+    }
+    audioSampleIdx = 0;
+    averageAudio = 0;
+    audioLevel = 0;
+    lastAudioRead = 0;
+    spectrumAnalyzer.reset();
+    beatDetector.reset();
+    filterBank.reset();
+    resetAudioEnvelopes();
+
+    fill_solid(DJLEDs_Right, NUM_LEDS_PER_PANEL, CRGB::Black);
+    fill_solid(DJLEDs_Middle, NUM_LEDS_PER_PANEL, CRGB::Black);
+    fill_solid(DJLEDs_Left, NUM_LEDS_PER_PANEL, CRGB::Black);
+    fill_solid(DJLEDs_Mouth, NUM_MOUTH_LEDS, CRGB::Black);
+}
+
+void GoldenFrames::renderStep(uint8_t set, uint8_t pattern) {
+    // Same audio path as renderFrame(), driven by the synthetic source.
+    // Golden frames always run at normal speed.
+    beginFrame(TIME_SCALE_DEFAULT);
+    updateAudio();
+    takeAudioSnapshot();
+
+    uint32_t start = micros();
+    if (set == GOLDEN_BODY) {
+        currentPattern = pattern;
+        bodyArena.render(pattern);
+    } else {
+        mouthPattern = pattern;
+        updateMouth();
+    }
+    uint32_t elapsed = micros() - start;
+
+    renderTimeSumUs += elapsed;
+    if (elapsed > renderTimeMaxUs) renderTimeMaxUs = elapsed;
+
+    advanceRenderClock(GOLDEN_FRAME_MS);
+    gHue++;
+}
+
+void GoldenFrames::renderPattern(uint8_t set, uint8_t pattern) {
+    resetRenderState();
+    renderTimeSumUs = 0;
+    renderTimeMaxUs = 0;
+
+    for (uint8_t f = 0; f < GOLDEN_FRAMES; f++) {
+        renderStep(set, pattern);
+        frameHashes[f] = hashFrame(set);
+    }
+}
+
+uint32_t GoldenFrames::hashFrame(uint8_t set) {
+    if (set == GOLDEN_MOUTH) {
+        return LedOutput::hashLeds(DJLEDs_Mouth, NUM_MOUTH_LEDS);
+    }
+    uint32_t hash = LedOutput::hashLeds(DJLEDs_Right, NUM_LEDS_PER_PANEL);
+    hash = LedOutput::hashLeds(DJLEDs_Middle, NUM_LEDS_PER_PANEL, hash);
+    return LedOutput::hashLeds(DJLEDs_Left, NUM_LEDS_PER_PANEL, hash);
+}
+
+uint16_t GoldenFrames::ledCount(uint8_t set) {
+    return (set == GOLDEN_BODY) ? 3 * NUM_LEDS_PER_PANEL : NUM_MOUTH_LEDS;
+}
+
+uint8_t GoldenFrames::patternCount(uint8_t set) {
+    return (set == GOLDEN_BODY) ? NUM_PATTERNS : NUM_MOUTH_PATTERNS;
+}
+
+const char* GoldenFrames::patternName(uint8_t set, uint8_t pattern) {
+    return (set == GOLDEN_BODY) ? bodyPatterns[pattern].name : mouthPatterns[pattern].name;
+}
+
+void GoldenFrames::makeKey(char* key, uint8_t set, uint8_t pattern) {
+    snprintf(key, GOLDEN_KEY_SIZE, "%c%02u", set == GOLDEN_BODY ? 'b' : 'm', pattern);
+}
+
+// "b 3 Short Circuit     avg  120 us  max  180 us"
+void GoldenFrames::printPatternLine(uint8_t set, uint8_t pattern) {
+    Serial.print(set == GOLDEN_BODY ? F("  b") : F("  m"));
+    if (pattern < 10) Serial.print(' ');
+    Serial.print(pattern);
+    Serial.print(' ');
+    Serial.print(patternName(set, pattern));
+    Serial.print(F(": avg "));
+    Serial.print(renderTimeSumUs / GOLDEN_FRAMES);
+    Serial.print(F(" us, max "));
+    Serial.print(renderTimeMaxUs);
+    Serial.print(F(" us - "));
+}
+
+void GoldenFrames::record() {
+    Serial.println(F("=== Golden Frames: record ==="));
+    beginRun();
+
+    Preferences prefs;
+    prefs.begin("golden", false);
+
+    for (uint8_t set = GOLDEN_BODY; set <= GOLDEN_MOUTH; set++) {
+        for (uint8_t p = 0; p < patternCount(set); p++) {
+            renderPattern(set, p);
+
+            char key[GOLDEN_KEY_SIZE];
+            makeKey(key, set, p);
+            prefs.putBytes(key, frameHashes, sizeof(frameHashes));
+
+            printPatternLine(set, p);
+            Serial.println(F("stored"));
+            yield();
+        }
+    }
+
+    prefs.end();
+    endRun();
+
+    Serial.print(F("Recorded "));
+    Serial.print(GOLDEN_FRAMES);
+    Serial.println(F(" frames per pattern (uses current settings)"));
+}
+
+void GoldenFrames::check() {
+    Serial.println(F("=== Golden Frames: check ==="));
+    beginRun();
+
+    Preferences prefs;
+    prefs.begin("golden", true);  // Read-only
+
+    uint8_t passed = 0, failed = 0, missing = 0;
+    uint32_t golden[GOLDEN_FRAMES];
+
+    for (uint8_t set = GOLDEN_BODY; set <= GOLDEN_MOUTH; set++) {
+        for (uint8_t p = 0; p < patternCount(set); p++) {
+            renderPattern(set, p);
+            printPatternLine(set, p);
+
+            char key[GOLDEN_KEY_SIZE];
+            makeKey(key, set, p);
+            if (prefs.getBytes(key, golden, sizeof(golden)) != sizeof(golden)) {
+                Serial.println(F("no golden frames"));
+                missing++;
+                continue;
+            }
+
+            int16_t firstMismatch = -1;
+            uint8_t mismatches = 0;
+            for (uint8_t f = 0; f < GOLDEN_FRAMES; f++) {
+                if (frameHashes[f] != golden[f]) {
+                    if (firstMismatch < 0) firstMismatch = f;
+                    mismatches++;
+                }
+            }
+
+            if (mismatches == 0) {
+                Serial.println(F("OK"));
+                passed++;
+            } else {
+                Serial.print(F("FAIL ("));
+                Serial.print(mismatches);
+                Serial.print(F(" frames differ, first: "));
+                Serial.print(firstMismatch);
+                Serial.println(F(")"));
+                failed++;
+            }
+            yield();
+        }
+    }
+
+    prefs.end();
+    endRun();
+
+    Serial.print(F("Result: "));
+    Serial.print(passed);
+    Serial.print(F(" OK, "));
+    Serial.print(failed);
+    Serial.print(F(" FAIL, "));
+    Serial.print(missing);
+    Serial.println(F(" missing"));
+    if (failed > 0) {
+        Serial.println(F("Use 'golden dump' on both firmware versions to diff a failing frame"));
+    }
+}
+
+void GoldenFrames::capture(uint8_t set, uint8_t pattern, CRGB* frames) {
+    beginRun();
+    resetRenderState();
+    for (uint8_t f = 0; f < GOLDEN_FRAMES; f++) {
+        renderStep(set, pattern);
+
+        CRGB* frame = &frames[f * ledCount(set)];
+        if (set == GOLDEN_BODY) {
+            memcpy(&frame[0], DJLEDs_Right, NUM_LEDS_PER_PANEL * sizeof(CRGB));
+            memcpy(&frame[NUM_LEDS_PER_PANEL], DJLEDs_Middle, NUM_LEDS_PER_PANEL * sizeof(CRGB));
+            memcpy(&frame[2 * NUM_LEDS_PER_PANEL], DJLEDs_Left, NUM_LEDS_PER_PANEL * sizeof(CRGB));
+        } else {
+            memcpy(frame, DJLEDs_Mouth, NUM_MOUTH_LEDS * sizeof(CRGB));
+        }
+    }
+    endRun();
+}
+
+void GoldenFrames::printLeds(const CRGB* leds, uint16_t count) {
+    char hex[8];
+    for (uint16_t i = 0; i < count; i++) {
+        snprintf(hex, sizeof(hex), " %02X%02X%02X", leds[i].r, leds[i].g, leds[i].b);
+        Serial.print(hex);
+    }
+    Serial.println();
+}
+
+void GoldenFrames::dump(uint8_t set, uint8_t pattern, uint8_t frame) {
+    if (pattern >= patternCount(set) || frame >= GOLDEN_FRAMES) {
+        Serial.println(F("Invalid pattern or frame!"));
+        return;
+    }
+
+    beginRun();
+    resetRenderState();
+    for (uint8_t f = 0; f <= frame; f++) {
+        renderStep(set, pattern);
+    }
+
+    Serial.print(F("=== Golden Frame "));
+    Serial.print(set == GOLDEN_BODY ? 'b' : 'm');
+    Serial.print(pattern);
+    Serial.print(F(" #"));
+    Serial.print(frame);
+    Serial.print(F(" hash "));
+    Serial.print(hashFrame(set), HEX);
+    Serial.println(F(" ==="));
+
+    if (set == GOLDEN_BODY) {
+        Serial.print(F("Right: "));
+        printLeds(DJLEDs_Right, NUM_LEDS_PER_PANEL);
+        Serial.print(F("Middle:"));
+        printLeds(DJLEDs_Middle, NUM_LEDS_PER_PANEL);
+        Serial.print(F("Left:  "));
+        printLeds(DJLEDs_Left, NUM_LEDS_PER_PANEL);
+    } else {
+        for (uint8_t row = 0; row < MOUTH_ROWS; row++) {
+            Serial.print(F("Row "));
+            if (row < 10) Serial.print(' ');
+            Serial.print(row);
+            Serial.print(':');
+            printLeds(&DJLEDs_Mouth[mouthRowStart[row]], mouthRowLeds[row]);
+        }
+    }
+
+    endRun();
+}
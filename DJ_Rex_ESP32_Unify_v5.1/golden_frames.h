@@ -0,0 +1,64 @@
+// golden_frames.h - v5.2 Golden-Frame Regression Check
+#ifndef GOLDEN_FRAMES_H
+#define GOLDEN_FRAMES_H
+
+#include "config.h"
+#include "globals.h"
+
+// Pattern sets covered by the check
+enum GoldenSet {
+    GOLDEN_BODY = 0,
+    GOLDEN_MOUTH
+};
+
+// NVS key of one pattern's hashes: set letter, pattern number (0-255), NUL
+#define GOLDEN_KEY_SIZE 5
+
+// Renders GOLDEN_FRAMES frames of every body and mouth pattern from a fixed
+// state (virtual clock, seeded RNG, synthetic audio) and hashes each frame.
+// "record" stores the hashes in flash, "check" compares against them, so an
+// optimized kernel can be proven to produce bit-identical output.
+// The host tests compare the full frames from capture() against image files.
+class GoldenFrames {
+public:
+    void record();
+    void check();
+    // Print the LED colors of one frame (for diffing two firmware versions)
+    void dump(uint8_t set, uint8_t pattern, uint8_t frame);
+    // Render one pattern into frames[GOLDEN_FRAMES * ledCount(set)], frame after frame
+    void capture(uint8_t set, uint8_t pattern, CRGB* frames);
+
+    static uint16_t ledCount(uint8_t set);
+    uint8_t patternCount(uint8_t set);
+    const char* patternName(uint8_t set, uint8_t pattern);
+
+private:
+    struct SavedState {
+        uint8_t pattern;
+        uint8_t mouthPattern;
+        uint8_t hue;
+        bool autoGain;
+        int threshold;
+        CRGB body[3][NUM_LEDS_PER_PANEL];
+        CRGB mouth[NUM_MOUTH_LEDS];
+    };
+
+    SavedState saved;
+    uint32_t frameHashes[GOLDEN_FRAMES];
+    uint32_t renderTimeSumUs = 0;
+    uint32_t renderTimeMaxUs = 0;
+
+    void beginRun();
+    void endRun();
+    void resetRenderState();
+    void renderStep(uint8_t set, uint8_t pattern);
+    void renderPattern(uint8_t set, uint8_t pattern);
+    uint32_t hashFrame(uint8_t set);
+    void printPatternLine(uint8_t set, uint8_t pattern);
+    static void makeKey(char* key, uint8_t set, uint8_t pattern);
+    static void printLeds(const CRGB* leds, uint16_t count);
+};
+
+extern GoldenFrames goldenFrames;
+
+#endif
@@ -3,21 +3,9 @@
 void initializeHelpers() {
     // Initialize random seed
     randomSeed(esp_random());
-    
-    // Initialize timing arrays
-    for (byte x = 0; x < TOTAL_BODY_LEDS; x++) {
-        IntervalTime[x] = random16(3000);
-        LEDMillis[x] = millis();
-        LEDOn[x] = 0;
-    }
-    
-    // Initialize matrix drops
-    for (int panel = 0; panel < 3; panel++) {
-        for (int led = 0; led < 8; led++) {
-            matrixDrops[panel][led] = 255;
-            matrixBright[panel][led] = 0;
-        }
-    }
+
+    // v5.2: Blink deadlines and other pattern state are set up when a
+    // pattern enters its arena slot (pattern_arena.h)
 }
 
 CRGB* getLEDArray(uint8_t panel) {
@@ -99,6 +87,50 @@ uint16_t getRandomTimingWithRate(uint16_t minTime, uint16_t maxTime, uint8_t rat
     return constrain(adjustedTime, 50, 30000);
 }
 
+uint8_t fadeForFrame(uint8_t amount, uint16_t dt) {
+    if (amount == 0 || dt == 0) return 0;
+
+    // Share that survives, 65536 = all: once per whole reference frame,
+    // linearly for the rest of one
+    uint32_t kept = 65536;
+    for (uint16_t n = dt / REFERENCE_FRAME_MS; n > 0 && kept > 0; n--) {
+        kept = kept * (256 - amount) >> 8;
+    }
+    kept -= kept * amount * (dt % REFERENCE_FRAME_MS) / (256UL * REFERENCE_FRAME_MS);
+
+    return min(256 - (kept >> 8), (uint32_t)255);
+}
+
+uint8_t randomEvents(uint16_t chance, uint16_t dt) {
+    uint8_t events = 0;
+    for (uint16_t n = dt / REFERENCE_FRAME_MS; n > 0; n--) {
+        if (random8() < chance) events++;
+    }
+    uint16_t rest = dt % REFERENCE_FRAME_MS;
+    if (rest > 0 && random8() < chance * rest / REFERENCE_FRAME_MS) events++;
+    return events;
+}
+
+uint16_t advanceBy(uint16_t& rest, uint16_t dt, uint16_t perReference) {
+    uint32_t total = (uint32_t)perReference * dt + rest;
+    rest = total % REFERENCE_FRAME_MS;
+    return total / REFERENCE_FRAME_MS;
+}
+
+uint16_t elapsedSteps(uint32_t& last, uint32_t now, uint16_t periodMs) {
+    if (periodMs == 0) periodMs = 1;
+    uint32_t elapsed = now - last;
+    if (elapsed < periodMs) return 0;
+
+    if (elapsed >= periodMs + (uint32_t)MAX_FRAME_DT_MS * MAX_TIME_SCALE / 100) {
+        last = now;
+        return 1;
+    }
+    uint16_t steps = elapsed / periodMs;
+    last += (uint32_t)steps * periodMs;
+    return steps;
+}
+
 CRGB applyBodyBrightness(CRGB color) {
     CRGB adjustedColor = color;
     adjustedColor.r = min(255, (adjustedColor.r * bodyBrightness) / 100);
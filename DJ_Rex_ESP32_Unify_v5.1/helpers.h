@@ -24,4 +24,17 @@ CRGB applyBodyBrightness(CRGB color);
 uint16_t getRandomTiming(uint16_t minTime, uint16_t maxTime);
 uint16_t getRandomTimingWithRate(uint16_t minTime, uint16_t maxTime, uint8_t rate);
 
+// v5.2: Frame-rate independent animation. Amounts are given per
+// REFERENCE_FRAME_MS and converted to a frame of dt ms.
+// Fade amount that takes off over dt what 'amount' takes off per reference
+// frame (compounding, never rounds a fade down to nothing)
+uint8_t fadeForFrame(uint8_t amount, uint16_t dt);
+// How often an event with a chance of chance/256 per reference frame happens in dt
+uint8_t randomEvents(uint16_t chance, uint16_t dt);
+// Whole steps of a rate of perReference per reference frame, the fraction kept in rest
+uint16_t advanceBy(uint16_t& rest, uint16_t dt, uint16_t perReference);
+// Periods of periodMs that passed since last, which moves on by them. Restarts
+// the period (one step) when last is older than a frame could be.
+uint16_t elapsedSteps(uint32_t& last, uint32_t now, uint16_t periodMs);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,499 @@
+// led_output.cpp - v5.2 LED Output with per-controller dirty tracking
+#include "led_output.h"
+#include <Arduino.h>
+
+// Parallel RMT only where every output gets its own TX channel (not the C3),
+// with the rmt_tx driver of ESP-IDF 5 (esp32 core 3.x)
+#if LED_OUTPUT_BACKEND == LED_BACKEND_PARALLEL_RMT
+#include <soc/soc_caps.h>
+#include <esp_idf_version.h>
+#if SOC_RMT_TX_CANDIDATES_PER_GROUP >= 4 && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+#define USE_PARALLEL_RMT 1
+#include <driver/rmt_tx.h>
+#endif
+#endif
+#ifndef USE_PARALLEL_RMT
+#define USE_PARALLEL_RMT 0
+#endif
+
+LedOutput ledOutput;
+
+const LedOutputInfo ledOutputs[NUM_LED_OUTPUTS] = {
+    {"Right",      LED_PIN_RIGHT,  DJLEDs_Right,  NUM_LEDS_PER_PANEL},
+    {"Middle",     LED_PIN_MIDDLE, DJLEDs_Middle, NUM_LEDS_PER_PANEL},
+    {"Left",       LED_PIN_LEFT,   DJLEDs_Left,   NUM_LEDS_PER_PANEL},
+    {"Eyes+Mouth", EYES_MOUTH_PIN, eyesMouthLEDs, NUM_EYES_MOUTH_LEDS},
+};
+
+// =====================================================
+// FastLED backend - one controller per output, sent one after another
+// =====================================================
+
+class FastLEDBackend : public LedOutputBackend {
+public:
+    void begin(const LedOutputInfo* outputs) override {
+        controllers[OUTPUT_RIGHT] = &FastLED.addLeds<LED_TYPE, LED_PIN_RIGHT, COLOR_ORDER>(outputs[OUTPUT_RIGHT].leds, outputs[OUTPUT_RIGHT].count);
+        controllers[OUTPUT_MIDDLE] = &FastLED.addLeds<LED_TYPE, LED_PIN_MIDDLE, COLOR_ORDER>(outputs[OUTPUT_MIDDLE].leds, outputs[OUTPUT_MIDDLE].count);
+        controllers[OUTPUT_LEFT] = &FastLED.addLeds<LED_TYPE, LED_PIN_LEFT, COLOR_ORDER>(outputs[OUTPUT_LEFT].leds, outputs[OUTPUT_LEFT].count);
+        controllers[OUTPUT_EYES_MOUTH] = &FastLED.addLeds<LED_TYPE, EYES_MOUTH_PIN, COLOR_ORDER>(outputs[OUTPUT_EYES_MOUTH].leds, outputs[OUTPUT_EYES_MOUTH].count);
+
+        for (uint8_t i = 0; i < NUM_LED_OUTPUTS; i++) {
+            controllers[i]->setCorrection(LED_COLOR_CORRECTION);
+            controllers[i]->setTemperature(LED_COLOR_TEMPERATURE);
+        }
+    }
+
+    void queue(uint8_t output, uint8_t brightness) override {
+        queued[output] = true;
+        queuedBrightness = brightness;
+    }
+
+    void flush() override {
+        // A full frame goes through FastLED.show() and gets its handling (power
+        // limit, refresh pacing); FastLED.show() always sends every controller,
+        // so a frame with skipped outputs sends the changed ones directly
+        bool all = true;
+        for (uint8_t i = 0; i < NUM_LED_OUTPUTS; i++) {
+            all = all && queued[i];
+        }
+        if (all) {
+            FastLED.show();
+        } else {
+            for (uint8_t i = 0; i < NUM_LED_OUTPUTS; i++) {
+                if (queued[i]) controllers[i]->showLeds(queuedBrightness);
+            }
+        }
+        for (uint8_t i = 0; i < NUM_LED_OUTPUTS; i++) {
+            queued[i] = false;
+        }
+    }
+
+    const char* getName() override {
+        return "FastLED (sequential)";
+    }
+
+private:
+    CLEDController* controllers[NUM_LED_OUTPUTS];
+    bool queued[NUM_LED_OUTPUTS] = {false};
+    uint8_t queuedBrightness = 0;
+};
+
+// =====================================================
+// Parallel RMT backend - every output transmits at the same time
+// =====================================================
+// One TX channel per output, created once at startup, so a frame takes as
+// long as the longest chain (eyes+mouth) instead of the sum of all four.
+
+#if USE_PARALLEL_RMT
+
+#define RMT_LED_RESOLUTION_HZ 10000000  // 0.1 us per tick
+#define RMT_TX_TIMEOUT_MS 10
+
+class ParallelRmtBackend : public LedOutputBackend {
+public:
+    void begin(const LedOutputInfo* outputs) override {
+        info = outputs;
+
+        // WS2812B bit timing: 0 = 0.4us high + 0.8us low, 1 = 0.8us high + 0.4us low
+        rmt_bytes_encoder_config_t encoderConfig = {};
+        encoderConfig.bit0.level0 = 1;
+        encoderConfig.bit0.duration0 = 4;
+        encoderConfig.bit0.level1 = 0;
+        encoderConfig.bit0.duration1 = 8;
+        encoderConfig.bit1.level0 = 1;
+        encoderConfig.bit1.duration0 = 8;
+        encoderConfig.bit1.level1 = 0;
+        encoderConfig.bit1.duration1 = 4;
+        encoderConfig.flags.msb_first = 1;
+
+        for (uint8_t i = 0; i < NUM_LED_OUTPUTS; i++) {
+            channels[i] = NULL;
+            if (rmt_new_bytes_encoder(&encoderConfig, &encoders[i]) != ESP_OK) {
+                Serial.println(F("ERROR: Failed to create RMT encoder!"));
+                errors++;
+                continue;
+            }
+
+            rmt_tx_channel_config_t channelConfig = {};
+            channelConfig.gpio_num = (gpio_num_t)info[i].pin;
+            channelConfig.clk_src = RMT_CLK_SRC_DEFAULT;
+            channelConfig.resolution_hz = RMT_LED_RESOLUTION_HZ;
+            channelConfig.mem_block_symbols = SOC_RMT_MEM_WORDS_PER_CHANNEL;
+            channelConfig.trans_queue_depth = 1;
+
+            if (rmt_new_tx_channel(&channelConfig, &channels[i]) != ESP_OK) {
+                Serial.print(F("ERROR: Failed to create RMT channel on pin "));
+                Serial.println(info[i].pin);
+                channels[i] = NULL;
+                errors++;
+                continue;
+            }
+            if (rmt_enable(channels[i]) != ESP_OK) {
+                Serial.print(F("ERROR: Failed to enable RMT channel on pin "));
+                Serial.println(info[i].pin);
+                rmt_del_channel(channels[i]);
+                channels[i] = NULL;
+                errors++;
+            }
+        }
+    }
+
+    void queue(uint8_t output, uint8_t brightness) override {
+        // Pre-encode in wire order with the same brightness adjustment and
+        // dithering FastLED's controllers apply in showLeds()
+        const CRGB scale = CLEDController::computeAdjustment(brightness, LED_COLOR_CORRECTION, LED_COLOR_TEMPERATURE);
+        const uint8_t order[3] = {RGB_BYTE0(COLOR_ORDER), RGB_BYTE1(COLOR_ORDER), RGB_BYTE2(COLOR_ORDER)};
+        uint8_t d[3];
+        uint8_t e[3];
+        initDithering(scale, d, e);
+
+        const CRGB* leds = info[output].leds;
+        uint8_t* data = wireData[output];
+        for (uint16_t i = 0; i < info[output].count; i++) {
+            for (uint8_t slot = 0; slot < 3; slot++) {
+                uint8_t channel = order[slot];
+                uint8_t value = leds[i].raw[channel];
+                if (value) value = qadd8(value, d[channel]);
+                *data++ = scale8(value, scale.raw[channel]);
+            }
+            for (uint8_t channel = 0; channel < 3; channel++) {
+                d[channel] = e[channel] - d[channel];
+            }
+        }
+        queued[output] = true;
+    }
+
+    void flush() override {
+        bool sending[NUM_LED_OUTPUTS] = {false};
+
+        for (uint8_t i = 0; i < NUM_LED_OUTPUTS; i++) {
+            if (!queued[i]) continue;
+            queued[i] = false;
+            if (channels[i] == NULL) continue;
+
+            rmt_transmit_config_t transmitConfig = {};
+            transmitConfig.loop_count = 0;
+            if (rmt_transmit(channels[i], encoders[i], wireData[i], info[i].count * 3, &transmitConfig) == ESP_OK) {
+                sending[i] = true;
+            } else {
+                errors++;
+            }
+        }
+
+        for (uint8_t i = 0; i < NUM_LED_OUTPUTS; i++) {
+            if (sending[i] && rmt_tx_wait_all_done(channels[i], RMT_TX_TIMEOUT_MS) != ESP_OK) {
+                errors++;
+            }
+        }
+    }
+
+    const char* getName() override {
+        return "Parallel RMT (4 channels)";
+    }
+
+    uint32_t getErrors() override {
+        return errors;
+    }
+
+    void resetErrors() override {
+        errors = 0;
+    }
+
+private:
+    const LedOutputInfo* info = nullptr;
+    rmt_channel_handle_t channels[NUM_LED_OUTPUTS];
+    rmt_encoder_handle_t encoders[NUM_LED_OUTPUTS];
+    bool queued[NUM_LED_OUTPUTS] = {false};
+    uint8_t wireData[NUM_LED_OUTPUTS][NUM_EYES_MOUTH_LEDS * 3];
+    uint8_t ditherFrame = 0;
+    uint32_t errors = 0;
+
+    // FastLED's binary temporal dithering (PixelController): 3 virtual bits
+    // from a bit-reversed output counter, alternating from pixel to pixel
+    void initDithering(const CRGB& scale, uint8_t* d, uint8_t* e) {
+        ditherFrame = (ditherFrame + 1) & 0x07;
+        uint8_t q = 0;
+        if (ditherFrame & 0x01) q |= 0x80;
+        if (ditherFrame & 0x02) q |= 0x40;
+        if (ditherFrame & 0x04) q |= 0x20;
+        q += 0x10;
+
+        for (uint8_t i = 0; i < 3; i++) {
+            uint8_t s = scale.raw[i];
+            e[i] = s ? (256 / s) + 1 : 0;
+            d[i] = scale8(q, e[i]);
+            if (d[i]) d[i]--;
+            if (e[i]) e[i]--;
+        }
+    }
+};
+
+static ParallelRmtBackend parallelBackend;
+#else
+static FastLEDBackend fastLEDBackend;
+#endif
+
+// =====================================================
+// Null backend - accepts every frame and sends nothing
+// =====================================================
+
+class NullBackend : public LedOutputBackend {
+public:
+    void begin(const LedOutputInfo* /*outputs*/) override {
+    }
+
+    void queue(uint8_t /*output*/, uint8_t /*brightness*/) override {
+    }
+
+    void flush() override {
+    }
+
+    const char* getName() override {
+        return "Null sink";
+    }
+};
+
+static NullBackend nullBackend;
+
+// =====================================================
+// LedOutput
+// =====================================================
+
+void LedOutput::begin() {
+    #if USE_PARALLEL_RMT
+    hardwareBackend = &parallelBackend;
+    #else
+    hardwareBackend = &fastLEDBackend;
+    #endif
+
+    backend = hardwareBackend;
+    resetStats();
+    hardwareBackend->begin(ledOutputs);
+
+    Serial.print(F("LED Output initialized: "));
+    Serial.println(backend->getName());
+}
+
+// FNV-1a over the raw RGB bytes of one output
+uint32_t LedOutput::hashLeds(const CRGB* leds, uint16_t count, uint32_t hash) {
+    const uint8_t* data = (const uint8_t*)leds;
+    for (uint16_t i = 0; i < count * sizeof(CRGB); i++) {
+        hash ^= data[i];
+        hash *= 16777619UL;
+    }
+    return hash;
+}
+
+void LedOutput::queueOutput(uint8_t output, uint8_t brightness, uint32_t hash, unsigned long now) {
+    backend->queue(output, brightness);
+    states[output].lastHash = hash;
+    states[output].lastSentTime = now;
+    states[output].sent++;
+}
+
+// Sequential backends send while queueing, so time is taken from the first queue()
+void LedOutput::flushBackend(uint8_t queued, uint32_t start) {
+    if (queued == 0) return;
+
+    backend->flush();
+    lastShowTimeUs = micros() - start;
+
+    showTimeSumUs += lastShowTimeUs;
+    showCount++;
+    if (lastShowTimeUs > showTimeMaxUs) {
+        showTimeMaxUs = lastShowTimeUs;
+    }
+}
+
+void LedOutput::show() {
+    uint8_t brightness = FastLED.getBrightness();
+    unsigned long now = millis();
+    uint32_t start = micros();
+    uint8_t queued = 0;
+
+    // A brightness change alters every byte on the wire
+    bool forceAll = !selectiveShow || brightness != lastBrightness;
+    lastBrightness = brightness;
+
+    for (uint8_t i = 0; i < NUM_LED_OUTPUTS; i++) {
+        uint32_t hash = hashLeds(ledOutputs[i].leds, ledOutputs[i].count);
+        bool refreshDue = refreshIntervalMs > 0 && (now - states[i].lastSentTime >= refreshIntervalMs);
+
+        if (forceAll || refreshDue || hash != states[i].lastHash) {
+            queueOutput(i, brightness, hash, now);
+            queued++;
+        } else {
+            states[i].skipped++;
+        }
+    }
+
+    flushBackend(queued, start);
+}
+
+void LedOutput::showAll() {
+    uint8_t brightness = FastLED.getBrightness();
+    unsigned long now = millis();
+    uint32_t start = micros();
+    lastBrightness = brightness;
+
+    for (uint8_t i = 0; i < NUM_LED_OUTPUTS; i++) {
+        queueOutput(i, brightness, hashLeds(ledOutputs[i].leds, ledOutputs[i].count), now);
+    }
+    flushBackend(NUM_LED_OUTPUTS, start);
+}
+
+void LedOutput::setSelectiveShow(bool enabled) {
+    selectiveShow = enabled;
+}
+
+bool LedOutput::isSelectiveShow() {
+    return selectiveShow;
+}
+
+void LedOutput::setRefreshInterval(uint16_t intervalMs) {
+    refreshIntervalMs = intervalMs;
+}
+
+uint16_t LedOutput::getRefreshInterval() {
+    return refreshIntervalMs;
+}
+
+void LedOutput::setNullSink(bool enabled) {
+    if (enabled == isNullSink()) return;
+
+    backend = enabled ? &nullBackend : hardwareBackend;
+    resetStats();
+    if (!enabled) {
+        // The strips still show whatever was sent last
+        showAll();
+    }
+}
+
+bool LedOutput::isNullSink() {
+    return backend == &nullBackend;
+}
+
+const char* LedOutput::getBackendName() {
+    return backend != nullptr ? backend->getName() : "none";
+}
+
+uint32_t LedOutput::getFramesSent() {
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < NUM_LED_OUTPUTS; i++) {
+        total += states[i].sent;
+    }
+    return total;
+}
+
+uint32_t LedOutput::getFramesSkipped() {
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < NUM_LED_OUTPUTS; i++) {
+        total += states[i].skipped;
+    }
+    return total;
+}
+
+uint32_t LedOutput::getShowTimeAvg() {
+    return showCount > 0 ? showTimeSumUs / showCount : 0;
+}
+
+uint32_t LedOutput::getShowTimeMax() {
+    return showTimeMaxUs;
+}
+
+uint32_t LedOutput::getErrors() {
+    return backend != nullptr ? backend->getErrors() : 0;
+}
+
+void LedOutput::resetStats() {
+    for (uint8_t i = 0; i < NUM_LED_OUTPUTS; i++) {
+        states[i].sent = 0;
+        states[i].skipped = 0;
+    }
+    lastShowTimeUs = 0;
+    showTimeMaxUs = 0;
+    showTimeSumUs = 0;
+    showCount = 0;
+    if (backend != nullptr) {
+        backend->resetErrors();
+    }
+}
+
+void LedOutput::runBenchmark(uint16_t frames) {
+    uint32_t totalLeds = 0;
+    uint32_t longestChain = 0;
+    for (uint8_t i = 0; i < NUM_LED_OUTPUTS; i++) {
+        totalLeds += ledOutputs[i].count;
+        if (ledOutputs[i].count > longestChain) {
+            longestChain = ledOutputs[i].count;
+        }
+    }
+
+    uint32_t start = micros();
+    for (uint16_t i = 0; i < frames; i++) {
+        showAll();
+    }
+    uint32_t avgUs = (micros() - start) / frames;
+
+    Serial.println(F("=== LED Benchmark ==="));
+    Serial.print(F("Backend: "));
+    Serial.println(backend->getName());
+    Serial.print(F("Frames: "));
+    Serial.println(frames);
+    Serial.print(F("Full frame: "));
+    Serial.print(avgUs);
+    Serial.println(F(" us"));
+    // WS2812B: 24 bits x 1.25us = 30us per LED, plus the 50us latch
+    Serial.print(F("Wire time sequential: "));
+    Serial.print(totalLeds * 30 + 50);
+    Serial.print(F(" us ("));
+    Serial.print(totalLeds);
+    Serial.println(F(" LEDs)"));
+    Serial.print(F("Wire time parallel: "));
+    Serial.print(longestChain * 30 + 50);
+    Serial.print(F(" us ("));
+    Serial.print(longestChain);
+    Serial.println(F(" LEDs, longest chain)"));
+    Serial.println(F("====================="));
+}
+
+void LedOutput::printStatus() {
+    Serial.println(F("=== LED Output ==="));
+    Serial.print(F("Backend: "));
+    Serial.println(getBackendName());
+    Serial.print(F("Selective Show: "));
+    Serial.println(selectiveShow ? "ON" : "OFF");
+    Serial.print(F("Refresh Interval: "));
+    if (refreshIntervalMs > 0) {
+        Serial.print(refreshIntervalMs);
+        Serial.println(F(" ms"));
+    } else {
+        Serial.println(F("never"));
+    }
+    Serial.print(F("Show Time: "));
+    Serial.print(lastShowTimeUs);
+    Serial.print(F(" us (avg "));
+    Serial.print(getShowTimeAvg());
+    Serial.print(F(", max "));
+    Serial.print(showTimeMaxUs);
+    Serial.println(F(")"));
+
+    for (uint8_t i = 0; i < NUM_LED_OUTPUTS; i++) {
+        Serial.print(F("  "));
+        Serial.print(ledOutputs[i].name);
+        Serial.print(F(": "));
+        Serial.print(states[i].sent);
+        Serial.print(F(" sent, "));
+        Serial.print(states[i].skipped);
+        Serial.println(F(" skipped"));
+    }
+
+    Serial.print(F("Total: "));
+    Serial.print(getFramesSent());
+    Serial.print(F(" sent, "));
+    Serial.print(getFramesSkipped());
+    Serial.println(F(" skipped"));
+    Serial.print(F("Driver Errors: "));
+    Serial.println(getErrors());
+    Serial.println(F("=================="));
+}
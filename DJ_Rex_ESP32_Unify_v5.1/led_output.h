@@ -0,0 +1,101 @@
+// led_output.h - v5.2 LED Output with per-controller dirty tracking
+#ifndef LED_OUTPUT_H
+#define LED_OUTPUT_H
+
+#include "config.h"
+#include "globals.h"
+
+// Physical outputs (one data line each)
+enum LedOutputId {
+    OUTPUT_RIGHT = 0,
+    OUTPUT_MIDDLE,
+    OUTPUT_LEFT,
+    OUTPUT_EYES_MOUTH,
+    NUM_LED_OUTPUTS
+};
+
+// Static description of one physical output
+struct LedOutputInfo {
+    const char* name;
+    uint8_t pin;
+    CRGB* leds;
+    uint16_t count;
+};
+
+// Output backend interface. LedOutput decides which outputs changed and
+// hands them to the backend, which is responsible for getting them onto the wire.
+class LedOutputBackend {
+public:
+    virtual void begin(const LedOutputInfo* outputs) = 0;
+    virtual void queue(uint8_t output, uint8_t brightness) = 0;  // Send this output in the current frame
+    virtual void flush() = 0;                                     // Returns once all queued outputs are sent
+    virtual const char* getName() = 0;
+    // Driver calls that failed since the last reset
+    virtual uint32_t getErrors() { return 0; }
+    virtual void resetErrors() {}
+};
+
+class LedOutput {
+public:
+    void begin();
+
+    // Send only the outputs whose contents changed since they were last sent
+    void show();
+    // Resend every output regardless of its contents
+    void showAll();
+
+    // Configuration
+    void setSelectiveShow(bool enabled);
+    bool isSelectiveShow();
+    void setRefreshInterval(uint16_t intervalMs);
+    uint16_t getRefreshInterval();
+    const char* getBackendName();
+
+    // Route output into a null sink (render without driving the LEDs)
+    void setNullSink(bool enabled);
+    bool isNullSink();
+
+    // Statistics
+    uint32_t getFramesSent();
+    uint32_t getFramesSkipped();
+    uint32_t getShowTimeAvg();
+    uint32_t getShowTimeMax();
+    uint32_t getErrors();
+    void resetStats();
+    void printStatus();
+
+    // Measure the time of full-frame shows with the active backend
+    void runBenchmark(uint16_t frames);
+
+    // FNV-1a over raw RGB bytes - pass a previous result to hash several arrays
+    static uint32_t hashLeds(const CRGB* leds, uint16_t count, uint32_t hash = 2166136261UL);
+
+private:
+    struct OutputState {
+        uint32_t lastHash;
+        unsigned long lastSentTime;
+        uint32_t sent;
+        uint32_t skipped;
+    };
+
+    LedOutputBackend* backend = nullptr;
+    LedOutputBackend* hardwareBackend = nullptr;
+    OutputState states[NUM_LED_OUTPUTS];
+    uint8_t lastBrightness = 0;
+    bool selectiveShow = LED_SELECTIVE_SHOW;
+    uint16_t refreshIntervalMs = LED_REFRESH_INTERVAL_MS;
+
+    // show() duration of frames that sent at least one output
+    uint32_t lastShowTimeUs = 0;
+    uint32_t showTimeMaxUs = 0;
+    uint32_t showTimeSumUs = 0;
+    uint32_t showCount = 0;
+
+    void queueOutput(uint8_t output, uint8_t brightness, uint32_t hash, unsigned long now);
+    void flushBackend(uint8_t queued, uint32_t start);
+};
+
+extern LedOutput ledOutput;
+extern const LedOutputInfo ledOutputs[NUM_LED_OUTPUTS];
+
+#endif
@@ -0,0 +1,76 @@
+// pattern_arena.cpp - v5.2 Pattern Lifecycle & State Arena
+#include "pattern_arena.h"
+#include "render_clock.h"
+
+alignas(PATTERN_STATE_ALIGN) static uint8_t bodyStorage[2 * BODY_SLOT_BYTES];
+alignas(PATTERN_STATE_ALIGN) static uint8_t mouthStorage[2 * MOUTH_SLOT_BYTES];
+
+PatternArena bodyArena(bodyPatterns, bodyStorage, BODY_SLOT_BYTES);
+PatternArena mouthArena(mouthPatterns, mouthStorage, MOUTH_SLOT_BYTES);
+
+void PatternArena::render(uint8_t pattern) {
+    if (owner[live] == pattern) {
+        table[pattern].render(frameContext());
+        return;
+    }
+
+    release(live);
+    memset(liveState(), 0, slotBytes);
+    owner[live] = pattern;
+    if (table[pattern].enter) {
+        table[pattern].enter();
+    }
+
+    // Nothing has passed for the pattern yet
+    FrameContext first = frameContext();
+    first.dt = 0;
+    table[pattern].render(first);
+}
+
+void PatternArena::release(uint8_t slot) {
+    uint8_t pattern = owner[slot];
+    if (pattern == NO_PATTERN) return;
+
+    owner[slot] = NO_PATTERN;
+    if (table[pattern].exit) {
+        // exit() sees its own state as the live one
+        uint8_t saved = live;
+        live = slot;
+        table[pattern].exit();
+        live = saved;
+    }
+}
+
+void PatternArena::reset() {
+    release(0);
+    release(1);
+}
+
+void resetPatternArenas() {
+    bodyArena.reset();
+    mouthArena.reset();
+}
+
+void printPatternArenaStatus() {
+    Serial.println(F("=== Pattern Arena ==="));
+    Serial.print(F("Body slots: 2 x "));
+    Serial.print(BODY_SLOT_BYTES);
+    Serial.print(F(" bytes (largest state "));
+    Serial.print(BODY_STATE_HIGH_WATER);
+    Serial.println(F(")"));
+    Serial.print(F("Mouth slots: 2 x "));
+    Serial.print(MOUTH_SLOT_BYTES);
+    Serial.print(F(" bytes (largest state "));
+    Serial.print(MOUTH_STATE_HIGH_WATER);
+    Serial.println(F(")"));
+    Serial.print(F("Owners: body "));
+    Serial.print(bodyArena.getOwner(0));
+    Serial.print(F("/"));
+    Serial.print(bodyArena.getOwner(1));
+    Serial.print(F(", mouth "));
+    Serial.print(mouthArena.getOwner(0));
+    Serial.print(F("/"));
+    Serial.print(mouthArena.getOwner(1));
+    Serial.println(F(" (255 = free)"));
+    Serial.println(F("====================="));
+}
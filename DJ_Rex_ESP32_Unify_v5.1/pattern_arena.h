@@ -0,0 +1,85 @@
+// pattern_arena.h - v5.2 Pattern Lifecycle & State Arena
+#ifndef PATTERN_ARENA_H
+#define PATTERN_ARENA_H
+
+#include "config.h"
+#include "pattern_registry.h"
+
+// Largest pattern state of a table - the high-water mark of its slots
+constexpr uint16_t maxStateSize(const PatternEntry* table, uint8_t size) {
+    uint16_t largest = 0;
+    for (uint8_t i = 0; i < size; i++) {
+        if (table[i].stateSize > largest) largest = table[i].stateSize;
+    }
+    return largest;
+}
+
+#define PATTERN_STATE_ALIGN 8
+#define NO_PATTERN 0xFF
+
+// High-water marks, and the slot sizes rounded up so the second slot stays aligned
+inline constexpr uint16_t BODY_STATE_HIGH_WATER = maxStateSize(bodyPatterns, NUM_PATTERNS);
+inline constexpr uint16_t MOUTH_STATE_HIGH_WATER = maxStateSize(mouthPatterns, NUM_MOUTH_PATTERNS);
+inline constexpr uint16_t BODY_SLOT_BYTES = (BODY_STATE_HIGH_WATER + PATTERN_STATE_ALIGN - 1) & ~(PATTERN_STATE_ALIGN - 1);
+inline constexpr uint16_t MOUTH_SLOT_BYTES = (MOUTH_STATE_HIGH_WATER + PATTERN_STATE_ALIGN - 1) & ~(PATTERN_STATE_ALIGN - 1);
+
+static_assert(2 * (BODY_SLOT_BYTES + MOUTH_SLOT_BYTES) <= PATTERN_ARENA_MAX_BYTES,
+              "Pattern state exceeds PATTERN_ARENA_MAX_BYTES");
+
+// Two slots for the state of one pattern table: the live pattern, and the
+// outgoing pattern while a transition runs. A pattern is entered the first
+// time it renders in a slot that another pattern (or none) held, so every
+// way of changing currentPattern/mouthPattern starts it from a clean state.
+class PatternArena {
+public:
+    PatternArena(const PatternEntry* table, uint8_t* storage, uint16_t slotBytes)
+        : table(table), storage(storage), slotBytes(slotBytes) {}
+
+    // Render one frame of a pattern in the live slot (enter() first if needed)
+    void render(uint8_t pattern);
+
+    // Transitions: the idle slot becomes the live one and back
+    void swapSlots() { live ^= 1; }
+
+    // Exit the pattern in the idle slot (its transition ended)
+    void releaseIdle() { release(live ^ 1); }
+
+    // Exit both patterns - they enter again on their next frame
+    void reset();
+
+    void* liveState() const { return storage + live * slotBytes; }
+    uint8_t getOwner(uint8_t slot) const { return owner[slot]; }
+    uint16_t getSlotBytes() const { return slotBytes; }
+
+private:
+    const PatternEntry* table;
+    uint8_t* storage;
+    uint16_t slotBytes;
+    uint8_t owner[2] = {NO_PATTERN, NO_PATTERN};
+    uint8_t live = 0;
+
+    void release(uint8_t slot);
+};
+
+extern PatternArena bodyArena;
+extern PatternArena mouthArena;
+
+// State of the pattern rendering right now
+template <typename T>
+T& bodyState() {
+    static_assert(sizeof(T) <= BODY_SLOT_BYTES && alignof(T) <= PATTERN_STATE_ALIGN, "State not in the registry");
+    return *static_cast<T*>(bodyArena.liveState());
+}
+
+template <typename T>
+T& mouthState() {
+    static_assert(sizeof(T) <= MOUTH_SLOT_BYTES && alignof(T) <= PATTERN_STATE_ALIGN, "State not in the registry");
+    return *static_cast<T*>(mouthArena.liveState());
+}
+
+// All body and mouth patterns start over on their next frame
+void resetPatternArenas();
+
+void printPatternArenaStatus();
+
+#endif
@@ -5,30 +5,6 @@
 
 PatternManager patternManager;
 
-// Pattern information table (matches pattern order in gPatterns)
-const PatternInfo PatternManager::patternInfos[] = {
-    {"Off",              CAT_OFF,      false},  // 0
-    {"Random Blocks",    CAT_ANIMATED, false},  // 1
-    {"Solid Color",      CAT_STATIC,   false},  // 2
-    {"Short Circuit",    CAT_SPECIAL,  false},  // 3
-    {"Confetti R/W",     CAT_ANIMATED, false},  // 4
-    {"Rainbow",          CAT_ANIMATED, false},  // 5
-    {"Rainbow Glitter",  CAT_ANIMATED, false},  // 6
-    {"Confetti",         CAT_ANIMATED, false},  // 7
-    {"Juggle",           CAT_ANIMATED, false},  // 8
-    {"Audio Sync",       CAT_AUDIO,    true},   // 9
-    {"Solid Flash",      CAT_ANIMATED, false},  // 10
-    {"Knight Rider",     CAT_ANIMATED, false},  // 11
-    {"Breathing",        CAT_ANIMATED, false},  // 12
-    {"Matrix Rain",      CAT_ANIMATED, false},  // 13
-    {"Strobe",           CAT_ANIMATED, false},  // 14
-    {"Audio VU Meter",   CAT_AUDIO,    true},   // 15
-    {"Custom Blocks",    CAT_ANIMATED, false},  // 16
-    {"Plasma",           CAT_ANIMATED, false},  // 17
-    {"Fire",             CAT_ANIMATED, false},  // 18
-    {"Twinkle",          CAT_ANIMATED, false},  // 19
-};
-
 void PatternManager::begin() {
     Serial.println(F("Pattern Manager initialized"));
     Serial.print(F("Available patterns: "));
@@ -60,14 +36,14 @@ uint8_t PatternManager::getCurrentPattern() {
 
 const char* PatternManager::getPatternName(uint8_t pattern) {
     if (pattern < getPatternCount()) {
-        return patternInfos[pattern].name;
+        return bodyPatterns[pattern].name;
     }
     return "Unknown";
 }
 
 PatternCategory PatternManager::getPatternCategory(uint8_t pattern) {
     if (pattern < getPatternCount()) {
-        return patternInfos[pattern].category;
+        return bodyPatterns[pattern].category;
     }
     return CAT_OFF;
 }
@@ -79,7 +55,7 @@ uint8_t PatternManager::getPatternCount() {
 uint8_t PatternManager::getNextInCategory(PatternCategory cat, uint8_t current) {
     for (uint8_t i = 1; i <= getPatternCount(); i++) {
         uint8_t idx = (current + i) % getPatternCount();
-        if (patternInfos[idx].category == cat) {
+        if (bodyPatterns[idx].category == cat) {
             return idx;
         }
     }
@@ -88,7 +64,7 @@ uint8_t PatternManager::getNextInCategory(PatternCategory cat, uint8_t current)
 
 bool PatternManager::isAudioPattern(uint8_t pattern) {
     if (pattern < getPatternCount()) {
-        return patternInfos[pattern].audioRequired;
+        return bodyPatterns[pattern].audioRequired;
     }
     return false;
 }
@@ -101,17 +77,11 @@ uint8_t PatternManager::getRandomPattern(bool excludeCurrent) {
     return pattern;
 }
 
+// v5.2: Category lists are built at compile time - no retry loop needed
 uint8_t PatternManager::getRandomAnimatedPattern() {
-    uint8_t attempts = 0;
-    uint8_t pattern;
-    do {
-        pattern = random8(1, getPatternCount());
-        attempts++;
-    } while (patternInfos[pattern].category != CAT_ANIMATED && attempts < 50);
-    return pattern;
+    return animatedBodyPatterns.index[random8(animatedBodyPatterns.count)];
 }
 
 uint8_t PatternManager::getRandomAudioPattern() {
-    // Only patterns 9 and 15 are audio patterns
-    return random8(2) == 0 ? 9 : 15;
+    return audioBodyPatterns.index[random8(audioBodyPatterns.count)];
 }
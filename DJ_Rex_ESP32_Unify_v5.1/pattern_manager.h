@@ -4,22 +4,7 @@
 
 #include "config.h"
 #include "globals.h"
-
-// Pattern categories
-enum PatternCategory {
-    CAT_OFF = 0,
-    CAT_STATIC,
-    CAT_ANIMATED,
-    CAT_AUDIO,
-    CAT_SPECIAL
-};
-
-// Pattern info structure
-struct PatternInfo {
-    const char* name;
-    PatternCategory category;
-    bool audioRequired;
-};
+#include "pattern_registry.h"  // v5.2: Pattern table and categories
 
 class PatternManager {
 public:
@@ -42,9 +27,6 @@ public:
     uint8_t getRandomPattern(bool excludeCurrent = true);
     uint8_t getRandomAnimatedPattern();
     uint8_t getRandomAudioPattern();
-
-private:
-    static const PatternInfo patternInfos[];
 };
 
 extern PatternManager patternManager;
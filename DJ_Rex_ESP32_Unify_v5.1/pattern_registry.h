@@ -0,0 +1,130 @@
+// pattern_registry.h - v5.2 Compile-Time Pattern Registry
+// Single source of truth for all body and mouth patterns. Pattern IDs are
+// the table indices (stored in settings, presets and playlists), so new
+// patterns must be appended at the end.
+#ifndef PATTERN_REGISTRY_H
+#define PATTERN_REGISTRY_H
+
+#include "config.h"
+#include "render_clock.h"
+#include "patterns_body.h"
+#include "patterns_mouth.h"
+
+// Pattern categories
+enum PatternCategory {
+    CAT_OFF = 0,
+    CAT_STATIC,
+    CAT_ANIMATED,
+    CAT_AUDIO,
+    CAT_SPECIAL
+};
+
+// Rough render cost per frame (see "perf" for measured values)
+enum PatternCost {
+    COST_LOW = 0,
+    COST_MEDIUM,
+    COST_HIGH
+};
+
+// v5.2: Pattern lifecycle. enter() runs when the pattern takes an arena
+// slot, render(frame) draws one frame, exit() runs when it gives the slot up
+// (see pattern_arena.h). stateSize sizes the arena at compile time.
+struct PatternEntry {
+    void (*render)(const FrameContext& frame);
+    void (*enter)();       // nullptr: the zero-filled state is the start state
+    void (*exit)();        // nullptr: nothing to clean up
+    uint16_t stateSize;    // sizeof the pattern's state, 0 if it has none
+    const char* name;
+    PatternCategory category;
+    bool audioRequired;
+    PatternCost cost;
+    bool demoEligible;
+};
+
+inline constexpr PatternEntry bodyPatterns[] = {
+    {LEDsOff, nullptr, nullptr, 0,                                            "LEDs Off",              CAT_OFF,      false, COST_LOW,    false},  // 0
+    {RandomBlocks, blinkPatternEnter, nullptr, sizeof(BlinkScheduler),        "Random Blocks",         CAT_ANIMATED, false, COST_MEDIUM, true},   // 1
+    {SolidColor, blinkPatternEnter, nullptr, sizeof(BlinkScheduler),          "Solid Color",           CAT_STATIC,   false, COST_LOW,    false},  // 2
+    {ShortCircuit, nullptr, nullptr, sizeof(ShortCircuitState),               "Short Circuit",         CAT_SPECIAL,  false, COST_LOW,    false},  // 3
+    {ConfettiRedWhite, nullptr, nullptr, 0,                                   "Confetti Red/White",    CAT_ANIMATED, false, COST_LOW,    false},  // 4
+    {rainbow, nullptr, nullptr, 0,                                            "Rainbow",               CAT_ANIMATED, false, COST_LOW,    true},   // 5
+    {rainbowWithGlitter, nullptr, nullptr, 0,                                 "Rainbow with Glitter",  CAT_ANIMATED, false, COST_LOW,    true},   // 6
+    {confetti, nullptr, nullptr, 0,                                           "Confetti",              CAT_ANIMATED, false, COST_LOW,    true},   // 7
+    {juggle, nullptr, nullptr, 0,                                             "Juggle",                CAT_ANIMATED, false, COST_MEDIUM, true},   // 8
+    {audioSync, nullptr, nullptr, 0,                                          "Audio Sync",            CAT_AUDIO,    true,  COST_MEDIUM, true},   // 9
+    {SolidFlash, nullptr, nullptr, sizeof(SolidFlashState),                   "Solid Flash",           CAT_ANIMATED, false, COST_LOW,    false},  // 10
+    {knightRider, nullptr, nullptr, sizeof(KnightRiderState),                 "Knight Rider",          CAT_ANIMATED, false, COST_LOW,    true},   // 11
+    {breathing, nullptr, nullptr, sizeof(BreathingState),                     "Breathing",             CAT_ANIMATED, false, COST_LOW,    true},   // 12
+    {matrixRain, nullptr, nullptr, sizeof(MatrixRainState),                   "Matrix Rain",           CAT_ANIMATED, false, COST_MEDIUM, true},   // 13
+    {strobePattern, nullptr, nullptr, sizeof(StrobeState),                    "Strobe",                CAT_ANIMATED, false, COST_LOW,    false},  // 14
+    {audioVUMeter, nullptr, nullptr, 0,                                       "Audio VU Meter",        CAT_AUDIO,    true,  COST_MEDIUM, true},   // 15
+    {CustomBlockSequence, blinkPatternEnter, nullptr, sizeof(BlinkScheduler), "Custom Block Sequence", CAT_ANIMATED, false, COST_MEDIUM, false},  // 16
+    // v5.0: New patterns
+    {plasmaPattern, nullptr, nullptr, sizeof(PlasmaState),                    "Plasma",                CAT_ANIMATED, false, COST_HIGH,   true},   // 17
+    {firePattern, nullptr, nullptr, sizeof(FireState),                        "Fire",                  CAT_ANIMATED, false, COST_MEDIUM, true},   // 18
+    {twinklePattern, nullptr, nullptr, 0,                                     "Twinkle",               CAT_ANIMATED, false, COST_LOW,    true},   // 19
+};
+
+inline constexpr PatternEntry mouthPatterns[] = {
+    {mouthOff, nullptr, nullptr, 0,                                           "Off",                   CAT_OFF,      false, COST_LOW,    false},  // 0
+    {mouthTalk, nullptr, nullptr, sizeof(MouthTalkState),                     "Talk",                  CAT_ANIMATED, false, COST_LOW,    true},   // 1
+    {mouthSmile, nullptr, nullptr, 0,                                         "Smile",                 CAT_STATIC,   false, COST_LOW,    true},   // 2
+    {mouthAudioReactive, nullptr, nullptr, 0,                                 "Audio Reactive",        CAT_AUDIO,    true,  COST_MEDIUM, true},   // 3
+    {mouthRainbow, nullptr, nullptr, sizeof(MouthRainbowState),               "Rainbow",               CAT_ANIMATED, false, COST_MEDIUM, true},   // 4
+    {mouthDebug, nullptr, nullptr, sizeof(MouthDebugState),                   "Debug",                 CAT_SPECIAL,  false, COST_LOW,    false},  // 5
+    {mouthWave, nullptr, nullptr, 0,                                          "Wave",                  CAT_ANIMATED, false, COST_MEDIUM, true},   // 6
+    {mouthPulse, nullptr, nullptr, 0,                                         "Pulse",                 CAT_ANIMATED, false, COST_MEDIUM, true},   // 7
+    {mouthVUMeterHoriz, nullptr, nullptr, 0,                                  "VU Meter Horiz",        CAT_AUDIO,    true,  COST_MEDIUM, false},  // 8
+    {mouthVUMeterVert, nullptr, nullptr, 0,                                   "VU Meter Vert",         CAT_AUDIO,    true,  COST_MEDIUM, false},  // 9
+    {mouthFrown, nullptr, nullptr, 0,                                         "Frown",                 CAT_STATIC,   false, COST_LOW,    false},  // 10
+    {mouthSparkle, nullptr, nullptr, 0,                                       "Sparkle",               CAT_ANIMATED, false, COST_LOW,    true},   // 11
+    // v5.0: New patterns
+    {mouthMatrix, nullptr, nullptr, sizeof(MouthMatrixState),                 "Matrix",                CAT_ANIMATED, false, COST_MEDIUM, true},   // 12
+    {mouthHeartbeat, nullptr, nullptr, sizeof(MouthHeartbeatState),           "Heartbeat",             CAT_ANIMATED, false, COST_MEDIUM, true},   // 13
+    {mouthSpectrum, nullptr, nullptr, 0,                                      "Spectrum",              CAT_AUDIO,    true,  COST_MEDIUM, true},   // 14
+};
+
+constexpr uint8_t NUM_PATTERNS = sizeof(bodyPatterns) / sizeof(bodyPatterns[0]);
+constexpr uint8_t NUM_MOUTH_PATTERNS = sizeof(mouthPatterns) / sizeof(mouthPatterns[0]);
+#define MAX_REGISTRY_PATTERNS 32
+
+static_assert(bodyPatterns[0].category == CAT_OFF, "Body pattern 0 must be Off");
+static_assert(mouthPatterns[0].category == CAT_OFF, "Mouth pattern 0 must be Off");
+static_assert(NUM_PATTERNS <= MAX_REGISTRY_PATTERNS && NUM_MOUTH_PATTERNS <= MAX_REGISTRY_PATTERNS,
+              "Raise MAX_REGISTRY_PATTERNS");
+
+// Pattern IDs selected by a compile-time filter
+struct PatternIndexList {
+    uint8_t count;
+    uint8_t index[MAX_REGISTRY_PATTERNS];
+};
+
+constexpr PatternIndexList buildCategoryList(const PatternEntry* table, uint8_t size, PatternCategory cat) {
+    PatternIndexList list = {};
+    for (uint8_t i = 0; i < size; i++) {
+        if (table[i].category == cat) {
+            list.index[list.count++] = i;
+        }
+    }
+    return list;
+}
+
+constexpr PatternIndexList buildDemoList(const PatternEntry* table, uint8_t size) {
+    PatternIndexList list = {};
+    for (uint8_t i = 0; i < size; i++) {
+        if (table[i].demoEligible) {
+            list.index[list.count++] = i;
+        }
+    }
+    return list;
+}
+
+inline constexpr PatternIndexList animatedBodyPatterns = buildCategoryList(bodyPatterns, NUM_PATTERNS, CAT_ANIMATED);
+inline constexpr PatternIndexList audioBodyPatterns = buildCategoryList(bodyPatterns, NUM_PATTERNS, CAT_AUDIO);
+inline constexpr PatternIndexList demoBodyPatterns = buildDemoList(bodyPatterns, NUM_PATTERNS);
+inline constexpr PatternIndexList demoMouthPatterns = buildDemoList(mouthPatterns, NUM_MOUTH_PATTERNS);
+
+static_assert(animatedBodyPatterns.count > 0 && audioBodyPatterns.count > 0, "Empty pattern category");
+static_assert(demoBodyPatterns.count > 0 && demoMouthPatterns.count > 0, "No demo patterns");
+
+#endif
@@ -1,157 +1,151 @@
 #include "patterns_body.h"
 #include "helpers.h"
 #include "audio.h"
+#include "audio_routing.h"
+#include "render_clock.h"
+#include "blink_scheduler.h"
+#include "geometry.h"
+#include "pattern_arena.h"
+#include <new>
 
-// Pattern list definition
-SimplePatternList gPatterns = {
-    LEDsOff,           // 0
-    RandomBlocks,      // 1
-    SolidColor,        // 2
-    ShortCircuit,      // 3
-    ConfettiRedWhite,  // 4
-    rainbow,           // 5
-    rainbowWithGlitter,// 6
-    confetti,          // 7
-    juggle,            // 8
-    audioSync,         // 9
-    SolidFlash,        // 10
-    knightRider,       // 11
-    breathing,         // 12
-    matrixRain,        // 13
-    strobePattern,     // 14
-    audioVUMeter,      // 15
-    CustomBlockSequence, // 16
-    // v5.0: New patterns
-    plasmaPattern,     // 17
-    firePattern,       // 18
-    twinklePattern     // 19
-};
+// v5.2: The pattern list lives in pattern_registry.h
 
-void LEDsOff() {
-    fadeToBlackBy(DJLEDs_Right, NUM_LEDS_PER_PANEL, 5);
-    fadeToBlackBy(DJLEDs_Middle, NUM_LEDS_PER_PANEL, 5);
-    fadeToBlackBy(DJLEDs_Left, NUM_LEDS_PER_PANEL, 5);
-    fadeToBlackBy(DJLEDs_Eyes, NUM_EYES, 5);
-    fadeToBlackBy(DJLEDs_Mouth, NUM_MOUTH_LEDS, 5);
-}
+// =====================================================
+// v5.2: Blinking side LEDs and blocks (Random Blocks, Solid Color mode 1,
+// Custom Block Sequence) keep a deadline scheduler as their pattern state
+// =====================================================
+
+typedef CRGB (*BlinkColorFunc)(uint8_t panel, uint8_t index);
 
-void RandomBlocks() {
+// Fades the LEDs that are off, then switches only the slots whose deadline
+// passed - in slot order, so colors and timings draw random numbers in the
+// same order as the per-LED polling did.
+static void runBlinkPattern(const FrameContext& frame, BlinkColorFunc sideColor, BlinkColorFunc blockColor,
+                            bool useBlinkRates) {
+    BlinkScheduler& blinkScheduler = bodyState<BlinkScheduler>();
+
+    uint8_t fade = fadeForFrame(fadeSpeed, frame.dt);
     for (uint8_t panel = 0; panel < 3; panel++) {
-        CRGB* leds = getLEDArray(panel);
-        
-        // Side LEDs
-        for (uint8_t i = 0; i < SIDE_LEDS_COUNT; i++) {
-            uint8_t timingIdx = getTimingIndex(panel, i);
-            
-            if (!LEDOn[timingIdx]) {
-                leds[i].fadeToBlackBy(fadeSpeed);
-            }
-            
-            if (millis() - LEDMillis[timingIdx] > IntervalTime[timingIdx]) {
-                if (!LEDOn[timingIdx]) {
-                    leds[i] = getSideLEDColor();
-                    IntervalTime[timingIdx] = getRandomTimingWithRate(sideMinTime, sideMaxTime, sideBlinkRate);
-                    LEDMillis[timingIdx] = millis();
-                    LEDOn[timingIdx] = 1;
-                } else {
-                    IntervalTime[timingIdx] = getRandomTimingWithRate(sideMinTime, sideMaxTime + 500, sideBlinkRate);
-                    LEDMillis[timingIdx] = millis();
-                    LEDOn[timingIdx] = 0;
-                }
+        blinkScheduler.fadeOffLeds(panel, getLEDArray(panel), fade);
+    }
+
+    uint32_t now = frame.now;
+    uint64_t due = blinkScheduler.collectDue(now);
+
+    while (due != 0) {
+        uint8_t slot = __builtin_ctzll(due);
+        due &= due - 1;
+
+        uint8_t panel = slot / BLINK_SLOTS_PER_PANEL;
+        uint8_t index = slot % BLINK_SLOTS_PER_PANEL;
+        bool isSide = index < SIDE_LEDS_COUNT;
+        bool turnOn = !blinkScheduler.isOn(slot);
+
+        if (turnOn) {
+            if (isSide) {
+                getLEDArray(panel)[index] = sideColor(panel, index);
+            } else {
+                uint8_t block = index - SIDE_LEDS_COUNT;
+                setBlock(panel, BlinkScheduler::blockStart(block), blockColor(panel, block));
             }
         }
-        
-        // Blocks
-        uint8_t blockStarts[3] = {BLOCK1_START, BLOCK2_START, BLOCK3_START};
-        
-        for (uint8_t blockNum = 0; blockNum < 3; blockNum++) {
-            uint8_t blockStart = blockStarts[blockNum];
-            uint8_t timingIdx = getTimingIndex(panel, blockStart);
-            uint8_t globalBlockIndex = getGlobalBlockIndex(panel, blockNum);
-            
-            if (!LEDOn[timingIdx]) {
-                fadeBlock(panel, blockStart, fadeSpeed);
-            }
-            
-            if (millis() - LEDMillis[timingIdx] > IntervalTime[timingIdx]) {
-                if (!LEDOn[timingIdx]) {
-                    CRGB blockColor = getBlockColor(globalBlockIndex);
-                    setBlock(panel, blockStart, blockColor);
-                    IntervalTime[timingIdx] = getRandomTimingWithRate(blockMinTime, blockMaxTime, blockBlinkRate);
-                    LEDMillis[timingIdx] = millis();
-                    LEDOn[timingIdx] = 1;
-                } else {
-                    IntervalTime[timingIdx] = getRandomTimingWithRate(blockMinTime, blockMaxTime + 500, blockBlinkRate);
-                    LEDMillis[timingIdx] = millis();
-                    LEDOn[timingIdx] = 0;
-                }
-            }
+
+        uint16_t minTime = isSide ? sideMinTime : blockMinTime;
+        uint16_t maxTime = (isSide ? sideMaxTime : blockMaxTime) + (turnOn ? 0 : 500);
+        uint16_t interval = useBlinkRates
+            ? getRandomTimingWithRate(minTime, maxTime, isSide ? sideBlinkRate : blockBlinkRate)
+            : getRandomTiming(minTime, maxTime);
+
+        blinkScheduler.schedule(slot, now, interval);
+        blinkScheduler.setOn(slot, turnOn);
+    }
+}
+
+// Initial deadlines: one draw per body LED keeps the random sequence of
+// earlier versions
+void blinkPatternEnter() {
+    BlinkScheduler* blinkScheduler = new (bodyArena.liveState()) BlinkScheduler();
+    blinkScheduler->reset();
+    for (byte x = 0; x < TOTAL_BODY_LEDS; x++) {
+        uint16_t interval = random16(3000);
+        int8_t slot = BlinkScheduler::slotForLed(x / NUM_LEDS_PER_PANEL, x % NUM_LEDS_PER_PANEL);
+        if (slot >= 0) {
+            blinkScheduler->schedule(slot, frameContext().now, interval);
         }
     }
 }
 
-void SolidColor() {
+static CRGB randomBlocksSideColor(uint8_t /*panel*/, uint8_t /*led*/) {
+    return getSideLEDColor();
+}
+
+static CRGB randomBlocksBlockColor(uint8_t panel, uint8_t block) {
+    return getBlockColor(getGlobalBlockIndex(panel, block));
+}
+
+// Solid Color picks its color once per frame
+static CRGB solidBlinkColor;
+
+static CRGB solidColorBlink(uint8_t /*panel*/, uint8_t /*index*/) {
+    return solidBlinkColor;
+}
+
+// Custom Block Sequence: block colors 0-8 mapping to requested pattern (1-9)
+static const uint8_t sequenceColors[9] = {
+    3,  // Block 0 (1) = White
+    2,  // Block 1 (2) = Blue
+    2,  // Block 2 (3) = Blue
+    3,  // Block 3 (4) = White
+    2,  // Block 4 (5) = Blue
+    2,  // Block 5 (6) = Blue
+    2,  // Block 6 (7) = Blue
+    2,  // Block 7 (8) = Blue
+    3   // Block 8 (9) = White
+};
+
+static CRGB customSequenceSideColor(uint8_t /*panel*/, uint8_t /*led*/) {
+    // Random between Red(0), Blue(2), White(3)
+    uint8_t colorChoice = random8(3);
+    uint8_t colorIndex = (colorChoice == 0) ? 0 : (colorChoice == 1) ? 2 : 3;
+    return getColor(colorIndex);
+}
+
+static CRGB customSequenceBlockColor(uint8_t panel, uint8_t block) {
+    return getColor(sequenceColors[getGlobalBlockIndex(panel, block)]);
+}
+
+void LEDsOff(const FrameContext& frame) {
+    uint8_t fade = fadeForFrame(5, frame.dt);
+    fadeToBlackBy(DJLEDs_Right, NUM_LEDS_PER_PANEL, fade);
+    fadeToBlackBy(DJLEDs_Middle, NUM_LEDS_PER_PANEL, fade);
+    fadeToBlackBy(DJLEDs_Left, NUM_LEDS_PER_PANEL, fade);
+    fadeToBlackBy(DJLEDs_Eyes, NUM_EYES, fade);
+    fadeToBlackBy(DJLEDs_Mouth, NUM_MOUTH_LEDS, fade);
+}
+
+void RandomBlocks(const FrameContext& frame) {
+    runBlinkPattern(frame, randomBlocksSideColor, randomBlocksBlockColor, true);
+}
+
+void SolidColor(const FrameContext& frame) {
     if (solidMode == 0) {
         CRGB color = getColor(solidColorIndex);
         fill_solid(DJLEDs_Right, NUM_LEDS_PER_PANEL, color);
         fill_solid(DJLEDs_Middle, NUM_LEDS_PER_PANEL, color);
         fill_solid(DJLEDs_Left, NUM_LEDS_PER_PANEL, color);
     } else {
-        CRGB selectedColor = getColor(solidColorIndex);
-        
-        for (uint8_t panel = 0; panel < 3; panel++) {
-            CRGB* leds = getLEDArray(panel);
-            
-            for (uint8_t i = 0; i < SIDE_LEDS_COUNT; i++) {
-                uint8_t timingIdx = getTimingIndex(panel, i);
-                
-                if (!LEDOn[timingIdx]) {
-                    leds[i].fadeToBlackBy(fadeSpeed);
-                }
-                
-                if (millis() - LEDMillis[timingIdx] > IntervalTime[timingIdx]) {
-                    if (!LEDOn[timingIdx]) {
-                        leds[i] = selectedColor;
-                        IntervalTime[timingIdx] = getRandomTiming(sideMinTime, sideMaxTime);
-                        LEDMillis[timingIdx] = millis();
-                        LEDOn[timingIdx] = 1;
-                    } else {
-                        IntervalTime[timingIdx] = getRandomTiming(sideMinTime, sideMaxTime + 500);
-                        LEDMillis[timingIdx] = millis();
-                        LEDOn[timingIdx] = 0;
-                    }
-                }
-            }
-            
-            uint8_t blockStarts[3] = {BLOCK1_START, BLOCK2_START, BLOCK3_START};
-            
-            for (uint8_t blockNum = 0; blockNum < 3; blockNum++) {
-                uint8_t blockStart = blockStarts[blockNum];
-                uint8_t timingIdx = getTimingIndex(panel, blockStart);
-                
-                if (!LEDOn[timingIdx]) {
-                    fadeBlock(panel, blockStart, fadeSpeed);
-                }
-                
-                if (millis() - LEDMillis[timingIdx] > IntervalTime[timingIdx]) {
-                    if (!LEDOn[timingIdx]) {
-                        setBlock(panel, blockStart, selectedColor);
-                        IntervalTime[timingIdx] = getRandomTiming(blockMinTime, blockMaxTime);
-                        LEDMillis[timingIdx] = millis();
-                        LEDOn[timingIdx] = 1;
-                    } else {
-                        IntervalTime[timingIdx] = getRandomTiming(blockMinTime, blockMaxTime + 500);
-                        LEDMillis[timingIdx] = millis();
-                        LEDOn[timingIdx] = 0;
-                    }
-                }
-            }
-        }
+        solidBlinkColor = getColor(solidColorIndex);
+        runBlinkPattern(frame, solidColorBlink, solidColorBlink, false);
     }
 }
 
-void ShortCircuit() {
-    if (millis() - FadeMillis > FadeInterval) {
+void ShortCircuit(const FrameContext& frame) {
+    ShortCircuitState& state = bodyState<ShortCircuitState>();
+
+    // At most one burst per reference frame while the interval is short
+    uint16_t interval = max(state.interval, (uint16_t)REFERENCE_FRAME_MS);
+    uint16_t bursts = elapsedSteps(state.lastBurst, frame.now, interval);
+    for (; bursts > 0 && state.bursts < DECAYTIME; bursts--) {
         CRGB sparkColor = getColor(shortColorIndex);
         
         if (random8() < 150) {
@@ -164,177 +158,178 @@ void ShortCircuit() {
             DJLEDs_Left[random16(NUM_LEDS_PER_PANEL)] += sparkColor;
         }
         
-        DecayTime--;
-        FadeInterval += 4;
-        FadeMillis = millis();
+        state.bursts++;
+        state.interval += 4;
     }
 
-    if (DecayTime == 0) {
-        DecayTime = DECAYTIME;
+    if (state.bursts >= DECAYTIME) {
+        state.bursts = 0;
         if (!demoMode) {       
             currentPattern = 0;
         }
-        FadeInterval = 0;
+        state.interval = 0;
     }
     
-    fadeToBlackBy(DJLEDs_Right, NUM_LEDS_PER_PANEL, fadeSpeed);
-    fadeToBlackBy(DJLEDs_Middle, NUM_LEDS_PER_PANEL, fadeSpeed);
-    fadeToBlackBy(DJLEDs_Left, NUM_LEDS_PER_PANEL, fadeSpeed);
+    uint8_t fade = fadeForFrame(fadeSpeed, frame.dt);
+    fadeToBlackBy(DJLEDs_Right, NUM_LEDS_PER_PANEL, fade);
+    fadeToBlackBy(DJLEDs_Middle, NUM_LEDS_PER_PANEL, fade);
+    fadeToBlackBy(DJLEDs_Left, NUM_LEDS_PER_PANEL, fade);
 }
 
-void ConfettiRedWhite() {
-    fadeToBlackBy(DJLEDs_Right, NUM_LEDS_PER_PANEL, fadeSpeed);
-    fadeToBlackBy(DJLEDs_Middle, NUM_LEDS_PER_PANEL, fadeSpeed);
-    fadeToBlackBy(DJLEDs_Left, NUM_LEDS_PER_PANEL, fadeSpeed);
+void ConfettiRedWhite(const FrameContext& frame) {
+    uint8_t fade = fadeForFrame(fadeSpeed, frame.dt);
+    fadeToBlackBy(DJLEDs_Right, NUM_LEDS_PER_PANEL, fade);
+    fadeToBlackBy(DJLEDs_Middle, NUM_LEDS_PER_PANEL, fade);
+    fadeToBlackBy(DJLEDs_Left, NUM_LEDS_PER_PANEL, fade);
 
     CRGB color1 = getColor(confettiColor1);
     CRGB color2 = getColor(confettiColor2);
     
-    if (random8() < 128) {
-        DJLEDs_Right[random16(NUM_LEDS_PER_PANEL)] += color1;
-        DJLEDs_Middle[random16(NUM_LEDS_PER_PANEL)] += color1;
-        DJLEDs_Left[random16(NUM_LEDS_PER_PANEL)] += color1;
-    } else {
-        DJLEDs_Right[random16(NUM_LEDS_PER_PANEL)] += color2;
-        DJLEDs_Middle[random16(NUM_LEDS_PER_PANEL)] += color2;
-        DJLEDs_Left[random16(NUM_LEDS_PER_PANEL)] += color2;
+    // One spark per panel and reference frame
+    for (uint8_t sparks = randomEvents(256, frame.dt); sparks > 0; sparks--) {
+        CRGB color = (random8() < 128) ? color1 : color2;
+        DJLEDs_Right[random16(NUM_LEDS_PER_PANEL)] += color;
+        DJLEDs_Middle[random16(NUM_LEDS_PER_PANEL)] += color;
+        DJLEDs_Left[random16(NUM_LEDS_PER_PANEL)] += color;
     }
 }
 
-void rainbow() {
+void rainbow(const FrameContext& /*frame*/) {
     fill_rainbow(DJLEDs_Right, NUM_LEDS_PER_PANEL, gHue, 7);
     fill_rainbow(DJLEDs_Middle, NUM_LEDS_PER_PANEL, gHue, 7);
     fill_rainbow(DJLEDs_Left, NUM_LEDS_PER_PANEL, gHue, 7);
 }
 
-void rainbowWithGlitter() {
-    rainbow();
-    addGlitter(80);
+void rainbowWithGlitter(const FrameContext& frame) {
+    rainbow(frame);
+    addGlitter(80, frame.dt);
 }
 
-void addGlitter(fract8 chanceOfGlitter) {
-    if (random8() < chanceOfGlitter) {
+void addGlitter(fract8 chanceOfGlitter, uint16_t dt) {
+    for (uint8_t n = randomEvents(chanceOfGlitter, dt); n > 0; n--) {
         DJLEDs_Right[random16(NUM_LEDS_PER_PANEL)] += CRGB::White;
     }
-    if (random8() < chanceOfGlitter) {
+    for (uint8_t n = randomEvents(chanceOfGlitter, dt); n > 0; n--) {
         DJLEDs_Middle[random16(NUM_LEDS_PER_PANEL)] += CRGB::White;
     }
-    if (random8() < chanceOfGlitter) {
+    for (uint8_t n = randomEvents(chanceOfGlitter, dt); n > 0; n--) {
         DJLEDs_Left[random16(NUM_LEDS_PER_PANEL)] += CRGB::White;
     }
 }
 
-void confetti() {
-    fadeToBlackBy(DJLEDs_Right, NUM_LEDS_PER_PANEL, fadeSpeed);
-    fadeToBlackBy(DJLEDs_Middle, NUM_LEDS_PER_PANEL, fadeSpeed);
-    fadeToBlackBy(DJLEDs_Left, NUM_LEDS_PER_PANEL, fadeSpeed);
-
-    DJLEDs_Right[random16(NUM_LEDS_PER_PANEL)] += CHSV(gHue + random8(64), 200, 255);
-    DJLEDs_Middle[random16(NUM_LEDS_PER_PANEL)] += CHSV(gHue + random8(64), 200, 255);
-    DJLEDs_Left[random16(NUM_LEDS_PER_PANEL)] += CHSV(gHue + random8(64), 200, 255);
+void confetti(const FrameContext& frame) {
+    uint8_t fade = fadeForFrame(fadeSpeed, frame.dt);
+    fadeToBlackBy(DJLEDs_Right, NUM_LEDS_PER_PANEL, fade);
+    fadeToBlackBy(DJLEDs_Middle, NUM_LEDS_PER_PANEL, fade);
+    fadeToBlackBy(DJLEDs_Left, NUM_LEDS_PER_PANEL, fade);
+
+    // One spark per panel and reference frame
+    for (uint8_t sparks = randomEvents(256, frame.dt); sparks > 0; sparks--) {
+        DJLEDs_Right[random16(NUM_LEDS_PER_PANEL)] += CHSV(gHue + random8(64), 200, 255);
+        DJLEDs_Middle[random16(NUM_LEDS_PER_PANEL)] += CHSV(gHue + random8(64), 200, 255);
+        DJLEDs_Left[random16(NUM_LEDS_PER_PANEL)] += CHSV(gHue + random8(64), 200, 255);
+    }
 }
 
-void juggle() {
-    fadeToBlackBy(DJLEDs_Right, NUM_LEDS_PER_PANEL, 20);
-    fadeToBlackBy(DJLEDs_Middle, NUM_LEDS_PER_PANEL, 20);
-    fadeToBlackBy(DJLEDs_Left, NUM_LEDS_PER_PANEL, 20);
+void juggle(const FrameContext& frame) {
+    uint8_t fade = fadeForFrame(20, frame.dt);
+    fadeToBlackBy(DJLEDs_Right, NUM_LEDS_PER_PANEL, fade);
+    fadeToBlackBy(DJLEDs_Middle, NUM_LEDS_PER_PANEL, fade);
+    fadeToBlackBy(DJLEDs_Left, NUM_LEDS_PER_PANEL, fade);
+
+    // v5.2: Dot speeds follow the detected tempo (unchanged at 120 BPM or without a lock)
+    uint16_t bpm10 = frameAudio.beatLocked ? frameAudio.bpm10 : 1200;
 
     byte dothue = 0;
     for (int i = 0; i < 8; i++) {
-        DJLEDs_Right[beatsin16(i + 7, 0, NUM_LEDS_PER_PANEL - 1)] |= CHSV(dothue, 200, 255);
-        DJLEDs_Middle[beatsin16(i + 7, 0, NUM_LEDS_PER_PANEL - 1)] |= CHSV(dothue, 200, 255);
-        DJLEDs_Left[beatsin16(i + 7, 0, NUM_LEDS_PER_PANEL - 1)] |= CHSV(dothue, 200, 255);
+        accum88 dotBpm = ((uint32_t)(i + 7) * bpm10 * 256) / 1200;
+        DJLEDs_Right[beatsin16(dotBpm, 0, NUM_LEDS_PER_PANEL - 1)] |= CHSV(dothue, 200, 255);
+        DJLEDs_Middle[beatsin16(dotBpm, 0, NUM_LEDS_PER_PANEL - 1)] |= CHSV(dothue, 200, 255);
+        DJLEDs_Left[beatsin16(dotBpm, 0, NUM_LEDS_PER_PANEL - 1)] |= CHSV(dothue, 200, 255);
         dothue += 32;
     }
 }
 
-void audioSync() {
-    int audio = processAudioLevel();
-    
-    // Check audio mode for body panels
-    if (audioMode == AUDIO_OFF || audioMode == AUDIO_MOUTH_ONLY) {
-        // Clear panels and return
-        fadeToBlackBy(DJLEDs_Right, NUM_LEDS_PER_PANEL, 20);
-        fadeToBlackBy(DJLEDs_Middle, NUM_LEDS_PER_PANEL, 20);
-        fadeToBlackBy(DJLEDs_Left, NUM_LEDS_PER_PANEL, 20);
-        return;
-    }
-    
-    int numLEDs = map(audio, 0, audioThreshold, 0, SIDE_LEDS_COUNT);
-    numLEDs = constrain(numLEDs, 0, SIDE_LEDS_COUNT);
-    
-    fadeToBlackBy(DJLEDs_Right, NUM_LEDS_PER_PANEL, 20);
-    fadeToBlackBy(DJLEDs_Middle, NUM_LEDS_PER_PANEL, 20);
-    fadeToBlackBy(DJLEDs_Left, NUM_LEDS_PER_PANEL, 20);
+void audioSync(const FrameContext& frame) {
+    // v5.2: Each panel's sides and blocks follow their routed zone value
+    // (0-255, 0 when the zone is not routed or below the noise gate)
+    uint8_t fade = fadeForFrame(20, frame.dt);
+    fadeToBlackBy(DJLEDs_Right, NUM_LEDS_PER_PANEL, fade);
+    fadeToBlackBy(DJLEDs_Middle, NUM_LEDS_PER_PANEL, fade);
+    fadeToBlackBy(DJLEDs_Left, NUM_LEDS_PER_PANEL, fade);
     
     CRGB audioColor = CHSV(gHue, 255, 255);
     
     // Light up side LEDs
-    for (int i = 0; i < numLEDs; i++) {
-        DJLEDs_Right[i] = audioColor;
-        DJLEDs_Middle[i] = audioColor;
-        DJLEDs_Left[i] = audioColor;
+    for (int panel = 0; panel < 3; panel++) {
+        CRGB* leds = getLEDArray(panel);
+        int numLEDs = (audioRouter.getLevel(sideZone(panel)) * SIDE_LEDS_COUNT) / 255;
+        for (int i = 0; i < numLEDs; i++) {
+            leds[i] = audioColor;
+        }
     }
     
-    // Add blocks if audio mode includes all body
-    if (audioMode == AUDIO_BODY_ALL || audioMode == AUDIO_ALL) {
-        if (audio > audioThreshold * 0.7) {
-            for (int panel = 0; panel < 3; panel++) {
-                if (audio > audioThreshold * 0.9) {
-                    setBlock(panel, BLOCK3_START, audioColor);
-                }
-                if (audio > audioThreshold * 0.8) {
-                    setBlock(panel, BLOCK2_START, audioColor);
-                }
-                setBlock(panel, BLOCK1_START, audioColor);
+    // Add blocks on loud passages
+    for (int panel = 0; panel < 3; panel++) {
+        uint8_t blockLevel = audioRouter.getLevel(blockZone(panel));
+        if (blockLevel > 178) { // 70%
+            if (blockLevel > 229) { // 90%
+                setBlock(panel, BLOCK3_START, audioColor);
+            }
+            if (blockLevel > 204) { // 80%
+                setBlock(panel, BLOCK2_START, audioColor);
             }
+            setBlock(panel, BLOCK1_START, audioColor);
         }
     }
     
     // Add sparkle on high levels
-    if (audio > audioThreshold * 0.8) {
-        for (int panel = 0; panel < 3; panel++) {
+    for (int panel = 0; panel < 3; panel++) {
+        if (audioRouter.getLevel(sideZone(panel)) > 204) {
             CRGB* leds = getLEDArray(panel);
-            if (random8() < 50) {
+            for (uint8_t n = randomEvents(50, frame.dt); n > 0; n--) {
                 leds[random8(SIDE_LEDS_COUNT)] += CRGB::White;
             }
         }
     }
 }
 
-void SolidFlash() {
+void SolidFlash(const FrameContext& frame) {
+    SolidFlashState& state = bodyState<SolidFlashState>();
     uint16_t flashInterval = map(flashSpeed, 1, 10, 1000, 100);
     
-    if (millis() - lastFlashTime >= flashInterval) {
-        lastFlashTime = millis();
-        flashState = !flashState;
+    // An odd number of toggles since the last frame flips the flash
+    if (elapsedSteps(state.lastToggle, frame.now, flashInterval) & 1) {
+        state.on = !state.on;
     }
     
-    CRGB displayColor = flashState ? getColor(flashColorIndex) : CRGB::Black;
+    CRGB displayColor = state.on ? getColor(flashColorIndex) : CRGB::Black;
     
     fill_solid(DJLEDs_Right, NUM_LEDS_PER_PANEL, displayColor);
     fill_solid(DJLEDs_Middle, NUM_LEDS_PER_PANEL, displayColor);
     fill_solid(DJLEDs_Left, NUM_LEDS_PER_PANEL, displayColor);
 }
 
-void knightRider() {
-    fadeToBlackBy(DJLEDs_Right, NUM_LEDS_PER_PANEL, 20);
-    fadeToBlackBy(DJLEDs_Middle, NUM_LEDS_PER_PANEL, 20);
-    fadeToBlackBy(DJLEDs_Left, NUM_LEDS_PER_PANEL, 20);
+void knightRider(const FrameContext& frame) {
+    uint8_t fade = fadeForFrame(20, frame.dt);
+    fadeToBlackBy(DJLEDs_Right, NUM_LEDS_PER_PANEL, fade);
+    fadeToBlackBy(DJLEDs_Middle, NUM_LEDS_PER_PANEL, fade);
+    fadeToBlackBy(DJLEDs_Left, NUM_LEDS_PER_PANEL, fade);
     
-    knightInterval = map(effectSpeed, 1, 255, 200, 30);
+    KnightRiderState& state = bodyState<KnightRiderState>();
+    uint16_t knightInterval = map(effectSpeed, 1, 255, 200, 30);
     
-    if (millis() - knightMillis > knightInterval) {
-        knightMillis = millis();
-        if (knightDir) {
-            knightPos++;
-            if (knightPos >= SIDE_LEDS_COUNT - 1) knightDir = false;
+    for (uint16_t steps = elapsedSteps(state.lastStep, frame.now, knightInterval); steps > 0; steps--) {
+        if (!state.reverse) {
+            state.pos++;
+            if (state.pos >= SIDE_LEDS_COUNT - 1) state.reverse = true;
         } else {
-            knightPos--;
-            if (knightPos == 0) knightDir = true;
+            state.pos--;
+            if (state.pos == 0) state.reverse = false;
         }
     }
     
+    uint8_t knightPos = state.pos;
     CRGB color = getColor(knightColorIndex);
     DJLEDs_Right[knightPos] = color;
     DJLEDs_Middle[knightPos] = color;
@@ -352,106 +347,103 @@ void knightRider() {
     }
 }
 
-void breathing() {
+void breathing(const FrameContext& frame) {
+    BreathingState& state = bodyState<BreathingState>();
     uint16_t speed = map(effectSpeed, 1, 255, 10, 2);
     
-    if (millis() - breathingMillis > speed) {
-        breathingMillis = millis();
-        if (breathingUp) {
-            breathingBright += 2;
-            if (breathingBright >= 255) { breathingBright = 255; breathingUp = false; }
+    for (uint16_t steps = elapsedSteps(state.lastStep, frame.now, speed); steps > 0; steps--) {
+        if (!state.falling) {
+            state.bright = qadd8(state.bright, 2);
+            if (state.bright == 255) state.falling = true;
         } else {
-            breathingBright -= 2;
-            if (breathingBright <= 10) { breathingBright = 10; breathingUp = true; }
+            state.bright -= 2;
+            if (state.bright <= 10) { state.bright = 10; state.falling = false; }
         }
     }
     
     CRGB color = getColor(breathingColorIndex);
-    color.fadeToBlackBy(255 - breathingBright);
+    color.fadeToBlackBy(255 - state.bright);
     
     fill_solid(DJLEDs_Right, NUM_LEDS_PER_PANEL, color);
     fill_solid(DJLEDs_Middle, NUM_LEDS_PER_PANEL, color);
     fill_solid(DJLEDs_Left, NUM_LEDS_PER_PANEL, color);
 }
 
-void matrixRain() {
+void matrixRain(const FrameContext& frame) {
+    MatrixRainState& state = bodyState<MatrixRainState>();
     uint16_t speed = map(effectSpeed, 1, 255, 150, 20);
     
-    if (millis() - matrixMillis > speed) {
-        matrixMillis = millis();
+    uint16_t steps = elapsedSteps(state.lastStep, frame.now, speed);
+    if (steps == 0) return;
+
+    for (int panel = 0; panel < 3; panel++) {
+        CRGB* leds = getLEDArray(panel);
+        uint8_t* bright = state.bright[panel];
         
-        for (int panel = 0; panel < 3; panel++) {
-            CRGB* leds = getLEDArray(panel);
-            
+        // Steps the frame missed move the drops without drawing them
+        for (uint16_t step = 1; step <= steps; step++) {
             for (int led = SIDE_LEDS_COUNT - 1; led > 0; led--) {
-                matrixDrops[panel][led] = matrixDrops[panel][led - 1];
-                matrixBright[panel][led] = matrixBright[panel][led - 1];
-            }
-            
-            if (random8() < 50) {
-                matrixDrops[panel][0] = 0;
-                matrixBright[panel][0] = 255;
-            } else {
-                matrixDrops[panel][0] = 255;
-                matrixBright[panel][0] = 0;
+                bright[led] = bright[led - 1];
             }
             
-            for (int i = 0; i < SIDE_LEDS_COUNT; i++) leds[i] = CRGB::Black;
+            bright[0] = (random8() < 50) ? 255 : 0;
             
-            CRGB color = getColor(matrixColorIndex);
-            for (int led = 0; led < SIDE_LEDS_COUNT; led++) {
-                if (matrixDrops[panel][led] == 0) {
-                    leds[led] = color;
-                    leds[led].fadeToBlackBy(255 - matrixBright[panel][led]);
-                    if (matrixBright[panel][led] > 30) {
-                        matrixBright[panel][led] -= 30;
-                    } else {
-                        matrixDrops[panel][led] = 255;
-                        matrixBright[panel][led] = 0;
+            if (step == steps) {
+                for (int i = 0; i < SIDE_LEDS_COUNT; i++) leds[i] = CRGB::Black;
+                
+                CRGB color = getColor(matrixColorIndex);
+                for (int led = 0; led < SIDE_LEDS_COUNT; led++) {
+                    if (bright[led] > 0) {
+                        leds[led] = color;
+                        leds[led].fadeToBlackBy(255 - bright[led]);
                     }
                 }
             }
             
-            for (int i = SIDE_LEDS_COUNT; i < NUM_LEDS_PER_PANEL; i++) leds[i] = CRGB::Black;
+            for (int led = 0; led < SIDE_LEDS_COUNT; led++) {
+                bright[led] = (bright[led] > 30) ? bright[led] - 30 : 0;
+            }
         }
+        
+        for (int i = SIDE_LEDS_COUNT; i < NUM_LEDS_PER_PANEL; i++) leds[i] = CRGB::Black;
     }
 }
 
-void strobePattern() {
-    strobeInterval = map(effectSpeed, 1, 255, 300, 50);
+void strobePattern(const FrameContext& frame) {
+    StrobeState& state = bodyState<StrobeState>();
+    uint16_t strobeInterval = map(effectSpeed, 1, 255, 300, 50);
     
-    if (millis() - strobeMillis > strobeInterval) {
-        strobeMillis = millis();
-        strobeState = !strobeState;
+    if (elapsedSteps(state.lastToggle, frame.now, strobeInterval) & 1) {
+        state.on = !state.on;
     }
     
-    CRGB color = strobeState ? getColor(strobeColorIndex) : CRGB::Black;
+    CRGB color = state.on ? getColor(strobeColorIndex) : CRGB::Black;
     
     fill_solid(DJLEDs_Right, NUM_LEDS_PER_PANEL, color);
     fill_solid(DJLEDs_Middle, NUM_LEDS_PER_PANEL, color);
     fill_solid(DJLEDs_Left, NUM_LEDS_PER_PANEL, color);
 }
 
-void audioVUMeter() {
-    int audio = processAudioLevel();
-    
-    // Check audio mode
-    if (audioMode == AUDIO_OFF || audioMode == AUDIO_MOUTH_ONLY) {
-        // Clear panels and return
-        fill_solid(DJLEDs_Right, NUM_LEDS_PER_PANEL, CRGB::Black);
-        fill_solid(DJLEDs_Middle, NUM_LEDS_PER_PANEL, CRGB::Black);
-        fill_solid(DJLEDs_Left, NUM_LEDS_PER_PANEL, CRGB::Black);
-        return;
-    }
-    
+void audioVUMeter(const FrameContext& frame) {
+    // v5.2: Spectrum VU meter - Left panel shows the low bands, Middle the mids, Right the highs.
+    // A panel lights only when its sides are routed; its blocks flash on their zone value.
     fill_solid(DJLEDs_Right, NUM_LEDS_PER_PANEL, CRGB::Black);
     fill_solid(DJLEDs_Middle, NUM_LEDS_PER_PANEL, CRGB::Black);
     fill_solid(DJLEDs_Left, NUM_LEDS_PER_PANEL, CRGB::Black);
     
-    int vuLevel = constrain(map(averageAudio, 0, audioThreshold, 0, SIDE_LEDS_COUNT), 0, SIDE_LEDS_COUNT);
-    
     for (int panel = 0; panel < 3; panel++) {
+        if (!audioRouter.isRouted(sideZone(panel))) continue;
         CRGB* leds = getLEDArray(panel);
+
+        // Loudest band of this panel's third of the spectrum (panel 2 = Left = lowest)
+        uint8_t firstBand = (2 - panel) * SPECTRUM_BANDS / 3;
+        uint8_t lastBand = (3 - panel) * SPECTRUM_BANDS / 3;
+        uint8_t level = 0;
+        for (uint8_t b = firstBand; b < lastBand; b++) {
+            level = max(level, frameAudio.bands[b]);
+        }
+
+        int vuLevel = scale8(level, SIDE_LEDS_COUNT + 1);
         for (int i = 0; i < vuLevel; i++) {
             int ledIdx = SIDE_LEDS_COUNT - 1 - i;
             CRGB color = (i < SIDE_LEDS_COUNT/3) ? CRGB::Green : 
@@ -459,161 +451,97 @@ void audioVUMeter() {
             leds[ledIdx] = color;
         }
         
-        // Peak indicators on blocks if mode allows
-        if ((audioMode == AUDIO_BODY_ALL || audioMode == AUDIO_ALL) && averageAudio > audioThreshold * 0.8) {
+        // Peak indicators on blocks
+        if (audioRouter.getLevel(blockZone(panel)) > 204) {
             setBlock(panel, BLOCK1_START, CRGB::White);
             setBlock(panel, BLOCK2_START, CRGB::White);
             setBlock(panel, BLOCK3_START, CRGB::White);
         }
-    }
-    
-    if (audio > audioThreshold * 0.9 && random8() < 100) {
-        getLEDArray(random8(3))[random8(SIDE_LEDS_COUNT)] += CRGB::White;
-    }
-}
 
-void CustomBlockSequence() {
-    // Define the block colors for the sequence
-    // 0-8 mapping to requested pattern (1-9)
-    static const uint8_t sequenceColors[9] = {
-        3,  // Block 0 (1) = White
-        2,  // Block 1 (2) = Blue
-        2,  // Block 2 (3) = Blue
-        3,  // Block 3 (4) = White
-        2,  // Block 4 (5) = Blue
-        2,  // Block 5 (6) = Blue
-        2,  // Block 6 (7) = Blue
-        2,  // Block 7 (8) = Blue
-        3   // Block 8 (9) = White
-    };
-    
-    // Handle side LEDs with Red, White, Blue random
-    for (uint8_t panel = 0; panel < 3; panel++) {
-        CRGB* leds = getLEDArray(panel);
-        
-        // Side LEDs - Random Red/White/Blue
-        for (uint8_t i = 0; i < SIDE_LEDS_COUNT; i++) {
-            uint8_t timingIdx = getTimingIndex(panel, i);
-            
-            if (!LEDOn[timingIdx]) {
-                leds[i].fadeToBlackBy(fadeSpeed);
-            }
-            
-            if (millis() - LEDMillis[timingIdx] > IntervalTime[timingIdx]) {
-                if (!LEDOn[timingIdx]) {
-                    // Random between Red(0), Blue(2), White(3)
-                    uint8_t colorChoice = random8(3);
-                    uint8_t colorIndex = (colorChoice == 0) ? 0 : (colorChoice == 1) ? 2 : 3;
-                    leds[i] = getColor(colorIndex);
-                    IntervalTime[timingIdx] = getRandomTimingWithRate(sideMinTime, sideMaxTime, sideBlinkRate);
-                    LEDMillis[timingIdx] = millis();
-                    LEDOn[timingIdx] = 1;
-                } else {
-                    IntervalTime[timingIdx] = getRandomTimingWithRate(sideMinTime, sideMaxTime + 500, sideBlinkRate);
-                    LEDMillis[timingIdx] = millis();
-                    LEDOn[timingIdx] = 0;
-                }
-            }
-        }
-        
-        // Handle blocks with the custom sequence
-        uint8_t blockStarts[3] = {BLOCK1_START, BLOCK2_START, BLOCK3_START};
-        
-        for (uint8_t blockNum = 0; blockNum < 3; blockNum++) {
-            uint8_t blockStart = blockStarts[blockNum];
-            uint8_t timingIdx = getTimingIndex(panel, blockStart);
-            uint8_t globalBlockIndex = getGlobalBlockIndex(panel, blockNum);
-            
-            if (!LEDOn[timingIdx]) {
-                fadeBlock(panel, blockStart, fadeSpeed);
-            }
-            
-            if (millis() - LEDMillis[timingIdx] > IntervalTime[timingIdx]) {
-                if (!LEDOn[timingIdx]) {
-                    // Use the sequence color for this block
-                    CRGB blockColor = getColor(sequenceColors[globalBlockIndex]);
-                    setBlock(panel, blockStart, blockColor);
-                    IntervalTime[timingIdx] = getRandomTimingWithRate(blockMinTime, blockMaxTime, blockBlinkRate);
-                    LEDMillis[timingIdx] = millis();
-                    LEDOn[timingIdx] = 1;
-                } else {
-                    IntervalTime[timingIdx] = getRandomTimingWithRate(blockMinTime, blockMaxTime + 500, blockBlinkRate);
-                    LEDMillis[timingIdx] = millis();
-                    LEDOn[timingIdx] = 0;
-                }
+        if (level > 230) {
+            for (uint8_t n = randomEvents(100, frame.dt); n > 0; n--) {
+                leds[random8(SIDE_LEDS_COUNT)] += CRGB::White;
             }
         }
     }
 }
 
+void CustomBlockSequence(const FrameContext& frame) {
+    runBlinkPattern(frame, customSequenceSideColor, customSequenceBlockColor, true);
+}
+
 // =====================================================
 // v5.0 NEW PATTERNS
 // =====================================================
 
-void plasmaPattern() {
-    // Flowing plasma effect using sin waves
-    static uint16_t plasmaTime = 0;
-    plasmaTime += effectSpeed / 4;
-
-    for (int panel = 0; panel < 3; panel++) {
-        CRGB* leds = getLEDArray(panel);
+void plasmaPattern(const FrameContext& frame) {
+    // v5.2: Flowing plasma over the physical panel layout, so the waves run
+    // continuously across all three panels instead of restarting per panel
+    PlasmaState& state = bodyState<PlasmaState>();
+    state.time += advanceBy(state.rest, frame.dt, effectSpeed / 4);
+    uint16_t plasmaTime = state.time;
 
-        for (int i = 0; i < NUM_LEDS_PER_PANEL; i++) {
-            // Multiple overlapping sin waves for plasma effect
-            uint8_t hue = sin8(i * 15 + plasmaTime / 2) +
-                          sin8(i * 7 - plasmaTime / 3) +
-                          sin8(panel * 50 + plasmaTime / 4);
+    renderCoordinates(ZONE_BODY, [plasmaTime](const LedPixel& p) {
+        // Multiple overlapping sin waves for plasma effect
+        uint8_t hue = sin8(p.x + plasmaTime / 2) +
+                      sin8(p.y * 2 - plasmaTime / 3) +
+                      sin8(p.radius * 3 + plasmaTime / 4);
 
-            uint8_t brightness = sin8(i * 10 + plasmaTime / 5) / 2 + 127;
+        uint8_t brightness = sin8(p.x / 2 + p.y + plasmaTime / 5) / 2 + 127;
 
-            leds[i] = CHSV(hue + gHue, 255, brightness);
-        }
-    }
+        return CRGB(CHSV(hue + gHue, 255, brightness));
+    });
 }
 
-void firePattern() {
+void firePattern(const FrameContext& frame) {
     // Fire simulation effect
-    static uint8_t heat[3][NUM_LEDS_PER_PANEL];
+    // v5.2: The simulation steps once per reference frame
+    FireState& state = bodyState<FireState>();
+    uint16_t steps = elapsedSteps(state.lastStep, frame.now, REFERENCE_FRAME_MS);
 
     for (int panel = 0; panel < 3; panel++) {
         CRGB* leds = getLEDArray(panel);
+        uint8_t* heat = state.heat[panel];
 
-        // Cool down every cell a little
-        for (int i = 0; i < NUM_LEDS_PER_PANEL; i++) {
-            heat[panel][i] = qsub8(heat[panel][i], random8(0, ((55 * 10) / NUM_LEDS_PER_PANEL) + 2));
-        }
+        for (uint16_t step = 0; step < steps; step++) {
+            // Cool down every cell a little
+            for (int i = 0; i < NUM_LEDS_PER_PANEL; i++) {
+                heat[i] = qsub8(heat[i], random8(0, ((55 * 10) / NUM_LEDS_PER_PANEL) + 2));
+            }
 
-        // Heat from each cell drifts 'up' and diffuses a little
-        for (int k = NUM_LEDS_PER_PANEL - 1; k >= 2; k--) {
-            heat[panel][k] = (heat[panel][k - 1] + heat[panel][k - 2] + heat[panel][k - 2]) / 3;
-        }
+            // Heat from each cell drifts 'up' and diffuses a little
+            for (int k = NUM_LEDS_PER_PANEL - 1; k >= 2; k--) {
+                heat[k] = (heat[k - 1] + heat[k - 2] + heat[k - 2]) / 3;
+            }
 
-        // Randomly ignite new 'sparks' of heat near the bottom
-        if (random8() < 120) {
-            int y = random8(3);
-            heat[panel][y] = qadd8(heat[panel][y], random8(160, 255));
+            // Randomly ignite new 'sparks' of heat near the bottom
+            if (random8() < 120) {
+                int y = random8(3);
+                heat[y] = qadd8(heat[y], random8(160, 255));
+            }
         }
 
         // Map from heat cells to LED colors
         for (int j = 0; j < NUM_LEDS_PER_PANEL; j++) {
             // Scale the heat value from 0-255 down to 0-240 for best color values
-            uint8_t colorindex = scale8(heat[panel][j], 240);
+            uint8_t colorindex = scale8(heat[j], 240);
             leds[j] = HeatColor(colorindex);
         }
     }
 }
 
-void twinklePattern() {
+void twinklePattern(const FrameContext& frame) {
     // Random twinkling stars effect
-    fadeToBlackBy(DJLEDs_Right, NUM_LEDS_PER_PANEL, 10);
-    fadeToBlackBy(DJLEDs_Middle, NUM_LEDS_PER_PANEL, 10);
-    fadeToBlackBy(DJLEDs_Left, NUM_LEDS_PER_PANEL, 10);
+    uint8_t fade = fadeForFrame(10, frame.dt);
+    fadeToBlackBy(DJLEDs_Right, NUM_LEDS_PER_PANEL, fade);
+    fadeToBlackBy(DJLEDs_Middle, NUM_LEDS_PER_PANEL, fade);
+    fadeToBlackBy(DJLEDs_Left, NUM_LEDS_PER_PANEL, fade);
 
     // Add random twinkles
     for (int panel = 0; panel < 3; panel++) {
         CRGB* leds = getLEDArray(panel);
 
-        if (random8() < 50) {
+        for (uint8_t n = randomEvents(50, frame.dt); n > 0; n--) {
             int pos = random8(NUM_LEDS_PER_PANEL);
             // Random color with mostly white/blue tones
             uint8_t hue = random8() < 128 ? random8(140, 180) : random8(); // 50% blue-ish
@@ -621,7 +549,7 @@ void twinklePattern() {
         }
 
         // Occasionally add a bright white star
-        if (random8() < 20) {
+        for (uint8_t n = randomEvents(20, frame.dt); n > 0; n--) {
             int pos = random8(NUM_LEDS_PER_PANEL);
             leds[pos] = CRGB::White;
         }
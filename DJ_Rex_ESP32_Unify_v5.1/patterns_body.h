@@ -3,33 +3,84 @@
 
 #include "config.h"
 #include "globals.h"
+#include "blink_scheduler.h"
+#include "render_clock.h"
 
-// Pattern functions
-void LEDsOff();
-void RandomBlocks();
-void SolidColor();
-void ShortCircuit();
-void ConfettiRedWhite();
-void rainbow();
-void rainbowWithGlitter();
-void confetti();
-void juggle();
-void audioSync();
-void SolidFlash();
-void knightRider();
-void breathing();
-void matrixRain();
-void strobePattern();
-void audioVUMeter();
-void CustomBlockSequence();
+// v5.2: Pattern state, kept in the pattern arena (pattern_arena.h) instead
+// of globals. The arena zero-fills a slot before enter(), so zero is the
+// start state of every field unless the pattern has an enter() hook.
+struct ShortCircuitState {
+    uint32_t lastBurst;
+    uint16_t interval;     // Grows by 4 ms with every burst
+    uint16_t bursts;       // Done after DECAYTIME bursts
+};
+
+struct SolidFlashState {
+    uint32_t lastToggle;
+    bool on;
+};
+
+struct KnightRiderState {
+    uint32_t lastStep;
+    uint8_t pos;
+    bool reverse;
+};
+
+struct BreathingState {
+    uint32_t lastStep;
+    uint8_t bright;
+    bool falling;
+};
+
+struct MatrixRainState {
+    uint32_t lastStep;
+    uint8_t bright[3][SIDE_LEDS_COUNT];  // 0 = no drop
+};
+
+struct StrobeState {
+    uint32_t lastToggle;
+    bool on;
+};
+
+struct PlasmaState {
+    uint16_t time;
+    uint16_t rest;         // Fraction of a time step (advanceBy)
+};
+
+struct FireState {
+    uint32_t lastStep;
+    uint8_t heat[3][NUM_LEDS_PER_PANEL];
+};
+
+// Random Blocks, Solid Color and Custom Block Sequence keep a BlinkScheduler
+void blinkPatternEnter();
+
+// Pattern functions (frame = clock snapshot of this frame, see render_clock.h)
+void LEDsOff(const FrameContext& frame);
+void RandomBlocks(const FrameContext& frame);
+void SolidColor(const FrameContext& frame);
+void ShortCircuit(const FrameContext& frame);
+void ConfettiRedWhite(const FrameContext& frame);
+void rainbow(const FrameContext& frame);
+void rainbowWithGlitter(const FrameContext& frame);
+void confetti(const FrameContext& frame);
+void juggle(const FrameContext& frame);
+void audioSync(const FrameContext& frame);
+void SolidFlash(const FrameContext& frame);
+void knightRider(const FrameContext& frame);
+void breathing(const FrameContext& frame);
+void matrixRain(const FrameContext& frame);
+void strobePattern(const FrameContext& frame);
+void audioVUMeter(const FrameContext& frame);
+void CustomBlockSequence(const FrameContext& frame);
 
 // v5.0: New patterns
-void plasmaPattern();
-void firePattern();
-void twinklePattern();
+void plasmaPattern(const FrameContext& frame);
+void firePattern(const FrameContext& frame);
+void twinklePattern(const FrameContext& frame);
 
-// Helper for rainbow
-void addGlitter(fract8 chanceOfGlitter);
+// Helper for rainbow (chance per reference frame)
+void addGlitter(fract8 chanceOfGlitter, uint16_t dt);
 
 // Initialize pattern list
 void initializePatterns();
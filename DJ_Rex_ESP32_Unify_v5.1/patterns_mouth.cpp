@@ -1,6 +1,9 @@
 #include "patterns_mouth.h"
 #include "audio.h"
+#include "audio_routing.h"
 #include "helpers.h"
+#include "render_clock.h"
+#include "pattern_arena.h"
 
 // NEU: Helper function to get the correct color based on split mode
 CRGB getMouthColor(int row, int ledInRow) {
@@ -47,50 +50,26 @@ CRGB adjustMouthBrightness(CRGB color, int row, int ledInRow) {
     return adjustedColor;
 }
 
-// NEU: Forward declarations for new patterns
-void mouthWave();
-void mouthPulse();
-void mouthVUMeterHoriz();
-void mouthVUMeterVert();
-void mouthFrown();
-void mouthSparkle();
-
-
 void updateMouth() {
-    // The main switch now includes all 15 patterns
-    switch (mouthPattern) {
-        case 0: mouthOff(); break;
-        case 1: mouthTalk(); break;
-        case 2: mouthSmile(); break;
-        case 3: mouthAudioReactive(); break;
-        case 4: mouthRainbow(); break;
-        case 5: mouthDebug(); break;
-        case 6: mouthWave(); break;
-        case 7: mouthPulse(); break;
-        case 8: mouthVUMeterHoriz(); break;
-        case 9: mouthVUMeterVert(); break;
-        case 10: mouthFrown(); break;
-        case 11: mouthSparkle(); break;
-        // v5.0: New patterns
-        case 12: mouthMatrix(); break;
-        case 13: mouthHeartbeat(); break;
-        case 14: mouthSpectrum(); break;
+    // v5.2: Dispatch through the pattern arena (enters a newly selected pattern)
+    if (mouthPattern < NUM_MOUTH_PATTERNS) {
+        mouthArena.render(mouthPattern);
     }
 }
 
-void mouthOff() {
-    fadeToBlackBy(DJLEDs_Mouth, NUM_MOUTH_LEDS, 20);
+void mouthOff(const FrameContext& frame) {
+    fadeToBlackBy(DJLEDs_Mouth, NUM_MOUTH_LEDS, fadeForFrame(20, frame.dt));
 }
 
-void mouthTalk() {
-    static uint8_t talkFrame = 0;
-    static unsigned long lastTalkUpdate = 0;
+void mouthTalk(const FrameContext& frame) {
     
+    MouthTalkState& state = mouthState<MouthTalkState>();
     uint16_t talkInterval = map(talkSpeed, 1, 10, 500, 50);
     
-    if (millis() - lastTalkUpdate > talkInterval) {
-        lastTalkUpdate = millis();
-        talkFrame = (talkFrame + 1) % 4;
+    uint16_t steps = elapsedSteps(state.lastStep, frame.now, talkInterval);
+    if (steps > 0) {
+        state.shape = (state.shape + steps) % 4;
+        uint8_t talkFrame = state.shape;
         
         fill_solid(DJLEDs_Mouth, NUM_MOUTH_LEDS, CRGB::Black);
         
@@ -127,7 +106,7 @@ void mouthTalk() {
     }
 }
 
-void mouthSmile() {
+void mouthSmile(const FrameContext& /*frame*/) {
     fill_solid(DJLEDs_Mouth, NUM_MOUTH_LEDS, CRGB::Black);
     
     int startRow = 6 - (smileWidth / 2);
@@ -150,20 +129,14 @@ void mouthSmile() {
     }
 }
 
-void mouthAudioReactive() {
-    int audio = processAudioLevel();
-    
-    if (audioMode == AUDIO_OFF || (audioMode != AUDIO_MOUTH_ONLY && audioMode != AUDIO_ALL)) {
-        fadeToBlackBy(DJLEDs_Mouth, NUM_MOUTH_LEDS, 20);
-        return;
-    }
+void mouthAudioReactive(const FrameContext& frame) {
+    uint8_t level = audioRouter.getLevel(AUDIO_ZONE_MOUTH);  // v5.2: Routed mouth value, 0-255
     
-    fadeToBlackBy(DJLEDs_Mouth, NUM_MOUTH_LEDS, 20);
+    fadeToBlackBy(DJLEDs_Mouth, NUM_MOUTH_LEDS, fadeForFrame(20, frame.dt));
     
-    int activeRows = map(audio, 0, audioThreshold, 0, MOUTH_ROWS);
-    activeRows = constrain(activeRows, 0, MOUTH_ROWS);
+    int activeRows = (level * MOUTH_ROWS) / 255;
     
-    CRGB audioColor = CHSV(map(audio, 0, audioThreshold, 0, 255), 255, mouthBrightness);
+    CRGB audioColor = CHSV(level, 255, mouthBrightness);
     
     int centerRow = 5;
     for (int i = 0; i < activeRows; i++) {
@@ -184,9 +157,10 @@ void mouthAudioReactive() {
     }
 }
 
-void mouthRainbow() {
-    static uint8_t rainbowOffset = 0;
-    
+void mouthRainbow(const FrameContext& frame) {
+    MouthRainbowState& state = mouthState<MouthRainbowState>();
+    uint8_t rainbowOffset = state.offset;
+
     for (int row = 0; row < MOUTH_ROWS; row++) {
         uint8_t hue = rainbowOffset + (row * 255 / MOUTH_ROWS);
         CRGB rowColor = CHSV(hue, 255, mouthBrightness);
@@ -196,19 +170,24 @@ void mouthRainbow() {
         }
     }
     
-    EVERY_N_MILLISECONDS(20) {
-        rainbowOffset++;
-    }
+    // One hue step per 20 ms
+    state.offset += advanceBy(state.rest, frame.dt, 1);
 }
 
 // --- NEUE MUSTER AB HIER ---
 
-void mouthWave() {
+void mouthWave(const FrameContext& /*frame*/) {
     uint8_t speed = map(waveSpeed, 1, 10, 20, 2);
-    
+
+    // v5.2: Scale the wave speed with the detected tempo (reference 120 BPM)
+    accum88 waveBpm = speed << 8;
+    if (frameAudio.beatLocked) {
+        waveBpm = ((uint32_t)speed * frameAudio.bpm10 * 256) / 1200;
+    }
+
     for (int row = 0; row < MOUTH_ROWS; row++) {
         for (int i = 0; i < mouthRowLeds[row]; i++) {
-            uint8_t brightness = beatsin8(speed, 0, 255, 0, (row * 16 + i * 16));
+            uint8_t brightness = beatsin8(waveBpm, 0, 255, 0, (row * 16 + i * 16));
             CRGB waveColor = getMouthColor(row, i);
             waveColor.fadeToBlackBy(255 - brightness);
             waveColor.fadeToBlackBy(255 - mouthBrightness);
@@ -217,7 +196,7 @@ void mouthWave() {
     }
 }
 
-void mouthPulse() {
+void mouthPulse(const FrameContext& /*frame*/) {
     uint8_t speed = map(pulseSpeed, 1, 10, 4, 20);
     uint8_t brightness = beatsin8(speed, 64, 255);
 
@@ -231,34 +210,29 @@ void mouthPulse() {
     }
 }
 
-void mouthVUMeterHoriz() {
-    int audio = processAudioLevel();
-    if (audioMode == AUDIO_OFF) audio = 0;
-    
-    fadeToBlackBy(DJLEDs_Mouth, NUM_MOUTH_LEDS, 40);
+void mouthVUMeterHoriz(const FrameContext& frame) {
+    fadeToBlackBy(DJLEDs_Mouth, NUM_MOUTH_LEDS, fadeForFrame(40, frame.dt));
 
-    int level = map(audio, 0, audioThreshold, 0, 4); // Map to 4 levels (half of an 8-led row)
-    level = constrain(level, 0, 4);
+    // v5.2: Routed mouth value of this frame
+    int level = (audioRouter.getLevel(AUDIO_ZONE_MOUTH) * 4) / 255; // Map to 4 levels (half of an 8-led row)
 
     for (int row = 0; row < MOUTH_ROWS; row++) {
-        for (int i = 0; i < level; i++) {
+        // Center outwards, staying inside the row (the lower rows are shorter)
+        int half = mouthRowLeds[row] / 2;
+        for (int i = 0; i < level && i < half; i++) {
             CRGB vuColor = getMouthColor(row, i);
             vuColor.fadeToBlackBy(255-mouthBrightness);
-            // Center outwards
-            DJLEDs_Mouth[mouthRowStart[row] + 3 - i] = adjustMouthBrightness(vuColor, row, 3 - i);
-            DJLEDs_Mouth[mouthRowStart[row] + 4 + i] = adjustMouthBrightness(vuColor, row, 4 + i);
+            DJLEDs_Mouth[mouthRowStart[row] + half - 1 - i] = adjustMouthBrightness(vuColor, row, half - 1 - i);
+            DJLEDs_Mouth[mouthRowStart[row] + half + i] = adjustMouthBrightness(vuColor, row, half + i);
         }
     }
 }
 
-void mouthVUMeterVert() {
-    int audio = processAudioLevel();
-    if (audioMode == AUDIO_OFF) audio = 0;
-    
-    fadeToBlackBy(DJLEDs_Mouth, NUM_MOUTH_LEDS, 40);
+void mouthVUMeterVert(const FrameContext& frame) {
+    fadeToBlackBy(DJLEDs_Mouth, NUM_MOUTH_LEDS, fadeForFrame(40, frame.dt));
 
-    int level = map(audio, 0, audioThreshold, 0, MOUTH_ROWS);
-    level = constrain(level, 0, MOUTH_ROWS);
+    // v5.2: Routed mouth value of this frame
+    int level = (audioRouter.getLevel(AUDIO_ZONE_MOUTH) * MOUTH_ROWS) / 255;
     
     // Fill from bottom up
     for (int row = MOUTH_ROWS - 1; row >= MOUTH_ROWS - level; row--) {
@@ -270,7 +244,7 @@ void mouthVUMeterVert() {
     }
 }
 
-void mouthFrown() {
+void mouthFrown(const FrameContext& /*frame*/) {
     fill_solid(DJLEDs_Mouth, NUM_MOUTH_LEDS, CRGB::Black);
 
     int startRow = 1;
@@ -291,10 +265,10 @@ void mouthFrown() {
     }
 }
 
-void mouthSparkle() {
-    fadeToBlackBy(DJLEDs_Mouth, NUM_MOUTH_LEDS, 20);
+void mouthSparkle(const FrameContext& frame) {
+    fadeToBlackBy(DJLEDs_Mouth, NUM_MOUTH_LEDS, fadeForFrame(20, frame.dt));
     
-    if (random8() < 80) {
+    for (uint8_t n = randomEvents(80, frame.dt); n > 0; n--) {
         int randLed = random16(NUM_MOUTH_LEDS);
         
         // Find row and ledInRow for the random LED to get the right color
@@ -314,15 +288,15 @@ void mouthSparkle() {
 }
 
 
-void mouthDebug() {
-    static uint8_t debugMode = 0;
-    static unsigned long lastDebugTime = 0;
+void mouthDebug(const FrameContext& frame) {
     
     fill_solid(DJLEDs_Mouth, NUM_MOUTH_LEDS, CRGB::Black);
     
-    if (millis() - lastDebugTime > 2000) {
-        lastDebugTime = millis();
-        debugMode = (debugMode + 1) % 3;
+    MouthDebugState& state = mouthState<MouthDebugState>();
+    uint16_t steps = elapsedSteps(state.lastStep, frame.now, 2000);
+    if (steps > 0) {
+        state.mode = (state.mode + steps) % 3;
+        uint8_t debugMode = state.mode;
         
         Serial.print(F("Mouth Debug Mode: "));
         switch(debugMode) {
@@ -334,7 +308,7 @@ void mouthDebug() {
     
     CRGB testColor = CRGB(100, 100, 100);
     
-    switch(debugMode) {
+    switch(state.mode) {
         case 0: // Outer
             for (int row = 0; row < 8; row++) {
                 DJLEDs_Mouth[mouthRowStart[row] + 0] = adjustMouthBrightness(testColor, row, 0);
@@ -364,59 +338,55 @@ void mouthDebug() {
 // v5.0 NEW MOUTH PATTERNS
 // =====================================================
 
-void mouthMatrix() {
+void mouthMatrix(const FrameContext& frame) {
     // Matrix-style falling effect
-    static uint8_t matrixDrops[8];  // For each column
-    static uint8_t matrixBright[8];
-    static unsigned long lastMatrixUpdate = 0;
-
-    if (millis() - lastMatrixUpdate > 80) {
-        lastMatrixUpdate = millis();
+    MouthMatrixState& state = mouthState<MouthMatrixState>();
+    uint8_t* mouthMatrixDrops = state.drop;
+    uint8_t* mouthMatrixBright = state.bright;
 
+    for (uint16_t steps = elapsedSteps(state.lastStep, frame.now, 80); steps > 0; steps--) {
         // Shift drops down
         for (int col = 0; col < 8; col++) {
-            if (matrixBright[col] > 0) {
-                matrixDrops[col]++;
-                matrixBright[col] = matrixBright[col] > 30 ? matrixBright[col] - 30 : 0;
+            if (mouthMatrixBright[col] > 0) {
+                mouthMatrixDrops[col]++;
+                mouthMatrixBright[col] = mouthMatrixBright[col] > 30 ? mouthMatrixBright[col] - 30 : 0;
             }
 
             // Randomly start new drops
-            if (matrixDrops[col] >= MOUTH_ROWS || matrixBright[col] == 0) {
+            if (mouthMatrixDrops[col] >= MOUTH_ROWS || mouthMatrixBright[col] == 0) {
                 if (random8() < 40) {
-                    matrixDrops[col] = 0;
-                    matrixBright[col] = 255;
+                    mouthMatrixDrops[col] = 0;
+                    mouthMatrixBright[col] = 255;
                 }
             }
         }
     }
 
-    fadeToBlackBy(DJLEDs_Mouth, NUM_MOUTH_LEDS, 30);
+    fadeToBlackBy(DJLEDs_Mouth, NUM_MOUTH_LEDS, fadeForFrame(30, frame.dt));
 
     CRGB matrixColor = getMouthColor(0, 0);
 
     for (int col = 0; col < 8; col++) {
-        int row = matrixDrops[col];
-        if (row < MOUTH_ROWS && matrixBright[col] > 0) {
+        int row = mouthMatrixDrops[col];
+        if (row < MOUTH_ROWS && mouthMatrixBright[col] > 0) {
             int ledIdx = mouthRowStart[row] + min(col, mouthRowLeds[row] - 1);
             CRGB color = matrixColor;
-            color.fadeToBlackBy(255 - matrixBright[col]);
+            color.fadeToBlackBy(255 - mouthMatrixBright[col]);
             color.fadeToBlackBy(255 - mouthBrightness);
             DJLEDs_Mouth[ledIdx] = adjustMouthBrightness(color, row, col);
         }
     }
 }
 
-void mouthHeartbeat() {
+void mouthHeartbeat(const FrameContext& frame) {
     // Heartbeat pulse effect - double pulse
-    static uint8_t beatPhase = 0;
-    static unsigned long lastBeatUpdate = 0;
 
+    MouthHeartbeatState& state = mouthState<MouthHeartbeatState>();
     uint16_t beatInterval = 50;
 
-    if (millis() - lastBeatUpdate > beatInterval) {
-        lastBeatUpdate = millis();
-        beatPhase = (beatPhase + 1) % 40;
-    }
+    uint16_t steps = elapsedSteps(state.lastStep, frame.now, beatInterval);
+    state.phase = (state.phase + steps) % 40;
+    uint8_t beatPhase = state.phase;
 
     // Create heartbeat pattern (two quick pulses, then pause)
     uint8_t brightness = 0;
@@ -441,41 +411,20 @@ void mouthHeartbeat() {
     }
 }
 
-void mouthSpectrum() {
-    // Audio spectrum analyzer visualization
-    int audio = processAudioLevel();
-    if (audioMode == AUDIO_OFF) audio = 0;
-
-    fadeToBlackBy(DJLEDs_Mouth, NUM_MOUTH_LEDS, 40);
-
-    // Create pseudo-spectrum with different frequency bands
-    static uint8_t bands[8];
-    static uint8_t targets[8];
-    static unsigned long lastSpectrumUpdate = 0;
-
-    if (millis() - lastSpectrumUpdate > 30) {
-        lastSpectrumUpdate = millis();
-
-        // Update targets based on audio
-        for (int i = 0; i < 8; i++) {
-            // Simulate different frequency bands with some variation
-            int bandLevel = audio + random8(20) - 10;
-            bandLevel = constrain(bandLevel, 0, audioThreshold);
-            targets[i] = map(bandLevel, 0, audioThreshold, 0, MOUTH_ROWS);
-
-            // Smooth transition
-            if (bands[i] < targets[i]) {
-                bands[i]++;
-            } else if (bands[i] > targets[i]) {
-                bands[i]--;
-            }
-        }
-    }
+void mouthSpectrum(const FrameContext& frame) {
+    // v5.2: Spectrum analyzer visualization - one column per FFT band group
+    fadeToBlackBy(DJLEDs_Mouth, NUM_MOUTH_LEDS, fadeForFrame(40, frame.dt));
 
-    // Draw spectrum bars
     for (int col = 0; col < 8; col++) {
-        int level = bands[col];
+        uint8_t band = col * SPECTRUM_BANDS / 8;
+        int level = 0;
+        int peakLevel = 0;
+        if (audioRouter.isRouted(AUDIO_ZONE_MOUTH)) {
+            level = scale8(frameAudio.bands[band], MOUTH_ROWS + 1);
+            peakLevel = scale8(frameAudio.bandPeaks[band], MOUTH_ROWS + 1);
+        }
 
+        // Draw spectrum bar from the bottom row up
         for (int row = MOUTH_ROWS - 1; row >= MOUTH_ROWS - level; row--) {
             if (row >= 0 && row < MOUTH_ROWS && col < mouthRowLeds[row]) {
                 // Color based on level (green->yellow->red)
@@ -484,5 +433,12 @@ void mouthSpectrum() {
                 DJLEDs_Mouth[mouthRowStart[row] + col] = adjustMouthBrightness(specColor, row, col);
             }
         }
+
+        // Peak hold dot above the bar
+        int peakRow = MOUTH_ROWS - peakLevel;
+        if (peakLevel > level && col < mouthRowLeds[peakRow]) {
+            CRGB peakColor = CRGB(mouthBrightness, mouthBrightness, mouthBrightness);
+            DJLEDs_Mouth[mouthRowStart[peakRow] + col] = adjustMouthBrightness(peakColor, peakRow, col);
+        }
     }
 }
\ No newline at end of file
@@ -3,20 +3,54 @@
 
 #include "config.h"
 #include "globals.h"
+#include "render_clock.h"
 
-// Mouth pattern functions
+// v5.2: Mouth pattern state, kept in the pattern arena (see patterns_body.h)
+struct MouthTalkState {
+    uint32_t lastStep;
+    uint8_t shape;      // 0 = closed ... 3 = wide open
+};
+
+struct MouthRainbowState {
+    uint8_t offset;
+    uint16_t rest;      // Fraction of a hue step (advanceBy)
+};
+
+struct MouthDebugState {
+    uint32_t lastStep;
+    uint8_t mode;
+};
+
+struct MouthMatrixState {
+    uint32_t lastStep;
+    uint8_t drop[8];    // Row of the drop in each column
+    uint8_t bright[8];
+};
+
+struct MouthHeartbeatState {
+    uint32_t lastStep;
+    uint8_t phase;
+};
+
+// Mouth pattern functions (frame as for the body patterns)
 void updateMouth();
-void mouthOff();
-void mouthTalk();
-void mouthSmile();
-void mouthAudioReactive();
-void mouthRainbow();
-void mouthDebug();
-
-// v5.0: New mouth patterns
-void mouthMatrix();
-void mouthHeartbeat();
-void mouthSpectrum();
+void mouthOff(const FrameContext& frame);
+void mouthTalk(const FrameContext& frame);
+void mouthSmile(const FrameContext& frame);
+void mouthAudioReactive(const FrameContext& frame);
+void mouthRainbow(const FrameContext& frame);
+void mouthDebug(const FrameContext& frame);
+void mouthWave(const FrameContext& frame);
+void mouthPulse(const FrameContext& frame);
+void mouthVUMeterHoriz(const FrameContext& frame);
+void mouthVUMeterVert(const FrameContext& frame);
+void mouthFrown(const FrameContext& frame);
+void mouthSparkle(const FrameContext& frame);
+
+// v5.0: New patterns
+void mouthMatrix(const FrameContext& frame);
+void mouthHeartbeat(const FrameContext& frame);
+void mouthSpectrum(const FrameContext& frame);
 
 // Helper function for brightness compensation
 CRGB adjustMouthBrightness(CRGB color, int row, int ledInRow);
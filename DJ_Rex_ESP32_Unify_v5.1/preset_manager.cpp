@@ -1,6 +1,8 @@
 // preset_manager.cpp - v5.0 Extended Preset Manager (10 slots)
 #include "preset_manager.h"
 #include "event_logger.h"
+#include "audio_routing.h"
+#include "transition.h"
 #include <Preferences.h>
 
 PresetManager presetManager;
@@ -169,18 +171,24 @@ void PresetManager::captureCurrentState(ExtendedPreset& preset) {
 }
 
 void PresetManager::applyPreset(const ExtendedPreset& preset) {
-    currentPattern = preset.pattern;
+    // v5.2: Body, eyes and mouth each fade over to the preset, if they change
+    bool eyesChanged = (eyeColorIndex != preset.eyeColor || eyeColorIndex2 != preset.eyeColor2 ||
+                        eyeMode != preset.eyeMode);
+    transitionEngine.start(preset.pattern);
     ledBrightness = preset.brightness;
     effectSpeed = preset.speed;
     solidColorIndex = preset.solidColor;
     eyeColorIndex = preset.eyeColor;
     eyeColorIndex2 = preset.eyeColor2;
     eyeMode = preset.eyeMode;
-    mouthPattern = preset.mouthPattern;
+    if (eyesChanged) transitionEngine.startEyes();
+    transitionEngine.startMouth(preset.mouthPattern);
     mouthColorIndex = preset.mouthColor;
     mouthColorIndex2 = preset.mouthColor2;
     mouthSplitMode = preset.mouthSplitMode;
     audioMode = preset.audioMode;
+    if (audioMode >= NUM_AUDIO_MODES) audioMode = AUDIO_ALL;
+    audioRouter.loadPreset(audioMode);  // v5.2: AUDIO_CUSTOM keeps the current table
 
     for (uint8_t i = 0; i < 9; i++) {
         blockColors[i] = preset.blockColors[i];
@@ -0,0 +1,87 @@
+// render_clock.cpp - v5.2 Render Clock & ADC Source
+#include "render_clock.h"
+#include "adc_stream.h"
+
+static volatile bool clockVirtual = false;
+static volatile uint32_t virtualMillis = 0;
+
+static int readMicPin() {
+    // The pin belongs to the DMA driver while the stream runs
+    if (adcStream.isRunning()) {
+        return adcStream.getLastSample();
+    }
+    return analogRead(MIC_PIN);
+}
+
+static volatile AdcSourceFunc adcSource = readMicPin;
+
+static FrameContext frameClock = {0, 0, 0, TIME_SCALE_DEFAULT};
+static uint32_t lastFrameMs = 0;   // Render clock at the previous frame
+static uint16_t scaleRest = 0;     // Scaled time not yet on the animation clock, in 1/100 ms
+
+uint32_t renderMillis() {
+    return clockVirtual ? virtualMillis : millis();
+}
+
+void setRenderClockLive() {
+    clockVirtual = false;
+}
+
+void setRenderClockVirtual(uint32_t startMs) {
+    virtualMillis = startMs;
+    clockVirtual = true;
+}
+
+void advanceRenderClock(uint32_t ms) {
+    virtualMillis += ms;
+}
+
+bool isRenderClockVirtual() {
+    return clockVirtual;
+}
+
+const FrameContext& beginFrame(uint16_t timeScale) {
+    uint32_t now = renderMillis();
+    uint32_t elapsed = min(now - lastFrameMs, (uint32_t)MAX_FRAME_DT_MS);
+    lastFrameMs = now;
+
+    // Carry the fraction so slow time scales still move the clock
+    uint32_t scaled = elapsed * timeScale + scaleRest;
+    frameClock.dt = scaled / 100;
+    scaleRest = scaled % 100;
+
+    frameClock.now += frameClock.dt;
+    frameClock.frame++;
+    frameClock.timeScale = timeScale;
+    return frameClock;
+}
+
+const FrameContext& frameContext() {
+    return frameClock;
+}
+
+void resetFrameClock() {
+    lastFrameMs = renderMillis();
+    scaleRest = 0;
+    frameClock.now = lastFrameMs;
+    frameClock.dt = 0;
+    frameClock.frame = 0;
+}
+
+// FastLED timing functions (beatsin*, EVERY_N_*) read the animation clock
+// through USE_GET_MILLISECOND_TIMER (see config.h)
+uint32_t get_millisecond_timer() {
+    return frameClock.now;
+}
+
+void setAdcSource(AdcSourceFunc source) {
+    adcSource = (source != nullptr) ? source : readMicPin;
+}
+
+int readAdcSample() {
+    return adcSource();
+}
+
+bool isAdcSourceOverridden() {
+    return adcSource != readMicPin;
+}
@@ -0,0 +1,39 @@
+// render_clock.h - v5.2 Render Clock & ADC Source
+#ifndef RENDER_CLOCK_H
+#define RENDER_CLOCK_H
+
+#include "config.h"
+
+// Time base of the render core (patterns, eyes, mouth, audio, demo, transitions).
+// Live mode follows millis(); virtual mode only moves when advanced, which makes
+// rendering reproducible (golden frames, benchmarks).
+uint32_t renderMillis();
+void setRenderClockLive();
+void setRenderClockVirtual(uint32_t startMs);
+void advanceRenderClock(uint32_t ms);
+bool isRenderClockVirtual();
+
+// v5.2: Clock snapshot of one frame, passed to every pattern. The animation
+// clock follows the render clock at timeScale percent; all patterns, the
+// eyes and FastLED's beatsin/EVERY_N read it, so one frame sees one time.
+struct FrameContext {
+    uint32_t now;        // Animation time in ms, taken once per frame
+    uint16_t dt;         // Animation ms since the previous frame (0 on a pattern's first frame)
+    uint32_t frame;      // Frames since the clock was reset
+    uint16_t timeScale;  // % of real time
+};
+
+// Call once at the start of a frame, after the render clock moved
+const FrameContext& beginFrame(uint16_t timeScale);
+const FrameContext& frameContext();
+// Restart the animation clock at the render clock (frame 0, dt 0)
+void resetFrameClock();
+
+// Raw ADC sample source of the audio input (default: the microphone pin -
+// the latest DMA sample while the ADC stream runs, otherwise analogRead(MIC_PIN))
+typedef int (*AdcSourceFunc)();
+void setAdcSource(AdcSourceFunc source);  // nullptr restores the microphone pin
+int readAdcSample();
+bool isAdcSourceOverridden();
+
+#endif
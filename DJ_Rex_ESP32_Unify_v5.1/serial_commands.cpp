@@ -9,10 +9,39 @@
 #include "system_monitor.h"
 #include "pattern_manager.h"
 
+// v5.2: New module includes
+#include "led_output.h"
+#include "frame_profiler.h"
+#include "golden_frames.h"
+#include "spectrum.h"
+#include "adc_stream.h"
+#include "beat_detector.h"
+#include "auto_gain.h"
+#include "audio_replay.h"
+#include "filter_bank.h"
+#include "audio_routing.h"
+#include "pattern_registry.h"
+#include "transition.h"
+#include "pattern_arena.h"
+#include "render_clock.h"
+
 // Serial input buffer
 String inputString = "";
 boolean stringComplete = false;
 
+// v5.2: Benchmarks, self-tests and uploads run for seconds under the LED mutex.
+// The render task is paused for their duration instead of timing out on the
+// mutex every frame and counting those misses as overruns.
+static void pauseRendering() {
+    renderPaused = true;
+    Serial.println(F("Rendering paused"));
+}
+
+static void resumeRendering() {
+    renderPaused = false;
+    Serial.println(F("Rendering resumed"));
+}
+
 //Function to parse the playlist string
 void parsePlaylistCommand(String command) {
     // Remove "playlist " part
@@ -41,9 +70,26 @@ void parsePlaylistCommand(String command) {
             uint8_t pattern = entryString.substring(0, commaPos).toInt();
             uint16_t duration = entryString.substring(commaPos + 1).toInt();
 
+            // v5.2: Optional transition into this entry: p,d,mode[,ms]
+            uint8_t mode = TRANSITION_MODE_DEFAULT;
+            uint16_t transitionMs = TRANSITION_MS_DEFAULT;
+            int modePos = entryString.indexOf(',', commaPos + 1);
+            if (modePos > 0) {
+                int msPos = entryString.indexOf(',', modePos + 1);
+                String modeName = (msPos > 0) ? entryString.substring(modePos + 1, msPos) : entryString.substring(modePos + 1);
+                modeName.trim();
+                int found = TransitionEngine::findMode(modeName.c_str());
+                if (found >= 0) mode = found;
+                if (msPos > 0) {
+                    transitionMs = constrain(entryString.substring(msPos + 1).toInt(), 0L, (long)MAX_TRANSITION_MS);
+                }
+            }
+
             if (pattern < NUM_PATTERNS && duration > 0) {
                 playlist[entryIndex].pattern = pattern;
                 playlist[entryIndex].duration = duration;
+                playlist[entryIndex].transitionMode = mode;
+                playlist[entryIndex].transitionMs = transitionMs;
                 entryIndex++;
             }
         }
@@ -77,6 +123,79 @@ bool checkSerialCommand() {
     return false;
 }
 
+// v5.2: "route <zone> <source> [gain%] [curve]" - zone may also be a group
+void parseRouteCommand(String command) {
+    String args[4];
+    uint8_t count = 0;
+    String data = command.substring(6);
+    data.trim();
+    int currentPos = 0;
+    while (currentPos < (int)data.length() && count < 4) {
+        int spacePos = data.indexOf(' ', currentPos);
+        if (spacePos == -1) spacePos = data.length();
+        if (spacePos > currentPos) {
+            args[count++] = data.substring(currentPos, spacePos);
+        }
+        currentPos = spacePos + 1;
+    }
+    if (count < 2) {
+        Serial.println(F("Usage: route <zone> <source> [gain%] [curve]"));
+        return;
+    }
+
+    // Zone groups
+    uint8_t firstZone, lastZone;
+    if (args[0] == "sides") {
+        firstZone = AUDIO_ZONE_SIDES;
+        lastZone = AUDIO_ZONE_SIDES + 2;
+    } else if (args[0] == "blocks") {
+        firstZone = AUDIO_ZONE_BLOCKS;
+        lastZone = AUDIO_ZONE_BLOCKS + 2;
+    } else if (args[0] == "body") {
+        firstZone = AUDIO_ZONE_SIDES;
+        lastZone = AUDIO_ZONE_BLOCKS + 2;
+    } else if (args[0] == "all") {
+        firstZone = 0;
+        lastZone = NUM_AUDIO_ZONES - 1;
+    } else {
+        int zone = AudioRouter::findZone(args[0].c_str());
+        if (zone < 0) {
+            Serial.println(F("Invalid zone! Use rsides/msides/lsides, rblocks/mblocks/lblocks, eyes, mouth, sides, blocks, body or all"));
+            return;
+        }
+        firstZone = lastZone = zone;
+    }
+
+    AudioRoute route;
+    int source = AudioRouter::findSource(args[1].c_str(), &route.band);
+    if (source < 0) {
+        Serial.print(F("Invalid source! Use off, level, slow, peak, beat, bass, mid, treble or band0-"));
+        Serial.println(SPECTRUM_BANDS - 1);
+        return;
+    }
+    route.source = source;
+
+    int gainPercent = (count > 2) ? args[2].toInt() : 100;
+    if (gainPercent < 0 || gainPercent > 1500) {
+        Serial.println(F("Invalid gain! Use 0-1500 (%)"));
+        return;
+    }
+    route.gain = gainPercent * 16 / 100;
+
+    int curve = (count > 3) ? AudioRouter::findCurve(args[3].c_str()) : CURVE_LINEAR;
+    if (curve < 0) {
+        Serial.println(F("Invalid curve! Use linear, square, sqrt or step"));
+        return;
+    }
+    route.curve = curve;
+
+    for (uint8_t zone = firstZone; zone <= lastZone; zone++) {
+        audioRouter.setRoute(zone, route);
+    }
+    audioMode = AUDIO_CUSTOM;
+    audioRouter.printRoutes();
+}
+
 void printHelp() {
     Serial.println(F("\n=== DJ Rex v5.1 - Command Reference ==="));
     Serial.println(F("Body Pattern Commands:"));
@@ -90,8 +209,14 @@ void printHelp() {
     Serial.println(F("  playlist on/off    - Enable/disable playlist mode"));
     Serial.println(F("  playlist show      - Show current playlist"));
     Serial.println(F("  playlist <p,d;p,d> - Set playlist (e.g., playlist 5,10;12,20)"));
+    Serial.println(F("  playlist <p,d,t,ms;...> - With transition per entry (e.g., 5,10,wipe,2000)"));
     Serial.println(F("  playlist save      - Save playlist to flash"));
     Serial.println(F("  playlist load      - Load playlist from flash"));
+    Serial.println(F("  transition         - Show transition state and per-frame cost"));
+    Serial.println(F("  transition reset   - Reset transition cost counters"));
+    Serial.println(F("  transition <t> [ms] - Default transition: fade, eased, stagger,"));
+    Serial.println(F("                       wipe, dissolve, black (ms 0 = cut)"));
+    Serial.println(F("  transition ms <n>  - Default transition length (0-10000)"));
     Serial.println(F(""));
     Serial.println(F("Eye Commands:"));
     Serial.println(F("  eyecolor <0-19>    - Set eye color"));
@@ -116,13 +241,18 @@ void printHelp() {
     Serial.println(F("  smilewidth <2-10>  - Set smile width"));
     Serial.println(F(""));
     Serial.println(F("Audio Commands:"));
-    Serial.println(F("  audiomode <0-4>    - Set audio routing mode"));
-    Serial.println(F("    0=Off, 1=Mouth Only, 2=Body Sides, 3=Body All, 4=Everything"));
+    Serial.println(F("  audiomode <0-6>    - Load an audio routing preset"));
+    Serial.println(F("    0=Off, 1=Mouth Only, 2=Body Sides, 3=Body All, 4=Everything,"));
+    Serial.println(F("    5=Band Split, 6=Custom"));
+    Serial.println(F("  route              - Show the audio routing table"));
+    Serial.println(F("  route <zone> <source> [gain%] [curve] - Route a zone (e.g. route mouth treble 150 sqrt)"));
     Serial.println(F("  audioinput mic     - Use microphone input (default)"));
     Serial.println(F("  audioinput linein  - Use line-in input (requires adapter)"));
     Serial.println(F("  audiosens <1-10>   - Set audio sensitivity"));
     Serial.println(F("  audiothreshold <50-500> - Set threshold manually"));
     Serial.println(F("  autogain on/off    - Enable/disable auto gain"));
+    Serial.println(F("  agc                - Show auto gain state per input"));
+    Serial.println(F("  agc reset          - Forget the learned gain history"));
     Serial.println(F(""));
     Serial.println(F("Random Blocks Configuration:"));
     Serial.println(F("  blockcolor <0-8> <0-19> - Set block color"));
@@ -154,6 +284,8 @@ void printHelp() {
     Serial.println(F("  mouthouter <50-200> - Mouth outer LED boost %"));
     Serial.println(F("  mouthinner <50-200> - Mouth inner LED boost %"));
     Serial.println(F("  speed <1-255>      - Effect speed"));
+    Serial.println(F("  fps <10-100>       - Render frame rate"));
+    Serial.println(F("  timescale <10-400> - Animation speed in % (100 = normal)"));
     Serial.println(F("  fade <1-50>        - Fade speed"));
     Serial.println(F("  sidetime <min> <max> - Side LED timing"));
     Serial.println(F("  blocktime <min> <max> - Block timing"));
@@ -179,6 +311,28 @@ void printHelp() {
     Serial.println(F(""));
     Serial.println(F("v5.0 System Monitoring:"));
     Serial.println(F("  sysinfo            - Show system status (memory, health)"));
+    Serial.println(F("  selectiveshow on/off - Skip unchanged LED outputs"));
+    Serial.println(F("  ledrefresh <0-10000> - Resend unchanged outputs every N ms (0=never)"));
+    Serial.println(F("  ledstats           - Show LED output counters and driver errors"));
+    Serial.println(F("  ledstats reset     - Reset LED output counters"));
+    Serial.println(F("  ledbench [1-1000]  - Time full-frame LED output (default 100)"));
+    Serial.println(F("  ledsink null/hw    - Discard LED output / send to the strips"));
+    Serial.println(F("  audiobench [1-1000] - Time the spectrum FFT, show bands (default 100)"));
+    Serial.println(F("  beat               - Show beat detector status (tempo, lock)"));
+    Serial.println(F("  beatsync on/off    - Playlist/demo switch on the next downbeat"));
+    Serial.println(F("  beattest           - Run the beat detector on synthetic click tracks"));
+    Serial.println(F("  filterbench [n]    - Filter bank tone response and cycles/sample (default 10000)"));
+    Serial.println(F("  replay             - Show the audio replay state"));
+    Serial.println(F("  replay load <bytes> - Receive a WAV file over serial (rendering pauses)"));
+    Serial.println(F("  replay wav         - Play the loaded WAV instead of the microphone"));
+    Serial.println(F("  replay clicks <bpm> - Play a generated click track (60-200 BPM)"));
+    Serial.println(F("  replay bench [s]   - Run the replay through audio + patterns at full speed (default 30)"));
+    Serial.println(F("  replay off         - Back to the microphone"));
+    Serial.println(F("  perf               - Show per-stage frame timing"));
+    Serial.println(F("  perf reset         - Reset frame timing"));
+    Serial.println(F("  golden record      - Store golden frames of all patterns"));
+    Serial.println(F("  golden check       - Compare all patterns against golden frames"));
+    Serial.println(F("  golden dump <b|m><n> <frame> - Print one frame (e.g. golden dump b5 10)"));
     Serial.println(F("  eventlog           - Show event log"));
     Serial.println(F("  eventlog clear     - Clear event log"));
     Serial.println(F("  startup [on/off]   - Show/set startup sequence"));
@@ -189,7 +343,7 @@ void printHelp() {
         Serial.print(F("  "));
         Serial.print(i);
         Serial.print(F(": "));
-        Serial.println(patternNames[i]);
+        Serial.println(bodyPatterns[i].name);
     }
     Serial.println(F(""));
     Serial.println(F("Mouth Patterns:"));
@@ -197,11 +351,11 @@ void printHelp() {
         Serial.print(F("  "));
         Serial.print(i);
         Serial.print(F(": "));
-        Serial.println(MouthPatternNames[i]);
+        Serial.println(mouthPatterns[i].name);
     }
     Serial.println(F(""));
     Serial.println(F("Audio Modes:"));
-    for (int i = 0; i < 5; i++) {
+    for (int i = 0; i < NUM_AUDIO_MODES; i++) {
         Serial.print(F("  "));
         Serial.print(i);
         Serial.print(F(": "));
@@ -229,7 +383,7 @@ void printCurrentSettings() {
     Serial.print(F("Pattern: "));
     Serial.print(currentPattern);
     Serial.print(F(" ("));
-    Serial.print(patternNames[currentPattern]);
+    Serial.print(bodyPatterns[currentPattern].name);
     Serial.println(F(")"));
     
     Serial.print(F("Demo Mode: "));
@@ -295,7 +449,7 @@ void printCurrentSettings() {
     Serial.print(F("Pattern: "));
     Serial.print(mouthPattern);
     Serial.print(F(" ("));
-    Serial.print(MouthPatternNames[mouthPattern]);
+    Serial.print(mouthPatterns[mouthPattern].name);
     Serial.println(F(")"));
     Serial.print(F("Split Mode: "));
     Serial.print(mouthSplitMode);
@@ -348,6 +502,17 @@ void printCurrentSettings() {
     Serial.println(effectSpeed);
     Serial.print(F("Fade: "));
     Serial.println(fadeSpeed);
+    Serial.print(F("Frame Rate: "));
+    Serial.print(targetFPS);
+    Serial.println(F(" fps"));
+    Serial.print(F("Time Scale: "));
+    Serial.print(timeScale);
+    Serial.println(F("%"));
+    Serial.print(F("Transition: "));
+    Serial.print(TransitionEngine::getModeName(transitionMode));
+    Serial.print(F(", "));
+    Serial.print(transitionDuration);
+    Serial.println(F(" ms"));
     Serial.println(F("========================\n"));
 }
 
@@ -399,7 +564,7 @@ void processSerialCommand() {
             playlistActive = true;
             playlistIndex = 0;
             currentPattern = playlist[playlistIndex].pattern;
-            playlistPatternStartTime = millis();
+            playlistPatternStartTime = renderMillis();
             Serial.println(F("Playlist ON."));
             Serial.print(F("Starting with pattern "));
             Serial.println(currentPattern);
@@ -421,10 +586,17 @@ void processSerialCommand() {
                 Serial.print(F(": Pattern "));
                 Serial.print(playlist[i].pattern);
                 Serial.print(F(" ("));
-                Serial.print(patternNames[playlist[i].pattern]);
+                Serial.print(bodyPatterns[playlist[i].pattern].name);
                 Serial.print(F(") for "));
                 Serial.print(playlist[i].duration);
-                Serial.println(F("s"));
+                Serial.print(F("s, "));
+                Serial.print(TransitionEngine::getModeName(playlist[i].transitionMode));
+                if (playlist[i].transitionMs != TRANSITION_MS_DEFAULT) {
+                    Serial.print(F(" "));
+                    Serial.print(playlist[i].transitionMs);
+                    Serial.print(F(" ms"));
+                }
+                Serial.println(F(" transition"));
             }
         }
         Serial.println(F("------------------------"));
@@ -442,7 +614,7 @@ void processSerialCommand() {
             demoMode = false;
             playlistActive = false;
             Serial.print(F("Pattern change requested to: "));
-            Serial.println(patternNames[pattern]);
+            Serial.println(bodyPatterns[pattern].name);
         } else {
             Serial.print(F("Invalid pattern! Use 0-"));
             Serial.println(NUM_PATTERNS - 1);
@@ -540,7 +712,10 @@ void processSerialCommand() {
     else if (inputString.startsWith("eyecolor2 ")) {
         int color = inputString.substring(10).toInt();
         if (color >= 0 && color < NUM_STANDARD_COLORS) {
-            eyeColorIndex2 = color;
+            if (color != eyeColorIndex2) {
+                eyeColorIndex2 = color;
+                transitionEngine.startEyes();
+            }
             Serial.print(F("Eye color 2 set to: "));
             Serial.println(ColorNames[color]);
         } else {
@@ -551,7 +726,10 @@ void processSerialCommand() {
     else if (inputString.startsWith("eyemode ")) {
         int mode = inputString.substring(8).toInt();
         if (mode >= 0 && mode < 3) {
-            eyeMode = mode;
+            if (mode != eyeMode) {
+                eyeMode = mode;
+                transitionEngine.startEyes();
+            }
             Serial.print(F("Eye mode set to: "));
             Serial.print(mode);
             Serial.print(F(" ("));
@@ -562,14 +740,22 @@ void processSerialCommand() {
         }
     }
     // Audio commands
+    // v5.2: Audio routing table
+    else if (inputString == "route") {
+        audioRouter.printRoutes();
+    }
+    else if (inputString.startsWith("route ")) {
+        parseRouteCommand(inputString);
+    }
     else if (inputString.startsWith("audiomode ")) {
         int mode = inputString.substring(10).toInt();
-        if (mode >= 0 && mode <= 4) {
+        if (mode >= 0 && mode < NUM_AUDIO_MODES) {
             audioMode = mode;
+            audioRouter.loadPreset(audioMode);  // v5.2: Modes are routing presets
             Serial.print(F("Audio mode: "));
             Serial.println(AudioModeNames[mode]);
         } else {
-            Serial.println(F("Invalid audio mode! Use 0-4"));
+            Serial.println(F("Invalid audio mode! Use 0-6"));
         }
     }
     else if (inputString.startsWith("audiosens ")) {
@@ -590,6 +776,14 @@ void processSerialCommand() {
         audioAutoGain = false;
         Serial.println(F("Auto gain disabled"));
     }
+    // v5.2: Percentile AGC diagnostics
+    else if (inputString == "agc") {
+        autoGain.printStatus();
+    }
+    else if (inputString == "agc reset") {
+        autoGain.reset();
+        Serial.println(F("Auto gain history cleared"));
+    }
     // v5.1: Audio input mode selection
     else if (inputString == "audioinput mic") {
         audioInputMode = INPUT_MIC;
@@ -614,9 +808,9 @@ void processSerialCommand() {
     else if (inputString.startsWith("mouth ")) {
         int pattern = inputString.substring(6).toInt();
         if (pattern >= 0 && pattern < NUM_MOUTH_PATTERNS) {
-            mouthPattern = pattern;
+            transitionEngine.startMouth(pattern);
             Serial.print(F("Mouth pattern: "));
-            Serial.println(MouthPatternNames[pattern]);
+            Serial.println(mouthPatterns[pattern].name);
         } else {
             Serial.print(F("Invalid mouth pattern! Use 0-"));
             Serial.println(NUM_MOUTH_PATTERNS - 1);
@@ -919,7 +1113,10 @@ else if (inputString.startsWith("eyecolor ")) {
     int color = colorStr.toInt();
     
     if (color >= 0 && color < NUM_STANDARD_COLORS) {
-        eyeColorIndex = color;
+        if (color != eyeColorIndex) {
+            eyeColorIndex = color;
+            transitionEngine.startEyes();
+        }
         Serial.print(F("Eye color set to: "));
         Serial.print(color);
         Serial.print(F(" ("));
@@ -936,7 +1133,7 @@ else if (inputString.startsWith("eyecolor ")) {
         demoPatternIndex = 1;
         demoColorIndex = 0;
         demoStep = 0;
-        lastDemoChange = millis();
+        lastDemoChange = renderMillis();
         currentPattern = demoPatternIndex;
         Serial.print(F("Demo mode ON ("));
         Serial.print(demoTime);
@@ -1017,6 +1214,36 @@ else if (inputString.startsWith("eyecolor ")) {
             Serial.println(speed);
         }
     }
+    // v5.2: Render task frame rate
+    else if (inputString.startsWith("fps ")) {
+        int fps = inputString.substring(4).toInt();
+        if (fps >= MIN_FRAMES_PER_SECOND && fps <= MAX_FRAMES_PER_SECOND) {
+            targetFPS = fps;
+            Serial.print(F("Frame rate: "));
+            Serial.print(fps);
+            Serial.println(F(" fps"));
+        } else {
+            Serial.print(F("Invalid frame rate! Use "));
+            Serial.print(MIN_FRAMES_PER_SECOND);
+            Serial.print(F("-"));
+            Serial.println(MAX_FRAMES_PER_SECOND);
+        }
+    }
+    // v5.2: Animation speed, independent of the frame rate
+    else if (inputString.startsWith("timescale ")) {
+        int scale = inputString.substring(10).toInt();
+        if (scale >= MIN_TIME_SCALE && scale <= MAX_TIME_SCALE) {
+            timeScale = scale;
+            Serial.print(F("Time scale: "));
+            Serial.print(scale);
+            Serial.println(F("%"));
+        } else {
+            Serial.print(F("Invalid time scale! Use "));
+            Serial.print(MIN_TIME_SCALE);
+            Serial.print(F("-"));
+            Serial.println(MAX_TIME_SCALE);
+        }
+    }
     else if (inputString.startsWith("fade ")) {
         int fade = inputString.substring(5).toInt();
         if (fade >= 1 && fade <= 50) {
@@ -1115,7 +1342,7 @@ else if (inputString.startsWith("eyecolor ")) {
                 Serial.print(F("Preset "));
                 Serial.print(i);
                 Serial.print(F(": "));
-                Serial.print(patternNames[pattern]);
+                Serial.print(bodyPatterns[pattern].name);
                 Serial.print(F(" (Pattern "));
                 Serial.print(pattern);
                 Serial.println(F(")"));
@@ -1173,6 +1400,222 @@ else if (inputString.startsWith("eyecolor ")) {
     // v5.0: System Monitoring
     else if (inputString == "sysinfo") {
         systemMonitor.printStatus();
+        ledOutput.printStatus();
+        adcStream.printStatus();
+        printPatternArenaStatus();
+    }
+    // v5.2: LED output control
+    else if (inputString == "selectiveshow on") {
+        ledOutput.setSelectiveShow(true);
+        Serial.println(F("Selective show enabled - unchanged outputs are skipped"));
+    }
+    else if (inputString == "selectiveshow off") {
+        ledOutput.setSelectiveShow(false);
+        Serial.println(F("Selective show disabled - all outputs sent every frame"));
+    }
+    else if (inputString.startsWith("ledrefresh ")) {
+        int interval = inputString.substring(11).toInt();
+        if (interval >= 0 && interval <= 10000) {
+            ledOutput.setRefreshInterval(interval);
+            Serial.print(F("LED refresh interval: "));
+            Serial.print(interval);
+            Serial.println(F(" ms"));
+        } else {
+            Serial.println(F("Invalid interval! Use 0-10000 ms (0 = never)"));
+        }
+    }
+    else if (inputString == "ledstats") {
+        ledOutput.printStatus();
+    }
+    else if (inputString == "ledstats reset") {
+        ledOutput.resetStats();
+        Serial.println(F("LED output statistics reset"));
+    }
+    else if (inputString == "ledbench" || inputString.startsWith("ledbench ")) {
+        int frames = 100;
+        if (inputString.length() > 9) {
+            frames = inputString.substring(9).toInt();
+        }
+        if (frames >= 1 && frames <= 1000) {
+            pauseRendering();
+            ledOutput.runBenchmark(frames);
+            resumeRendering();
+        } else {
+            Serial.println(F("Invalid frame count! Use 1-1000"));
+        }
+    }
+    else if (inputString == "ledsink null") {
+        ledOutput.setNullSink(true);
+        Serial.println(F("LED output discarded - rendering continues without driving the strips"));
+    }
+    else if (inputString == "ledsink hw") {
+        ledOutput.setNullSink(false);
+        Serial.print(F("LED output: "));
+        Serial.println(ledOutput.getBackendName());
+    }
+    // v5.2: Spectrum analyzer
+    else if (inputString == "audiobench" || inputString.startsWith("audiobench ")) {
+        int iterations = 100;
+        if (inputString.length() > 11) {
+            iterations = inputString.substring(11).toInt();
+        }
+        if (iterations >= 1 && iterations <= 1000) {
+            pauseRendering();
+            spectrumAnalyzer.runBenchmark(iterations);
+            resumeRendering();
+        } else {
+            Serial.println(F("Invalid iteration count! Use 1-1000"));
+        }
+    }
+    // v5.2: Beat detector
+    else if (inputString == "beat") {
+        beatDetector.printStatus();
+    }
+    else if (inputString == "beatsync on") {
+        beatDetector.setBeatSync(true);
+        Serial.println(F("Beat sync enabled - playlist/demo switch on the next downbeat"));
+    }
+    else if (inputString == "beatsync off") {
+        beatDetector.setBeatSync(false);
+        Serial.println(F("Beat sync disabled - playlist/demo switch on their timers"));
+    }
+    else if (inputString == "beattest") {
+        pauseRendering();
+        BeatDetector::runSelfTest();
+        resumeRendering();
+    }
+    // v5.2: Filter bank
+    else if (inputString == "filterbench" || inputString.startsWith("filterbench ")) {
+        long samples = 10000;
+        if (inputString.length() > 12) {
+            samples = inputString.substring(12).toInt();
+        }
+        if (samples >= 100 && samples <= 1000000) {
+            pauseRendering();
+            FilterBank::runBenchmark(samples);
+            resumeRendering();
+        } else {
+            Serial.println(F("Invalid sample count! Use 100-1000000"));
+        }
+    }
+    // v5.2: Audio replay
+    else if (inputString == "replay") {
+        audioReplay.printStatus();
+    }
+    else if (inputString.startsWith("replay load ")) {
+        pauseRendering();
+        audioReplay.loadWav(inputString.substring(12).toInt());
+        resumeRendering();
+    }
+    else if (inputString == "replay wav") {
+        audioReplay.playWav();
+    }
+    else if (inputString.startsWith("replay clicks ")) {
+        int bpm = inputString.substring(14).toInt();
+        if (bpm >= 60 && bpm <= 200) {
+            audioReplay.playClicks(bpm);
+        } else {
+            Serial.println(F("Invalid tempo! Use 60-200 BPM"));
+        }
+    }
+    else if (inputString == "replay bench" || inputString.startsWith("replay bench ")) {
+        int seconds = 30;
+        if (inputString.length() > 13) {
+            seconds = inputString.substring(13).toInt();
+        }
+        if (seconds >= 1 && seconds <= 600) {
+            pauseRendering();
+            audioReplay.runBenchmark(seconds);
+            resumeRendering();
+        } else {
+            Serial.println(F("Invalid duration! Use 1-600 seconds"));
+        }
+    }
+    else if (inputString == "replay off") {
+        audioReplay.stop();
+        Serial.println(F("Audio input: microphone"));
+    }
+    // v5.2: Frame profiler
+    else if (inputString == "perf") {
+        #if ENABLE_FRAME_PROFILER
+        frameProfiler.printStatus();
+        #else
+        Serial.println(F("Frame profiler disabled (ENABLE_FRAME_PROFILER)"));
+        #endif
+    }
+    else if (inputString == "perf reset") {
+        #if ENABLE_FRAME_PROFILER
+        frameProfiler.reset();
+        Serial.println(F("Frame profiler reset"));
+        #else
+        Serial.println(F("Frame profiler disabled (ENABLE_FRAME_PROFILER)"));
+        #endif
+    }
+    // v5.2: Live transitions
+    else if (inputString == "transition") {
+        transitionEngine.printStatus();
+    }
+    else if (inputString == "transition reset") {
+        transitionEngine.resetStats();
+        Serial.println(F("Transition counters reset"));
+    }
+    else if (inputString.startsWith("transition ms ")) {
+        int ms = inputString.substring(14).toInt();
+        if (ms >= 0 && ms <= MAX_TRANSITION_MS) {
+            transitionDuration = ms;
+            Serial.print(F("Transition length: "));
+            Serial.print(ms);
+            Serial.println(ms == 0 ? F(" ms (cut)") : F(" ms"));
+        } else {
+            Serial.print(F("Invalid length! Use 0-"));
+            Serial.println(MAX_TRANSITION_MS);
+        }
+    }
+    else if (inputString.startsWith("transition ")) {
+        String args = inputString.substring(11);
+        int space = args.indexOf(' ');
+        String name = (space > 0) ? args.substring(0, space) : args;
+        int mode = TransitionEngine::findMode(name.c_str());
+        int ms = (space > 0) ? args.substring(space + 1).toInt() : transitionDuration;
+        if (mode < 0) {
+            Serial.println(F("Unknown transition! Use fade, eased, stagger, wipe, dissolve, black"));
+        } else if (ms < 0 || ms > MAX_TRANSITION_MS) {
+            Serial.print(F("Invalid length! Use 0-"));
+            Serial.println(MAX_TRANSITION_MS);
+        } else {
+            transitionMode = mode;
+            transitionDuration = ms;
+            Serial.print(F("Transition: "));
+            Serial.print(TransitionEngine::getModeName(mode));
+            Serial.print(F(", "));
+            Serial.print(ms);
+            Serial.println(F(" ms"));
+        }
+    }
+    // v5.2: Golden frames
+    else if (inputString == "golden record") {
+        pauseRendering();
+        goldenFrames.record();
+        resumeRendering();
+    }
+    else if (inputString == "golden check") {
+        pauseRendering();
+        goldenFrames.check();
+        resumeRendering();
+    }
+    else if (inputString.startsWith("golden dump ")) {
+        String args = inputString.substring(12);
+        int space = args.indexOf(' ');
+        char set = args.charAt(0);
+        if ((set == 'b' || set == 'm') && space > 1) {
+            int pattern = args.substring(1, space).toInt();
+            int frame = args.substring(space + 1).toInt();
+            pauseRendering();
+            goldenFrames.dump(set == 'b' ? GOLDEN_BODY : GOLDEN_MOUTH, pattern, frame);
+            resumeRendering();
+        } else {
+            Serial.println(F("Usage: golden dump <b|m><pattern> <frame>"));
+        }
     }
     // v5.0: Event Logger
     else if (inputString == "eventlog") {
@@ -1200,6 +1643,7 @@ else if (inputString.startsWith("eyecolor ")) {
     // v5.0: Manual restart
     else if (inputString == "restart") {
         Serial.println(F("Restarting in 2 seconds..."));
+        renderPaused = true;  // v5.2: No frames while the mutex is held for 2 s
         delay(2000);
         ESP.restart();
     }
@@ -1210,8 +1654,12 @@ else if (inputString.startsWith("eyecolor ")) {
         for (int i = 0; i < playlistSize; i++) {
             String keyPat = "pl" + String(i) + "p";
             String keyDur = "pl" + String(i) + "d";
+            String keyMode = "pl" + String(i) + "t";   // v5.2
+            String keyMs = "pl" + String(i) + "m";     // v5.2
             preferences.putUChar(keyPat.c_str(), playlist[i].pattern);
             preferences.putUShort(keyDur.c_str(), playlist[i].duration);
+            preferences.putUChar(keyMode.c_str(), playlist[i].transitionMode);
+            preferences.putUShort(keyMs.c_str(), playlist[i].transitionMs);
         }
         Serial.print(F("Playlist saved ("));
         Serial.print(playlistSize);
@@ -1225,8 +1673,12 @@ else if (inputString.startsWith("eyecolor ")) {
             for (int i = 0; i < playlistSize; i++) {
                 String keyPat = "pl" + String(i) + "p";
                 String keyDur = "pl" + String(i) + "d";
+                String keyMode = "pl" + String(i) + "t";
+                String keyMs = "pl" + String(i) + "m";
                 playlist[i].pattern = preferences.getUChar(keyPat.c_str(), 1);
                 playlist[i].duration = preferences.getUShort(keyDur.c_str(), 10);
+                playlist[i].transitionMode = preferences.getUChar(keyMode.c_str(), TRANSITION_MODE_DEFAULT);
+                playlist[i].transitionMs = preferences.getUShort(keyMs.c_str(), TRANSITION_MS_DEFAULT);
             }
             Serial.print(F("Playlist loaded ("));
             Serial.print(playlistSize);
@@ -13,5 +13,6 @@ void printBlockColors();
 void printCurrentSettings();
 void printBlockColors();
 void parsePlaylistCommand(String command);
+void parseRouteCommand(String command);  // v5.2
 
 #endif
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "settings.h"
 #include "preset_manager.h"  // v5.0.1: For unified preset system
+#include "pattern_registry.h"  // v5.2: Pattern counts
+#include "audio_routing.h"     // v5.2: Audio routing table
 
 void initSettings() {
     preferences.begin("djrex", false);
@@ -85,23 +87,45 @@ void loadSettings() {
     // v5.0: Startup sequence setting
     startupSequenceEnabled = preferences.getBool("startupSeq", STARTUP_SEQUENCE_ENABLED);
 
+    // v5.2: Render frame rate
+    targetFPS = preferences.getUChar("fps", FRAMES_PER_SECOND);
+    timeScale = preferences.getUShort("timeScale", TIME_SCALE_DEFAULT);
+
+    // v5.2: Default transition
+    transitionMode = preferences.getUChar("transMode", TRANSITION_FADE);
+    transitionDuration = preferences.getUShort("transMs", TRANSITION_DURATION_MS);
+
     // Validate ranges
     if (currentPattern >= NUM_PATTERNS) currentPattern = 16;
     if (ledBrightness == 0) ledBrightness = 90;
     if (effectSpeed == 0) effectSpeed = 128;
     if (sideBlinkRate == 0) sideBlinkRate = 128;
     if (blockBlinkRate == 0) blockBlinkRate = 128;
-    if (audioMode > AUDIO_ALL) audioMode = AUDIO_ALL;
+    if (audioMode >= NUM_AUDIO_MODES) audioMode = AUDIO_ALL;
     if (audioSensitivity == 0 || audioSensitivity > 10) audioSensitivity = 5;
     if (audioInputMode > INPUT_LINE_IN) audioInputMode = INPUT_MIC;  // v5.1
     if (mouthPattern >= NUM_MOUTH_PATTERNS) mouthPattern = 1;
     if (eyeMode >= 3) eyeMode = 0;
     if (mouthSplitMode >= 5) mouthSplitMode = 0;
+    if (targetFPS < MIN_FRAMES_PER_SECOND || targetFPS > MAX_FRAMES_PER_SECOND) targetFPS = FRAMES_PER_SECOND;
+    if (timeScale < MIN_TIME_SCALE || timeScale > MAX_TIME_SCALE) timeScale = TIME_SCALE_DEFAULT;
+    if (transitionMode >= NUM_TRANSITION_MODES) transitionMode = TRANSITION_FADE;
+    if (transitionDuration > MAX_TRANSITION_MS) transitionDuration = TRANSITION_DURATION_MS;
     
     // Validate eye flicker settings
     if (eyeFlickerMinTime < 50) eyeFlickerMinTime = 200;
     if (eyeFlickerMaxTime < eyeFlickerMinTime) eyeFlickerMaxTime = eyeFlickerMinTime + 400;
     if (eyeFlickerMaxTime > 5000) eyeFlickerMaxTime = 1600;
+
+    // v5.2: Custom routing table (the other audio modes are presets)
+    AudioRoute routes[NUM_AUDIO_ZONES];
+    if (audioMode == AUDIO_CUSTOM &&
+        preferences.getBytes("audioRoutes", routes, sizeof(routes)) == sizeof(routes)) {
+        audioRouter.setRoutes(routes);
+    } else {
+        if (audioMode == AUDIO_CUSTOM) audioMode = AUDIO_ALL;
+        audioRouter.loadPreset(audioMode);
+    }
     
     Serial.println(F("Settings loaded"));
 }
@@ -169,11 +193,17 @@ void saveSettings() {
     preferences.putUChar("audioSens", audioSensitivity);
     preferences.putBool("autoGain", audioAutoGain);
     preferences.putUChar("audioInput", audioInputMode);  // v5.1
+    preferences.putBytes("audioRoutes", audioRouter.getRoutes(), NUM_AUDIO_ZONES * sizeof(AudioRoute));  // v5.2
     
     preferences.putUChar("eyeBright", eyeBrightness);
     preferences.putUChar("bodyBright", bodyBrightness);
     preferences.putUChar("mouthOuter", mouthOuterBoost);
     preferences.putUChar("mouthInner", mouthInnerBoost);
+
+    preferences.putUChar("fps", targetFPS);  // v5.2
+    preferences.putUShort("timeScale", timeScale);  // v5.2
+    preferences.putUChar("transMode", transitionMode);  // v5.2
+    preferences.putUShort("transMs", transitionDuration);  // v5.2
     
     Serial.println(F("Settings saved"));
 }
@@ -244,6 +274,7 @@ void resetToDefaults() {
     
     // Reset audio settings
     audioMode = AUDIO_ALL;
+    audioRouter.loadPreset(audioMode);
     audioSensitivity = MIC_DEFAULT_SENSITIVITY;
     audioAutoGain = true;
     audioInputMode = INPUT_MIC;  // v5.1
@@ -253,6 +284,14 @@ void resetToDefaults() {
     bodyBrightness = 100;
     mouthOuterBoost = 80;
     mouthInnerBoost = 150;
+
+    // v5.2: Reset render frame rate
+    targetFPS = FRAMES_PER_SECOND;
+    timeScale = TIME_SCALE_DEFAULT;
+
+    // v5.2: Reset default transition
+    transitionMode = TRANSITION_FADE;
+    transitionDuration = TRANSITION_DURATION_MS;
     
     Serial.println(F("Factory reset complete"));
 }
@@ -0,0 +1,218 @@
+// spectrum.cpp - v5.2 Fixed-Point FFT Spectrum Analyzer
+#include "spectrum.h"
+#include "globals.h"
+#include "audio.h"
+#include "render_clock.h"
+#include "adc_stream.h"
+#include <math.h>
+
+SpectrumAnalyzer spectrumAnalyzer;
+
+// |re + j*im| without a square root (alpha max plus beta min, ~4% error)
+static uint32_t magnitude(int16_t re, int16_t im) {
+    uint32_t a = abs(re);
+    uint32_t b = abs(im);
+    return (a > b) ? a + (b * 3) / 8 : b + (a * 3) / 8;
+}
+
+void SpectrumAnalyzer::begin() {
+    for (uint16_t i = 0; i < SPECTRUM_FFT_SIZE; i++) {
+        float hann = 0.5f - 0.5f * cosf(2.0f * (float)M_PI * i / (SPECTRUM_FFT_SIZE - 1));
+        window[i] = (int16_t)(hann * 32767.0f);
+    }
+    for (uint16_t k = 0; k < SPECTRUM_FFT_SIZE / 2; k++) {
+        float angle = 2.0f * (float)M_PI * k / SPECTRUM_FFT_SIZE;
+        cosTable[k] = (int16_t)(cosf(angle) * 32767.0f);
+        sinTable[k] = (int16_t)(sinf(angle) * 32767.0f);
+    }
+
+    // Log-spaced band edges from SPECTRUM_MIN_FREQ to Nyquist, at least one bin each
+    const float binHz = (float)SPECTRUM_SAMPLE_RATE / SPECTRUM_FFT_SIZE;
+    const float ratio = powf((SPECTRUM_SAMPLE_RATE / 2.0f) / SPECTRUM_MIN_FREQ, 1.0f / SPECTRUM_BANDS);
+    float edgeHz = SPECTRUM_MIN_FREQ;
+    bandEdge[0] = 1;  // Skip the DC bin
+    for (uint8_t b = 1; b <= SPECTRUM_BANDS; b++) {
+        edgeHz *= ratio;
+        uint16_t bin = (uint16_t)(edgeHz / binHz + 0.5f);
+        if (bin <= bandEdge[b - 1]) bin = bandEdge[b - 1] + 1;
+        bandEdge[b] = min<uint16_t>(bin, SPECTRUM_FFT_SIZE / 2);
+    }
+    bandEdge[SPECTRUM_BANDS] = SPECTRUM_FFT_SIZE / 2;
+
+    captureTimeUs = 0;
+    transformTimeUs = 0;
+    reset();
+}
+
+void SpectrumAnalyzer::reset() {
+    for (uint8_t b = 0; b < SPECTRUM_BANDS; b++) {
+        bands[b] = 0;
+        peaks[b] = 0;
+        peakTime[b] = 0;
+    }
+    lastUpdate = 0;
+}
+
+uint16_t SpectrumAnalyzer::getBandLowHz(uint8_t band) const {
+    return (uint32_t)bandEdge[band] * SPECTRUM_SAMPLE_RATE / SPECTRUM_FFT_SIZE;
+}
+
+void SpectrumAnalyzer::update() {
+    if (renderMillis() - lastUpdate < SPECTRUM_INTERVAL_MS) return;
+    lastUpdate = renderMillis();
+
+    uint32_t start = micros();
+    capture();
+    uint32_t captured = micros();
+    transform(re, im);
+    publish();
+
+    captureTimeUs = captured - start;
+    transformTimeUs = micros() - captured;
+}
+
+void SpectrumAnalyzer::capture() {
+    // v5.2: The DMA stream already holds the newest samples (DC removed)
+    if (adcStream.isRunning() && !isAdcSourceOverridden()) {
+        adcStream.copyHistory(re, SPECTRUM_FFT_SIZE);
+        for (uint16_t i = 0; i < SPECTRUM_FFT_SIZE; i++) {
+            int32_t sample = constrain(re[i], -2048, 2047) << 4;
+            re[i] = (int16_t)((sample * window[i]) >> 15);
+            im[i] = 0;
+        }
+        return;
+    }
+
+    const uint32_t periodUs = 1000000UL / SPECTRUM_SAMPLE_RATE;
+    // The virtual clock (golden frames) reads a synthetic source - no need to pace it
+    bool paced = !isRenderClockVirtual();
+    uint32_t next = micros();
+
+    for (uint16_t i = 0; i < SPECTRUM_FFT_SIZE; i++) {
+        if (paced) {
+            while ((int32_t)(micros() - next) < 0) {
+            }
+            next += periodUs;
+        }
+        // 12-bit sample around the DC offset, scaled to Q15 and windowed
+        int32_t sample = readAdcSample() - adcDCOffset;
+        sample = constrain(sample, -2048, 2047) * 16;
+        re[i] = (int16_t)((sample * window[i]) >> 15);
+        im[i] = 0;
+    }
+}
+
+void SpectrumAnalyzer::transform(int16_t* re, int16_t* im) {
+    // Bit-reversal permutation
+    for (uint16_t i = 1, j = 0; i < SPECTRUM_FFT_SIZE; i++) {
+        uint16_t bit = SPECTRUM_FFT_SIZE >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            int16_t t = re[i];
+            re[i] = re[j];
+            re[j] = t;
+        }
+    }
+
+    // Radix-2 butterflies, halved every stage so the Q15 values cannot overflow
+    for (uint16_t size = 2; size <= SPECTRUM_FFT_SIZE; size <<= 1) {
+        uint16_t half = size >> 1;
+        uint16_t step = SPECTRUM_FFT_SIZE / size;
+        for (uint16_t i = 0; i < SPECTRUM_FFT_SIZE; i += size) {
+            for (uint16_t j = 0; j < half; j++) {
+                int32_t wr = cosTable[j * step];
+                int32_t wi = -sinTable[j * step];
+                uint16_t a = i + j;
+                uint16_t b = a + half;
+
+                int32_t tr = (wr * re[b] - wi * im[b]) >> 15;
+                int32_t ti = (wr * im[b] + wi * re[b]) >> 15;
+                re[b] = (re[a] - tr) >> 1;
+                im[b] = (im[a] - ti) >> 1;
+                re[a] = (re[a] + tr) >> 1;
+                im[a] = (im[a] + ti) >> 1;
+            }
+        }
+    }
+}
+
+void SpectrumAnalyzer::publish() {
+    uint32_t now = renderMillis();
+
+    for (uint8_t b = 0; b < SPECTRUM_BANDS; b++) {
+        // Strongest bin, so wide high bands do not collect more noise than narrow low ones
+        uint32_t energy = 0;
+        for (uint16_t k = bandEdge[b]; k < bandEdge[b + 1]; k++) {
+            energy = max(energy, magnitude(re[k], im[k]));
+        }
+
+        // 1/8-octave steps above the floor; audiosens 1-10 lifts the floor by up to 1.25 octaves
+        int16_t level = (int16_t)log2Eighths(energy) + audioSensitivity - SPECTRUM_FLOOR;
+        level = constrain(level * 4, 0, 255);
+
+        // Instant attack, linear decay
+        uint8_t band = max<int16_t>(level, qsub8(bands[b], SPECTRUM_DECAY));
+        bands[b] = band;
+
+        if (band >= peaks[b]) {
+            peaks[b] = band;
+            peakTime[b] = now;
+        } else if (now - peakTime[b] > SPECTRUM_PEAK_HOLD_MS) {
+            peaks[b] = qsub8(peaks[b], SPECTRUM_PEAK_DECAY);
+        }
+    }
+}
+
+void SpectrumAnalyzer::runBenchmark(uint16_t iterations) {
+    // Private buffers - the audio task keeps using re/im while this runs
+    int16_t testSignal[SPECTRUM_FFT_SIZE];
+    int16_t benchRe[SPECTRUM_FFT_SIZE];
+    int16_t benchIm[SPECTRUM_FFT_SIZE];
+    for (uint16_t i = 0; i < SPECTRUM_FFT_SIZE; i++) {
+        // Windowed full-scale sine at 1/8 of the sample rate
+        uint16_t k = (i * (SPECTRUM_FFT_SIZE / 8)) % SPECTRUM_FFT_SIZE;
+        int32_t sample = (k < SPECTRUM_FFT_SIZE / 2) ? sinTable[k] : -sinTable[k - SPECTRUM_FFT_SIZE / 2];
+        testSignal[i] = (int16_t)((sample * window[i]) >> 15);
+    }
+
+    uint32_t start = micros();
+    for (uint16_t i = 0; i < iterations; i++) {
+        memcpy(benchRe, testSignal, sizeof(benchRe));
+        memset(benchIm, 0, sizeof(benchIm));
+        transform(benchRe, benchIm);
+    }
+    uint32_t avgUs = (micros() - start) / iterations;
+
+    Serial.println(F("=== Spectrum Benchmark ==="));
+    Serial.print(F("FFT size: "));
+    Serial.print(SPECTRUM_FFT_SIZE);
+    Serial.print(F(" points @ "));
+    Serial.print(SPECTRUM_SAMPLE_RATE);
+    Serial.println(F(" Hz"));
+    Serial.print(F("Transform: "));
+    Serial.print(avgUs);
+    Serial.print(F(" us (avg of "));
+    Serial.print(iterations);
+    Serial.println(F(")"));
+    Serial.print(F("Capture: "));
+    Serial.print(SPECTRUM_FFT_SIZE * 1000000UL / SPECTRUM_SAMPLE_RATE);
+    Serial.println(F(" us"));
+    Serial.print(F("Last update: "));
+    Serial.print(captureTimeUs + transformTimeUs);
+    Serial.print(F(" us of "));
+    Serial.print(SPECTRUM_INTERVAL_MS * 1000UL);
+    Serial.println(F(" us budget"));
+    Serial.println(F("Bands (Hz: level/peak):"));
+    for (uint8_t b = 0; b < SPECTRUM_BANDS; b++) {
+        Serial.print(F("  "));
+        Serial.print(getBandLowHz(b));
+        Serial.print(F(": "));
+        Serial.print(bands[b]);
+        Serial.print(F("/"));
+        Serial.println(peaks[b]);
+    }
+    Serial.println(F("=========================="));
+}
@@ -0,0 +1,51 @@
+// spectrum.h - v5.2 Fixed-Point FFT Spectrum Analyzer
+#ifndef SPECTRUM_H
+#define SPECTRUM_H
+
+#include "config.h"
+
+// Takes the newest SPECTRUM_FFT_SIZE samples from the DMA stream (or captures
+// a burst with readAdcSample() without it), runs a Hann-windowed Q15
+// radix-2 FFT and publishes SPECTRUM_BANDS log-spaced band levels (0-255)
+// with smoothing and peak hold. update() runs inside updateAudio(); the
+// visualizers read the bands from the frame's AudioFeatures snapshot.
+class SpectrumAnalyzer {
+public:
+    void begin();
+    void reset();
+
+    // Capture and transform if SPECTRUM_INTERVAL_MS has passed (audio task)
+    void update();
+
+    uint8_t getBand(uint8_t band) const { return bands[band]; }
+    uint8_t getPeak(uint8_t band) const { return peaks[band]; }
+    uint16_t getBandLowHz(uint8_t band) const;
+
+    // Time the transform and report it against the audio task budget
+    void runBenchmark(uint16_t iterations);
+
+private:
+    void capture();
+    void transform(int16_t* re, int16_t* im);  // In place
+    void publish();
+
+    int16_t re[SPECTRUM_FFT_SIZE];
+    int16_t im[SPECTRUM_FFT_SIZE];
+
+    int16_t window[SPECTRUM_FFT_SIZE];
+    int16_t cosTable[SPECTRUM_FFT_SIZE / 2];
+    int16_t sinTable[SPECTRUM_FFT_SIZE / 2];
+    uint8_t bandEdge[SPECTRUM_BANDS + 1];  // First FFT bin of each band
+
+    volatile uint8_t bands[SPECTRUM_BANDS];
+    volatile uint8_t peaks[SPECTRUM_BANDS];
+    uint32_t peakTime[SPECTRUM_BANDS];
+    uint32_t lastUpdate;
+
+    uint32_t captureTimeUs;
+    uint32_t transformTimeUs;
+};
+
+extern SpectrumAnalyzer spectrumAnalyzer;
+
+#endif
@@ -1,6 +1,7 @@
 // startup_sequence.cpp - v5.0 Animated Boot Sequence
 #include "startup_sequence.h"
 #include "helpers.h"
+#include "led_output.h"
 #include <Arduino.h>
 
 StartupSequence startupSequence;
@@ -33,7 +34,7 @@ void StartupSequence::runPhase() {
             fill_solid(DJLEDs_Left, NUM_LEDS_PER_PANEL, CRGB::Black);
             fill_solid(DJLEDs_Eyes, NUM_EYES, CRGB::Black);
             fill_solid(DJLEDs_Mouth, NUM_MOUTH_LEDS, CRGB::Black);
-            FastLED.show();
+            ledOutput.show();
             if (elapsed > 200) nextPhase();
             break;
 
@@ -65,7 +66,7 @@ void StartupSequence::runPhase() {
                 fill_solid(DJLEDs_Mouth, NUM_MOUTH_LEDS, CRGB::Black);
                 nextPhase();
             }
-            FastLED.show();
+            ledOutput.show();
             break;
 
         case PHASE_EYES_ON:
@@ -75,7 +76,7 @@ void StartupSequence::runPhase() {
                 CRGB eyeColor = CRGB::OrangeRed;
                 eyeColor.fadeToBlackBy(255 - brightness);
                 fill_solid(DJLEDs_Eyes, NUM_EYES, eyeColor);
-                FastLED.show();
+                ledOutput.show();
                 if (elapsed > 400) nextPhase();
             }
             break;
@@ -104,7 +105,7 @@ void StartupSequence::runPhase() {
                         }
                     }
                 }
-                FastLED.show();
+                ledOutput.show();
                 if (elapsed > 600) nextPhase();
             }
             break;
@@ -128,7 +129,7 @@ void StartupSequence::runPhase() {
                     DJLEDs_Middle[revPos] = CRGB::OrangeRed;
                     DJLEDs_Left[revPos] = CRGB::OrangeRed;
                 }
-                FastLED.show();
+                ledOutput.show();
                 if (elapsed > 1500) nextPhase();
             }
             break;
@@ -144,7 +145,7 @@ void StartupSequence::runPhase() {
                 fadeToBlackBy(DJLEDs_Middle, NUM_LEDS_PER_PANEL, 30);
                 fadeToBlackBy(DJLEDs_Left, NUM_LEDS_PER_PANEL, 30);
             }
-            FastLED.show();
+            ledOutput.show();
             if (elapsed > 500) nextPhase();
             break;
 
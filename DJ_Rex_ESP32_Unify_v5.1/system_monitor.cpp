@@ -7,6 +7,10 @@
 
 SystemMonitor systemMonitor;
 
+// v5.2: Guards the frame counters - written by the render task, read and
+// reset by the loop task (possibly on the other core)
+static portMUX_TYPE frameStatsMux = portMUX_INITIALIZER_UNLOCKED;
+
 // Safe pattern to switch to on critical errors (0 = LEDs Off)
 #define SAFE_PATTERN 0
 #define AUTO_RESTART_THRESHOLD 10
@@ -54,6 +58,40 @@ void SystemMonitor::update() {
 void SystemMonitor::updateLoopStats() {
     loopsPerSecond = loopCounter - lastLoopCount;
     lastLoopCount = loopCounter;
+
+    // v5.2: Frame statistics over the last second - take and reset the
+    // render task's sums in one step so no frame is lost in between
+    portENTER_CRITICAL(&frameStatsMux);
+    uint32_t frames = frameCounter;
+    uint32_t sumUs = frameTimeSumUs;
+    uint32_t samples = frameTimeSamples;
+    frameTimeSumUs = 0;
+    frameTimeSamples = 0;
+    portEXIT_CRITICAL(&frameStatsMux);
+
+    framesPerSecond = frames - lastFrameCount;
+    lastFrameCount = frames;
+    if (samples > 0) {
+        frameTimeAvgUs = sumUs / samples;
+    }
+}
+
+// v5.2: Called by the render task once per frame
+void SystemMonitor::recordFrame(uint32_t frameTimeUs, uint32_t budgetUs) {
+    portENTER_CRITICAL(&frameStatsMux);
+    frameCounter++;
+    frameBudgetUs = budgetUs;
+    lastFrameTimeUs = frameTimeUs;
+    frameTimeSumUs += frameTimeUs;
+    frameTimeSamples++;
+
+    if (frameTimeUs > frameTimeMaxUs) {
+        frameTimeMaxUs = frameTimeUs;
+    }
+    if (frameTimeUs > budgetUs) {
+        frameOverruns++;
+    }
+    portEXIT_CRITICAL(&frameStatsMux);
 }
 
 void SystemMonitor::checkMemory() {
@@ -128,6 +166,27 @@ void SystemMonitor::printStatus() {
     Serial.println(F(" bytes"));
     Serial.print(F("Loops/sec: "));
     Serial.println(getLoopsPerSecond(), 1);
+
+    // v5.2: Render task frame timing
+    Serial.print(F("Frames/sec: "));
+    Serial.print(getFramesPerSecond(), 1);
+    Serial.print(F(" (target "));
+    Serial.print(targetFPS);
+    Serial.println(F(")"));
+    Serial.print(F("Frame Time: "));
+    Serial.print(lastFrameTimeUs);
+    Serial.print(F(" us last, "));
+    Serial.print(getFrameTimeAvg());
+    Serial.print(F(" us avg, "));
+    Serial.print(getFrameTimeMax());
+    Serial.println(F(" us max"));
+    Serial.print(F("Frame Budget: "));
+    Serial.print(frameBudgetUs);
+    Serial.print(F(" us ("));
+    Serial.print(frameBudgetUs > frameTimeAvgUs ? frameBudgetUs - frameTimeAvgUs : 0);
+    Serial.println(F(" us left on avg)"));
+    Serial.print(F("Frame Overruns: "));
+    Serial.println(getFrameOverruns());
     Serial.print(F("Health: "));
     Serial.println(isHealthy() ? "OK" : "WARNING");
     Serial.println(F("===================="));
@@ -149,6 +208,22 @@ float SystemMonitor::getLoopsPerSecond() {
     return loopsPerSecond;
 }
 
+uint32_t SystemMonitor::getFrameTimeAvg() {
+    return frameTimeAvgUs;
+}
+
+uint32_t SystemMonitor::getFrameTimeMax() {
+    return frameTimeMaxUs;
+}
+
+uint32_t SystemMonitor::getFrameOverruns() {
+    return frameOverruns;
+}
+
+float SystemMonitor::getFramesPerSecond() {
+    return framesPerSecond;
+}
+
 bool SystemMonitor::isHealthy() {
     return consecutiveErrors < MAX_CONSECUTIVE_ERRORS && !isMemoryCritical();
 }
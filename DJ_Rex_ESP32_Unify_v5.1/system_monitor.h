@@ -15,6 +15,13 @@ public:
     uint32_t getLoopCounter();
     float getLoopsPerSecond();
 
+    // v5.2: Render task frame timing
+    void recordFrame(uint32_t frameTimeUs, uint32_t budgetUs);
+    uint32_t getFrameTimeAvg();
+    uint32_t getFrameTimeMax();
+    uint32_t getFrameOverruns();
+    float getFramesPerSecond();
+
     bool isHealthy();
     bool isMemoryLow();
     bool isMemoryCritical();
@@ -29,6 +36,18 @@ private:
     uint8_t consecutiveErrors = 0;
     uint32_t minFreeHeap = 0xFFFFFFFF;
 
+    // v5.2: Frame timing (written by the render task under frameStatsMux)
+    uint32_t frameCounter = 0;
+    uint32_t lastFrameCount = 0;
+    float framesPerSecond = 0;
+    uint32_t frameBudgetUs = 0;
+    uint32_t lastFrameTimeUs = 0;
+    uint32_t frameTimeSumUs = 0;
+    uint32_t frameTimeSamples = 0;
+    uint32_t frameTimeAvgUs = 0;
+    uint32_t frameTimeMaxUs = 0;
+    uint32_t frameOverruns = 0;
+
     void checkMemory();
     void checkHealth();
     void updateLoopStats();
@@ -0,0 +1,435 @@
+// transition.cpp - v5.2 Live Dual-Render Transitions
+#include "transition.h"
+#include "pattern_registry.h"
+#include "eyes.h"
+#include "patterns_mouth.h"
+#include "render_clock.h"
+#include "geometry.h"
+#include "pattern_arena.h"
+
+TransitionEngine transitionEngine;
+
+// Names used by the "transition" and "playlist" commands
+static const char* const modeNames[NUM_TRANSITION_MODES] = {
+    "fade", "eased", "stagger", "wipe", "dissolve", "black"
+};
+
+static const char* const channelNames[NUM_TRANSITION_CHANNELS] = {
+    "Body:  ", "Eyes:  ", "Mouth: "
+};
+
+// Smoothstep 3t^2 - 2t^3 on 0-255, computed at compile time
+struct EaseTable {
+    uint8_t value[256];
+};
+
+constexpr EaseTable buildEaseTable() {
+    EaseTable table = {};
+    for (uint16_t t = 0; t < 256; t++) {
+        table.value[t] = (uint8_t)(t * t * (3 * 255 - 2 * t) / (255UL * 255UL));
+    }
+    return table;
+}
+
+static constexpr EaseTable easeTable = buildEaseTable();
+
+static_assert(easeTable.value[0] == 0 && easeTable.value[255] == 255, "Ease table must span 0-255");
+
+// LED range of each zone, in channel order
+static const uint8_t zoneFirst[NUM_TRANSITION_CHANNELS] = {ZONE_BODY_START, ZONE_EYES_START, ZONE_MOUTH_START};
+static const uint8_t zoneCount[NUM_TRANSITION_CHANNELS] = {TOTAL_BODY_LEDS, NUM_EYES, NUM_MOUTH_LEDS};
+
+// Position of v between lo and hi, scaled to 0-span
+static uint8_t spreadOver(uint8_t v, uint8_t lo, uint8_t hi, uint8_t span) {
+    return (hi > lo) ? (v - lo) * span / (hi - lo) : 0;
+}
+
+void TransitionEngine::start(uint8_t newPattern, uint8_t newMode, uint16_t durationMs) {
+    if (newPattern == currentPattern) return; // Don't transition to the same pattern
+
+    if (durationMs == 0) {
+        // Cut: the pattern continues from the frame on screen
+        endChannel(CHANNEL_BODY);
+        currentPattern = newPattern;
+        return;
+    }
+
+    // To or from Off the face appears or disappears with the body
+    bool withFace = (currentPattern == 0 || newPattern == 0);
+    if (withFace) {
+        endChannel(CHANNEL_EYES);
+        endChannel(CHANNEL_MOUTH);
+    }
+
+    // The outgoing pattern keeps its state in the idle arena slot, the
+    // incoming one enters in the other (replacing an older outgoing pattern)
+    bodyArena.swapSlots();
+    channels[CHANNEL_BODY].outgoingPattern = currentPattern;
+    currentPattern = newPattern;
+
+    beginChannel(CHANNEL_BODY, ZONE_BODY_START, withFace ? NUM_TOTAL_LEDS : TOTAL_BODY_LEDS,
+                 newMode, durationMs, true);
+}
+
+void TransitionEngine::startMouth(uint8_t newPattern) {
+    if (newPattern == mouthPattern) return;
+
+    // No mouth on screen, or the body transition already fades it: switch directly
+    if (currentPattern == 0 || !mouthEnabled || bodyCoversFace() || transitionDuration == 0) {
+        endChannel(CHANNEL_MOUTH);
+        mouthPattern = newPattern;
+        return;
+    }
+
+    mouthArena.swapSlots();
+    channels[CHANNEL_MOUTH].outgoingPattern = mouthPattern;
+    mouthPattern = newPattern;
+
+    beginChannel(CHANNEL_MOUTH, ZONE_MOUTH_START, NUM_MOUTH_LEDS, transitionMode, transitionDuration, true);
+}
+
+void TransitionEngine::startEyes() {
+    // No eyes on screen, or the body transition already fades them
+    if (currentPattern == 0 || bodyCoversFace() || transitionDuration == 0) return;
+
+    beginChannel(CHANNEL_EYES, ZONE_EYES_START, NUM_EYES, transitionMode, transitionDuration, false);
+}
+
+void TransitionEngine::beginChannel(uint8_t id, uint8_t first, uint8_t count, uint8_t newMode,
+                                    uint16_t durationMs, bool live) {
+    Channel& channel = channels[id];
+
+    if (!isActive()) {
+        // First running channel: patterns render into the incoming frame from now on
+        memcpy(frames[0], allLEDs, sizeof(allLEDs));
+        setRenderTarget(frames[0]);
+    }
+
+    size_t bytes = count * sizeof(CRGB);
+    if (channel.active && live) {
+        // The incoming pattern becomes the outgoing one and keeps its frame
+        memcpy(&frames[1][first], &frames[0][first], bytes);
+    } else {
+        memcpy(&frames[1][first], &allLEDs[first], bytes);
+    }
+    // The new pattern starts from what is on screen, like a direct switch
+    memcpy(&frames[0][first], &allLEDs[first], bytes);
+
+    channel.first = first;
+    channel.count = count;
+    channel.mode = newMode < NUM_TRANSITION_MODES ? newMode : (uint8_t)TRANSITION_FADE;
+    channel.duration = durationMs;
+    buildTables(channel);
+
+    channel.active = true;
+    channel.outgoingFrozen = !live;
+    channel.startTime = renderMillis();
+    overBudgetFrames = 0;
+    transitionCount++;
+}
+
+void TransitionEngine::endChannel(uint8_t id) {
+    if (!channels[id].active) return;
+
+    channels[id].active = false;
+    // The outgoing pattern is done: exit it and free its slot
+    if (id == CHANNEL_BODY) {
+        bodyArena.releaseIdle();
+    } else if (id == CHANNEL_MOUTH) {
+        mouthArena.releaseIdle();
+    }
+    if (!isActive()) {
+        finish();
+    }
+}
+
+bool TransitionEngine::isActive() const {
+    for (const Channel& channel : channels) {
+        if (channel.active) return true;
+    }
+    return false;
+}
+
+bool TransitionEngine::bodyCoversFace() const {
+    return channels[CHANNEL_BODY].active && channels[CHANNEL_BODY].count > TOTAL_BODY_LEDS;
+}
+
+void TransitionEngine::update() {
+    if (!isActive()) {
+        return; // Nothing to do
+    }
+
+    uint32_t now = renderMillis();
+
+    // Done, or the pattern was switched back directly (demo, preset)
+    for (uint8_t id = 0; id < NUM_TRANSITION_CHANNELS; id++) {
+        Channel& channel = channels[id];
+        if (!channel.active) continue;
+
+        bool switchedAway = false;
+        if (id == CHANNEL_BODY) {
+            switchedAway = (currentPattern == channel.outgoingPattern);
+        } else if (id == CHANNEL_MOUTH) {
+            switchedAway = (mouthPattern == channel.outgoingPattern || !mouthEnabled);
+        }
+        // The face channels stop when the face is no longer rendered
+        if (id != CHANNEL_BODY && currentPattern == 0) {
+            switchedAway = true;
+        }
+
+        if (now - channel.startTime >= channel.duration || switchedAway) {
+            endChannel(id);
+        }
+    }
+    if (!isActive()) {
+        return;
+    }
+
+    uint32_t begin = micros();
+
+    const Channel& body = channels[CHANNEL_BODY];
+    const Channel& mouth = channels[CHANNEL_MOUTH];
+    if (body.active && !body.outgoingFrozen) {
+        renderOutgoingBody();
+    }
+    if (mouth.active && !mouth.outgoingFrozen) {
+        renderOutgoingMouth();
+    }
+
+    // Running channels blend their range, the other zones are copied
+    bool faceInBody = bodyCoversFace();
+    for (uint8_t id = 0; id < NUM_TRANSITION_CHANNELS; id++) {
+        const Channel& channel = channels[id];
+        if (channel.active) {
+            composite(channel, (now - channel.startTime) * 255 / channel.duration);
+        } else if (id == CHANNEL_BODY || !faceInBody) {
+            memcpy(&allLEDs[zoneFirst[id]], &frames[0][zoneFirst[id]], zoneCount[id] * sizeof(CRGB));
+        }
+    }
+
+    lastCostUs = micros() - begin;
+    if (lastCostUs > maxCostUs) maxCostUs = lastCostUs;
+    sumCostUs += lastCostUs;
+    costFrames++;
+
+    // A transition must not drop frames: if the outgoing renders do not fit,
+    // the rest of the running fades blend the last outgoing frame instead
+    if (lastCostUs > TRANSITION_BUDGET_US) {
+        if (++overBudgetFrames >= TRANSITION_OVER_BUDGET_FRAMES) {
+            bool froze = false;
+            for (Channel& channel : channels) {
+                if (channel.active && !channel.outgoingFrozen) {
+                    channel.outgoingFrozen = true;
+                    froze = true;
+                }
+            }
+            if (froze) frozenCount++;
+        }
+    } else {
+        overBudgetFrames = 0;
+    }
+}
+
+void TransitionEngine::finish() {
+    for (Channel& channel : channels) {
+        channel.active = false;
+    }
+    bodyArena.releaseIdle();
+    mouthArena.releaseIdle();
+    if (renderLEDs == allLEDs) return;  // Already rendering into the output
+
+    memcpy(allLEDs, frames[0], sizeof(allLEDs));
+    setRenderTarget(allLEDs);
+}
+
+void TransitionEngine::buildTables(Channel& channel) {
+    // Ramp width in progress steps: how long one LED takes to change
+    uint8_t width = 255;
+    switch (channel.mode) {
+        case TRANSITION_STAGGER:  width = TRANSITION_STAGGER_WIDTH; break;
+        case TRANSITION_WIPE:     width = TRANSITION_WIPE_WIDTH; break;
+        case TRANSITION_DISSOLVE: width = TRANSITION_DISSOLVE_WIDTH; break;
+        default: break;
+    }
+
+    for (uint16_t d = 0; d < 256; d++) {
+        uint8_t linear = (d >= width) ? 255 : d * 255 / width;
+        channel.ramp[d] = (channel.mode == TRANSITION_FADE) ? linear : easeTable.value[linear];
+    }
+
+    // Wipe and face stagger run across the extent of the channel's own LEDs
+    uint8_t end = channel.first + channel.count;
+    uint8_t minX = 255, maxX = 0, minY = 255, maxY = 0;
+    for (uint8_t i = channel.first; i < end; i++) {
+        const LedPoint& p = ledGeometry.points[i];
+        minX = min(minX, p.x);
+        maxX = max(maxX, p.x);
+        minY = min(minY, p.y);
+        maxY = max(maxY, p.y);
+    }
+
+    // Start thresholds spread over what the ramp leaves of the transition
+    uint8_t span = 255 - width;
+    for (uint8_t i = channel.first; i < end; i++) {
+        switch (channel.mode) {
+            case TRANSITION_STAGGER:
+                if (i < TOTAL_BODY_LEDS) {
+                    // Left panel first (panels are stored Right, Middle, Left)
+                    threshold[i] = (2 - i / NUM_LEDS_PER_PANEL) * span / 2;
+                } else if (channel.first < TOTAL_BODY_LEDS) {
+                    threshold[i] = span / 2;  // The face goes with the middle panel
+                } else {
+                    threshold[i] = spreadOver(ledGeometry.points[i].y, minY, maxY, span);  // Top row first
+                }
+                break;
+            case TRANSITION_WIPE:
+                threshold[i] = spreadOver(ledGeometry.points[i].x, minX, maxX, span);
+                break;
+            case TRANSITION_DISSOLVE:
+                threshold[i] = scale8(random8(), span);
+                break;
+            default:
+                threshold[i] = 0;
+                break;
+        }
+    }
+}
+
+void TransitionEngine::renderOutgoingBody() {
+    uint8_t incomingPattern = currentPattern;
+    uint8_t outgoingPattern = channels[CHANNEL_BODY].outgoingPattern;
+
+    setRenderTarget(frames[1]);
+    bodyArena.swapSlots();
+    currentPattern = outgoingPattern;
+
+    bodyArena.render(outgoingPattern);
+
+    // Eyes and mouth run once per frame: in the incoming frame unless the
+    // incoming pattern is Off
+    if (incomingPattern == 0 && outgoingPattern != 0) {
+        updateEyes();
+        if (mouthEnabled) {
+            updateMouth();
+        }
+    }
+
+    // A one-shot pattern switching itself off only matters while it is incoming
+    currentPattern = incomingPattern;
+    bodyArena.swapSlots();
+    setRenderTarget(frames[0]);
+}
+
+void TransitionEngine::renderOutgoingMouth() {
+    setRenderTarget(frames[1]);
+    mouthArena.swapSlots();
+    mouthArena.render(channels[CHANNEL_MOUTH].outgoingPattern);
+    mouthArena.swapSlots();
+    setRenderTarget(frames[0]);
+}
+
+void TransitionEngine::composite(const Channel& channel, uint8_t progress) {
+    const CRGB* from = frames[1];
+    const CRGB* to = frames[0];
+    uint8_t end = channel.first + channel.count;
+
+    if (channel.mode == TRANSITION_BLACK) {
+        // First half fades the outgoing frame out, second half the incoming one in
+        const CRGB* source = (progress < 128) ? from : to;
+        uint8_t level = (progress < 128) ? 255 - channel.ramp[progress * 2] : channel.ramp[(progress - 128) * 2 + 1];
+        for (uint8_t i = channel.first; i < end; i++) {
+            allLEDs[i] = source[i];
+            allLEDs[i].nscale8(level);
+        }
+    } else {
+        for (uint8_t i = channel.first; i < end; i++) {
+            int16_t d = progress - threshold[i];
+            allLEDs[i] = from[i];
+            nblend(allLEDs[i], to[i], d > 0 ? channel.ramp[d] : 0);
+        }
+    }
+}
+
+void TransitionEngine::resetStats() {
+    lastCostUs = 0;
+    maxCostUs = 0;
+    sumCostUs = 0;
+    costFrames = 0;
+    transitionCount = 0;
+    frozenCount = 0;
+}
+
+void TransitionEngine::printStatus() {
+    Serial.println(F("=== Transitions ==="));
+    for (uint8_t id = 0; id < NUM_TRANSITION_CHANNELS; id++) {
+        const Channel& channel = channels[id];
+        Serial.print(channelNames[id]);
+        if (!channel.active) {
+            Serial.println(F("Idle"));
+            continue;
+        }
+        if (id == CHANNEL_BODY) {
+            Serial.print(bodyPatterns[channel.outgoingPattern].name);
+            Serial.print(F(" -> "));
+            Serial.print(bodyPatterns[currentPattern].name);
+            if (bodyCoversFace()) Serial.print(F(" with face"));
+        } else if (id == CHANNEL_MOUTH) {
+            Serial.print(mouthPatterns[channel.outgoingPattern].name);
+            Serial.print(F(" -> "));
+            Serial.print(mouthPatterns[mouthPattern].name);
+        } else {
+            Serial.print(F("Fading to "));
+            Serial.print(EyeModeNames[eyeMode]);
+        }
+        Serial.print(F(" ("));
+        Serial.print(modeNames[channel.mode]);
+        Serial.print(F(", "));
+        Serial.print(renderMillis() - channel.startTime);
+        Serial.print(F(" / "));
+        Serial.print(channel.duration);
+        Serial.print(F(" ms"));
+        Serial.println((channel.outgoingFrozen && id != CHANNEL_EYES) ? F(", outgoing frozen)") : F(")"));
+    }
+
+    Serial.print(F("Default: "));
+    Serial.print(modeNames[transitionMode]);
+    Serial.print(F(", "));
+    Serial.print(transitionDuration);
+    Serial.println(transitionDuration == 0 ? F(" ms (cut)") : F(" ms"));
+
+    Serial.print(F("Transitions: "));
+    Serial.print(transitionCount);
+    Serial.print(F(" ("));
+    Serial.print(frozenCount);
+    Serial.println(F(" over budget, finished with a frozen frame)"));
+
+    Serial.print(F("Extra cost per frame: last "));
+    Serial.print(lastCostUs);
+    Serial.print(F(" / avg "));
+    Serial.print(costFrames > 0 ? (uint32_t)(sumCostUs / costFrames) : 0);
+    Serial.print(F(" / max "));
+    Serial.print(maxCostUs);
+    Serial.println(F(" us"));
+
+    Serial.print(F("Budget: "));
+    Serial.print(TRANSITION_BUDGET_US);
+    Serial.print(F(" us of a "));
+    Serial.print(1000000UL / targetFPS);
+    Serial.println(F(" us frame"));
+    Serial.println(F("==================="));
+}
+
+int TransitionEngine::findMode(const char* name) {
+    if (name[0] >= '0' && name[0] <= '9') {
+        int mode = atoi(name);
+        return mode < NUM_TRANSITION_MODES ? mode : -1;
+    }
+    for (uint8_t mode = 0; mode < NUM_TRANSITION_MODES; mode++) {
+        if (strcmp(name, modeNames[mode]) == 0) return mode;
+    }
+    return -1;
+}
+
+const char* TransitionEngine::getModeName(uint8_t mode) {
+    return mode < NUM_TRANSITION_MODES ? modeNames[mode] : "default";
+}
@@ -0,0 +1,109 @@
+// transition.h - v5.2 Live Dual-Render Transitions
+#ifndef TRANSITION_H
+#define TRANSITION_H
+
+#include "config.h"
+#include "globals.h"
+
+// Independent transition channels, one per zone of the frame
+enum TransitionChannelId {
+    CHANNEL_BODY = 0,
+    CHANNEL_EYES = 1,
+    CHANNEL_MOUTH = 2
+};
+#define NUM_TRANSITION_CHANNELS 3
+
+// Crossfade between two patterns that both keep animating. While a
+// transition runs, each live pattern renders into its own scratch frame
+// (the outgoing one keeps its state in the idle slot of its pattern arena),
+// and the two frames are blended into allLEDs in one pass. Outside a
+// transition patterns render straight into allLEDs.
+//
+// Body, eyes and mouth each have their own channel: a zone is blended only
+// while its own channel runs, the other zones are copied from the incoming
+// frame. A body transition to or from Off takes the face with it, since
+// the face appears or disappears with the body.
+//
+// Every mode is a per-LED start threshold plus one ramp: starting a channel
+// fills both tables for its LED range, so a frame costs one lookup and one
+// nblend per LED whatever the mode.
+class TransitionEngine {
+public:
+    // Switch currentPattern to newPattern with a transition. Called between
+    // frames or before the body pattern of a frame renders. Duration 0 cuts.
+    void start(uint8_t newPattern, uint8_t mode, uint16_t durationMs);
+    void start(uint8_t newPattern) { start(newPattern, transitionMode, transitionDuration); }
+
+    // Switch mouthPattern with a transition. Both mouth patterns keep
+    // animating, like the body.
+    void startMouth(uint8_t newPattern);
+
+    // Fade the eyes from what they show now to the current eye settings.
+    // Call after changing eyeMode or the eye colors. The outgoing eyes are
+    // the last frame shown: the flicker state can only advance once per frame.
+    void startEyes();
+
+    // Call once per frame after the incoming patterns (and eyes/mouth)
+    // rendered: renders the outgoing patterns and composites the output.
+    void update();
+
+    // Jump to the end of all channels - the incoming frame becomes the output
+    void finish();
+
+    bool isActive() const;
+    bool isActive(uint8_t channel) const { return channels[channel].active; }
+    uint8_t getOutgoingPattern() const { return channels[CHANNEL_BODY].outgoingPattern; }
+
+    void resetStats();
+    void printStatus();
+
+    // Mode by name ("wipe") or number, -1 if unknown
+    static int findMode(const char* name);
+    static const char* getModeName(uint8_t mode);
+
+private:
+    struct Channel {
+        bool active = false;
+        bool outgoingFrozen = false;    // Blend the last outgoing frame (eyes, or over budget)
+        uint8_t outgoingPattern = 0;    // Body or mouth pattern, unused for the eyes
+        uint8_t mode = TRANSITION_FADE;
+        uint8_t first = 0;              // LED range of this channel in the frame
+        uint8_t count = 0;
+        uint16_t duration = TRANSITION_DURATION_MS;
+        uint32_t startTime = 0;
+        uint8_t ramp[256];
+    };
+
+    // frames[0] is the incoming frame (the render target while any channel
+    // runs), frames[1] holds the outgoing content of the running channels
+    CRGB frames[2][NUM_TOTAL_LEDS];
+
+    Channel channels[NUM_TRANSITION_CHANNELS];
+
+    // Precomputed per transition: LED i starts fading when the progress of
+    // its channel passes threshold[i], and reaches the new frame along the
+    // channel's ramp. The channel ranges never overlap.
+    uint8_t threshold[NUM_TOTAL_LEDS];
+
+    uint8_t overBudgetFrames = 0;
+
+    // Extra cost per transition frame: outgoing renders + composite
+    uint32_t lastCostUs = 0;
+    uint32_t maxCostUs = 0;
+    uint64_t sumCostUs = 0;
+    uint32_t costFrames = 0;
+    uint16_t transitionCount = 0;
+    uint16_t frozenCount = 0;
+
+    bool bodyCoversFace() const;
+    void beginChannel(uint8_t id, uint8_t first, uint8_t count, uint8_t mode, uint16_t durationMs, bool live);
+    void endChannel(uint8_t id);
+    void buildTables(Channel& channel);
+    void renderOutgoingBody();
+    void renderOutgoingMouth();
+    void composite(const Channel& channel, uint8_t progress);
+};
+
+extern TransitionEngine transitionEngine;
+
+#endif
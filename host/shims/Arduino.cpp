@@ -0,0 +1,132 @@
+// Arduino.cpp - Host shim of the Arduino-ESP32 core (host build only)
+#include "Arduino.h"
+#include <chrono>
+#include <thread>
+
+HostSerial Serial;
+HostEsp ESP;
+
+static const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+static uint64_t elapsedNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+// 32-bit like the device, so wrap-around arithmetic behaves the same
+unsigned long millis() {
+    return (uint32_t)(elapsedNs() / 1000000);
+}
+
+unsigned long micros() {
+    return (uint32_t)(elapsedNs() / 1000);
+}
+
+void delay(uint32_t ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void delayMicroseconds(uint32_t us) {
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+void yield() {
+}
+
+uint32_t HostEsp::getCycleCount() {
+    return (uint32_t)(elapsedNs() * 240 / 1000);
+}
+
+// Deterministic stand-in for the hardware RNG: host runs are reproducible
+static uint32_t hardwareRandomState = 0x9E3779B9;
+
+uint32_t esp_random() {
+    // xorshift32
+    hardwareRandomState ^= hardwareRandomState << 13;
+    hardwareRandomState ^= hardwareRandomState >> 17;
+    hardwareRandomState ^= hardwareRandomState << 5;
+    return hardwareRandomState;
+}
+
+static uint32_t randomState = 1;
+
+static uint32_t nextRandom() {
+    // Numerical Recipes LCG, upper bits only
+    randomState = randomState * 1664525UL + 1013904223UL;
+    return randomState >> 1;
+}
+
+long random(long howBig) {
+    if (howBig <= 0) return 0;
+    return nextRandom() % howBig;
+}
+
+long random(long howSmall, long howBig) {
+    if (howSmall >= howBig) return howSmall;
+    return random(howBig - howSmall) + howSmall;
+}
+
+void randomSeed(unsigned long seed) {
+    if (seed != 0) {
+        randomState = seed;
+    }
+}
+
+long map(long x, long inMin, long inMax, long outMin, long outMax) {
+    if (inMax == inMin) return outMin;
+    return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+int analogRead(uint8_t /*pin*/) {
+    return 2048;
+}
+
+void analogReadResolution(uint8_t /*bits*/) {
+}
+
+void analogSetAttenuation(adc_attenuation_t /*attenuation*/) {
+}
+
+// =====================================================
+// Serial
+// =====================================================
+
+void HostSerial::flush() {
+    fflush(stdout);
+}
+
+size_t HostSerial::print(const char* text) {
+    if (muted) return 0;
+    return fputs(text, stdout) >= 0 ? strlen(text) : 0;
+}
+
+size_t HostSerial::print(char c) {
+    if (muted) return 0;
+    return fputc(c, stdout) != EOF ? 1 : 0;
+}
+
+size_t HostSerial::print(long long value, int base) {
+    if (value < 0 && base == DEC) {
+        size_t n = print('-');
+        return n + print((unsigned long long)(-value), base);
+    }
+    return print((unsigned long long)value, base);
+}
+
+size_t HostSerial::print(unsigned long long value, int base) {
+    char digits[65];
+    char* p = &digits[sizeof(digits) - 1];
+    *p = '\0';
+    if (base < 2) base = DEC;
+    do {
+        uint8_t digit = value % base;
+        *--p = digit < 10 ? '0' + digit : 'A' + digit - 10;
+        value /= base;
+    } while (value > 0);
+    return print(p);
+}
+
+size_t HostSerial::print(double value, int digits) {
+    char text[48];
+    snprintf(text, sizeof(text), "%.*f", digits, value);
+    return print(text);
+}
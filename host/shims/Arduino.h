@@ -0,0 +1,108 @@
+// Arduino.h - Host shim of the Arduino-ESP32 core (host build only)
+//
+// Just enough of the Arduino API for the render, pattern and audio modules
+// to compile and run on a PC. Time is the host's monotonic clock; the
+// firmware's own seams (render_clock.h) make it reproducible.
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#include "esp_system.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+using std::abs;
+using std::max;
+using std::min;
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define IRAM_ATTR
+
+#define HIGH 1
+#define LOW 0
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+#ifndef PI
+#define PI 3.1415926535897932384626433832795
+#endif
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+// Time
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+
+// Random numbers (deterministic after randomSeed())
+long random(long howBig);
+long random(long howSmall, long howBig);
+void randomSeed(unsigned long seed);
+
+long map(long x, long inMin, long inMax, long outMin, long outMax);
+
+// Analog input - a fixed mid-scale reading; tests inject samples with setAdcSource()
+typedef enum { ADC_0db, ADC_2_5db, ADC_6db, ADC_11db } adc_attenuation_t;
+int analogRead(uint8_t pin);
+void analogReadResolution(uint8_t bits);
+void analogSetAttenuation(adc_attenuation_t attenuation);
+
+// Flash strings are plain strings on the host
+class __FlashStringHelper;
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper*>(string_literal))
+
+// Serial console on stdout/stdin
+class HostSerial {
+public:
+    void begin(unsigned long /*baud*/) {}
+    void flush();
+    operator bool() const { return true; }
+
+    // Host only: suppress console output (noisy benchmarks in tests)
+    void setMuted(bool muted) { this->muted = muted; }
+
+    int available() { return 0; }
+    int read() { return -1; }
+    size_t readBytes(uint8_t* /*buffer*/, size_t /*length*/) { return 0; }
+
+    size_t print(const char* text);
+    size_t print(const __FlashStringHelper* text) { return print(reinterpret_cast<const char*>(text)); }
+    size_t print(char c);
+    size_t print(unsigned char value, int base = DEC) { return print((unsigned long long)value, base); }
+    size_t print(int value, int base = DEC) { return print((long long)value, base); }
+    size_t print(unsigned int value, int base = DEC) { return print((unsigned long long)value, base); }
+    size_t print(long value, int base = DEC) { return print((long long)value, base); }
+    size_t print(unsigned long value, int base = DEC) { return print((unsigned long long)value, base); }
+    size_t print(long long value, int base = DEC);
+    size_t print(unsigned long long value, int base = DEC);
+    size_t print(double value, int digits = 2);
+
+    template <typename T>
+    size_t println(T value) { size_t n = print(value); return n + println(); }
+    template <typename T>
+    size_t println(T value, int format) { size_t n = print(value, format); return n + println(); }
+    size_t println() { return print("\n"); }
+
+private:
+    bool muted = false;
+};
+
+extern HostSerial Serial;
+
+#endif
@@ -0,0 +1,255 @@
+// FastLED.cpp - Host shim of the FastLED 3.x API (host build only)
+#include "FastLED.h"
+#include <stdlib.h>
+
+CFastLED FastLED;
+
+uint16_t rand16seed = 1337;
+
+// =====================================================
+// Colours
+// =====================================================
+
+void hsv2rgb_rainbow(const CHSV& hsv, CRGB& rgb) {
+    uint8_t hue = hsv.hue;
+    uint8_t sat = hsv.sat;
+    uint8_t val = hsv.val;
+
+    uint8_t offset8 = (hue & 0x1F) << 3;
+    uint8_t third = scale8(offset8, (256 / 3));
+    uint8_t r, g, b;
+
+    if (!(hue & 0x80)) {
+        if (!(hue & 0x40)) {
+            if (!(hue & 0x20)) {
+                // Red -> Orange
+                r = 255 - third;
+                g = third;
+                b = 0;
+            } else {
+                // Orange -> Yellow
+                r = 171;
+                g = 85 + third;
+                b = 0;
+            }
+        } else {
+            if (!(hue & 0x20)) {
+                // Yellow -> Green
+                uint8_t twothirds = scale8(offset8, ((256 * 2) / 3));
+                r = 171 - twothirds;
+                g = 170 + third;
+                b = 0;
+            } else {
+                // Green -> Aqua
+                r = 0;
+                g = 255 - third;
+                b = third;
+            }
+        }
+    } else {
+        if (!(hue & 0x40)) {
+            if (!(hue & 0x20)) {
+                // Aqua -> Blue
+                uint8_t twothirds = scale8(offset8, ((256 * 2) / 3));
+                r = 0;
+                g = 171 - twothirds;
+                b = 85 + twothirds;
+            } else {
+                // Blue -> Purple
+                r = third;
+                g = 0;
+                b = 255 - third;
+            }
+        } else {
+            if (!(hue & 0x20)) {
+                // Purple -> Pink
+                r = 85 + third;
+                g = 0;
+                b = 171 - third;
+            } else {
+                // Pink -> Red
+                r = 170 + third;
+                g = 0;
+                b = 85 - third;
+            }
+        }
+    }
+
+    if (sat != 255) {
+        if (sat == 0) {
+            r = 255;
+            g = 255;
+            b = 255;
+        } else {
+            uint8_t desat = 255 - sat;
+            desat = scale8_video(desat, desat);
+            uint8_t satscale = 255 - desat;
+            r = scale8(r, satscale) + desat;
+            g = scale8(g, satscale) + desat;
+            b = scale8(b, satscale) + desat;
+        }
+    }
+
+    if (val != 255) {
+        val = scale8_video(val, val);
+        if (val == 0) {
+            r = 0;
+            g = 0;
+            b = 0;
+        } else {
+            r = scale8(r, val);
+            g = scale8(g, val);
+            b = scale8(b, val);
+        }
+    }
+
+    rgb.r = r;
+    rgb.g = g;
+    rgb.b = b;
+}
+
+CRGB HeatColor(uint8_t temperature) {
+    CRGB heatcolor;
+    uint8_t t192 = scale8_video(temperature, 191);
+    uint8_t heatramp = (t192 & 0x3F) << 2;
+
+    if (t192 & 0x80) {
+        heatcolor.r = 255;
+        heatcolor.g = 255;
+        heatcolor.b = heatramp;
+    } else if (t192 & 0x40) {
+        heatcolor.r = 255;
+        heatcolor.g = heatramp;
+        heatcolor.b = 0;
+    } else {
+        heatcolor.r = heatramp;
+        heatcolor.g = 0;
+        heatcolor.b = 0;
+    }
+    return heatcolor;
+}
+
+void fill_solid(CRGB* leds, int numToFill, const CRGB& color) {
+    for (int i = 0; i < numToFill; i++) {
+        leds[i] = color;
+    }
+}
+
+void fill_rainbow(CRGB* leds, int numToFill, uint8_t initialhue, uint8_t deltahue) {
+    CHSV hsv(initialhue, 240, 255);
+    for (int i = 0; i < numToFill; i++) {
+        leds[i] = hsv;
+        hsv.hue += deltahue;
+    }
+}
+
+void nscale8(CRGB* leds, uint16_t numLeds, uint8_t scale) {
+    for (uint16_t i = 0; i < numLeds; i++) {
+        leds[i].nscale8(scale);
+    }
+}
+
+void fadeToBlackBy(CRGB* leds, uint16_t numLeds, uint8_t fadeBy) {
+    nscale8(leds, numLeds, 255 - fadeBy);
+}
+
+CRGB& nblend(CRGB& existing, const CRGB& overlay, fract8 amountOfOverlay) {
+    if (amountOfOverlay == 0) {
+        return existing;
+    }
+    if (amountOfOverlay == 255) {
+        existing = overlay;
+        return existing;
+    }
+    existing.r = blend8(existing.r, overlay.r, amountOfOverlay);
+    existing.g = blend8(existing.g, overlay.g, amountOfOverlay);
+    existing.b = blend8(existing.b, overlay.b, amountOfOverlay);
+    return existing;
+}
+
+CRGB blend(const CRGB& p1, const CRGB& p2, fract8 amountOfP2) {
+    CRGB nu(p1);
+    nblend(nu, p2, amountOfP2);
+    return nu;
+}
+
+CRGB* blend(const CRGB* src1, const CRGB* src2, CRGB* dest, uint16_t count, fract8 amountOfsrc2) {
+    for (uint16_t i = 0; i < count; i++) {
+        dest[i] = blend(src1[i], src2[i], amountOfsrc2);
+    }
+    return dest;
+}
+
+// =====================================================
+// Controllers
+// =====================================================
+
+CRGB CLEDController::computeAdjustment(uint8_t scale, const CRGB& colorCorrection, const CRGB& colorTemperature) {
+    CRGB adj(0, 0, 0);
+    if (scale > 0) {
+        for (uint8_t i = 0; i < 3; i++) {
+            uint8_t cc = colorCorrection.raw[i];
+            uint8_t ct = colorTemperature.raw[i];
+            if (cc > 0 && ct > 0) {
+                uint32_t work = (((uint32_t)cc) + 1) * (((uint32_t)ct) + 1) * scale;
+                work /= 0x10000L;
+                adj.raw[i] = work & 0xFF;
+            }
+        }
+    }
+    return adj;
+}
+
+void CLEDController::showLeds(uint8_t brightness) {
+    if (wireCapacity < count) {
+        free(wireData);
+        wireData = (uint8_t*)malloc(count * 3);
+        wireCapacity = count;
+    }
+
+    const CRGB scale = computeAdjustment(brightness, colorCorrection, colorTemperature);
+    const EOrder order = getOrder();
+    const uint8_t channels[3] = {(uint8_t)RGB_BYTE0(order), (uint8_t)RGB_BYTE1(order), (uint8_t)RGB_BYTE2(order)};
+    uint8_t* data = wireData;
+    for (int i = 0; i < count; i++) {
+        for (uint8_t slot = 0; slot < 3; slot++) {
+            uint8_t channel = channels[slot];
+            *data++ = scale8(leds[i].raw[channel], scale.raw[channel]);
+        }
+    }
+    showCount++;
+}
+
+CLEDController& CFastLED::addLeds(CLEDController* controller, CRGB* data, int nLeds) {
+    controller->setLeds(data, nLeds);
+
+    // Registering the same controller again only updates its LEDs
+    CLEDController** tail = &first;
+    for (; *tail != nullptr; tail = &(*tail)->next) {
+        if (*tail == controller) return *controller;
+    }
+    *tail = controller;
+    return *controller;
+}
+
+CLEDController& CFastLED::operator[](int index) {
+    CLEDController* c = first;
+    while (index-- > 0 && c->next != nullptr) {
+        c = c->next;
+    }
+    return *c;
+}
+
+int CFastLED::count() {
+    int n = 0;
+    for (CLEDController* c = first; c != nullptr; c = c->next) {
+        n++;
+    }
+    return n;
+}
+
+void CFastLED::show() {
+    for (CLEDController* c = first; c != nullptr; c = c->next) {
+        c->showLeds(brightness);
+    }
+}
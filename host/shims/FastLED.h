@@ -0,0 +1,450 @@
+// FastLED.h - Host shim of the FastLED 3.x API (host build only)
+//
+// The colour math (lib8tion, hsv2rgb_rainbow, beat generators, random8/16)
+// follows FastLED's portable C implementations so patterns render the same
+// pixels on the host as on the device. Controllers keep the LED data but
+// drive no hardware.
+#ifndef HOST_FASTLED_H
+#define HOST_FASTLED_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef uint8_t fract8;
+typedef uint16_t fract16;
+typedef uint16_t accum88;
+
+// =====================================================
+// lib8tion
+// =====================================================
+
+inline uint8_t scale8(uint8_t i, fract8 scale) {
+    return (((uint16_t)i) * (1 + (uint16_t)scale)) >> 8;
+}
+
+inline uint8_t scale8_video(uint8_t i, fract8 scale) {
+    return (((int)i * (int)scale) >> 8) + ((i && scale) ? 1 : 0);
+}
+
+inline uint16_t scale16(uint16_t i, fract16 scale) {
+    return ((uint32_t)i * (1 + (uint32_t)scale)) / 65536;
+}
+
+inline uint8_t qadd8(uint8_t i, uint8_t j) {
+    unsigned int t = i + j;
+    return t > 255 ? 255 : t;
+}
+
+inline uint8_t qsub8(uint8_t i, uint8_t j) {
+    int t = i - j;
+    return t < 0 ? 0 : t;
+}
+
+inline uint8_t blend8(uint8_t a, uint8_t b, uint8_t amountOfB) {
+    uint16_t partial = (a << 8) | b;
+    partial += (b * amountOfB);
+    partial -= (a * amountOfB);
+    return partial >> 8;
+}
+
+inline uint8_t sin8(uint8_t theta) {
+    static const uint8_t b_m16_interleave[] = {0, 49, 49, 41, 90, 27, 117, 10};
+    uint8_t offset = theta;
+    if (theta & 0x40) offset = (uint8_t)255 - offset;
+    offset &= 0x3F;
+    uint8_t secoffset = offset & 0x0F;
+    if (theta & 0x40) secoffset++;
+    uint8_t section = offset >> 4;
+    uint8_t b = b_m16_interleave[section * 2];
+    uint8_t m16 = b_m16_interleave[section * 2 + 1];
+    uint8_t mx = (m16 * secoffset) >> 4;
+    int8_t y = mx + b;
+    if (theta & 0x80) y = -y;
+    y += 128;
+    return y;
+}
+
+inline uint8_t cos8(uint8_t theta) {
+    return sin8(theta + 64);
+}
+
+inline int16_t sin16(uint16_t theta) {
+    static const uint16_t base[] = {0, 6393, 12539, 18204, 23170, 27245, 30273, 32137};
+    static const uint8_t slope[] = {49, 48, 44, 38, 31, 23, 14, 4};
+    uint16_t offset = (theta & 0x3FFF) >> 3;
+    if (theta & 0x4000) offset = 2047 - offset;
+    uint8_t section = offset / 256;
+    uint16_t b = base[section];
+    uint8_t m = slope[section];
+    uint8_t secoffset8 = (uint8_t)(offset) / 2;
+    uint16_t mx = m * secoffset8;
+    int16_t y = mx + b;
+    if (theta & 0x8000) y = -y;
+    return y;
+}
+
+inline int16_t cos16(uint16_t theta) {
+    return sin16(theta + 16384);
+}
+
+inline uint8_t sqrt16(uint16_t x) {
+    if (x <= 1) return x;
+    uint8_t low = 1;
+    uint8_t hi = x > 7904 ? 255 : (x >> 5) + 8;
+    uint8_t mid;
+    do {
+        mid = (low + hi) >> 1;
+        if ((uint16_t)(mid * mid) > x) {
+            hi = mid - 1;
+        } else {
+            if (mid == 255) return 255;
+            low = mid + 1;
+        }
+    } while (hi >= low);
+    return low - 1;
+}
+
+// =====================================================
+// Random numbers
+// =====================================================
+
+extern uint16_t rand16seed;
+
+inline uint16_t random16() {
+    rand16seed = (rand16seed * 2053) + 13849;
+    return rand16seed;
+}
+
+inline uint16_t random16(uint16_t lim) {
+    return ((uint32_t)lim * random16()) >> 16;
+}
+
+inline uint16_t random16(uint16_t min, uint16_t lim) {
+    return random16(lim - min) + min;
+}
+
+inline void random16_set_seed(uint16_t seed) {
+    rand16seed = seed;
+}
+
+inline uint16_t random16_get_seed() {
+    return rand16seed;
+}
+
+inline uint8_t random8() {
+    random16();
+    return (uint8_t)((uint8_t)(rand16seed & 0xFF) + (uint8_t)(rand16seed >> 8));
+}
+
+inline uint8_t random8(uint8_t lim) {
+    return (random8() * lim) >> 8;
+}
+
+inline uint8_t random8(uint8_t min, uint8_t lim) {
+    return random8(lim - min) + min;
+}
+
+// =====================================================
+// Timing - the sketch supplies the clock (USE_GET_MILLISECOND_TIMER)
+// =====================================================
+
+#ifdef USE_GET_MILLISECOND_TIMER
+uint32_t get_millisecond_timer();
+#define GET_MILLIS get_millisecond_timer
+#else
+unsigned long millis();
+#define GET_MILLIS millis
+#endif
+
+inline uint16_t beat88(accum88 beatsPerMinute88, uint32_t timebase = 0) {
+    return (((uint32_t)GET_MILLIS() - timebase) * beatsPerMinute88 * 280) >> 16;
+}
+
+inline uint16_t beat16(accum88 beatsPerMinute, uint32_t timebase = 0) {
+    if (beatsPerMinute < 256) beatsPerMinute <<= 8;
+    return beat88(beatsPerMinute, timebase);
+}
+
+inline uint8_t beat8(accum88 beatsPerMinute, uint32_t timebase = 0) {
+    return beat16(beatsPerMinute, timebase) >> 8;
+}
+
+inline uint16_t beatsin16(accum88 beatsPerMinute, uint16_t lowest = 0, uint16_t highest = 65535,
+                          uint32_t timebase = 0, uint16_t phaseOffset = 0) {
+    uint16_t beat = beat16(beatsPerMinute, timebase);
+    uint16_t beatsin = sin16(beat + phaseOffset) + 32768;
+    return lowest + scale16(beatsin, highest - lowest);
+}
+
+inline uint8_t beatsin8(accum88 beatsPerMinute, uint8_t lowest = 0, uint8_t highest = 255,
+                        uint32_t timebase = 0, uint8_t phaseOffset = 0) {
+    uint8_t beat = beat8(beatsPerMinute, timebase);
+    uint8_t beatsin = sin8(beat + phaseOffset);
+    return lowest + scale8(beatsin, highest - lowest);
+}
+
+class CEveryNMillis {
+public:
+    explicit CEveryNMillis(uint32_t period) : prevTrigger(GET_MILLIS()), period(period) {}
+
+    bool ready() {
+        bool isReady = (uint32_t)(GET_MILLIS() - prevTrigger) >= period;
+        if (isReady) prevTrigger = GET_MILLIS();
+        return isReady;
+    }
+
+    operator bool() { return ready(); }
+
+private:
+    uint32_t prevTrigger;
+    uint32_t period;
+};
+
+#define FASTLED_CONCAT_(a, b) a##b
+#define FASTLED_CONCAT(a, b) FASTLED_CONCAT_(a, b)
+#define EVERY_N_MILLIS_I(NAME, N) static CEveryNMillis NAME(N); if (NAME)
+#define EVERY_N_MILLIS(N) EVERY_N_MILLIS_I(FASTLED_CONCAT(PER, __COUNTER__), N)
+#define EVERY_N_MILLISECONDS(N) EVERY_N_MILLIS(N)
+
+// =====================================================
+// Colours
+// =====================================================
+
+struct CRGB;
+
+struct CHSV {
+    union {
+        struct {
+            uint8_t hue;
+            uint8_t sat;
+            uint8_t val;
+        };
+        uint8_t raw[3];
+    };
+
+    CHSV() : hue(0), sat(0), val(0) {}
+    CHSV(uint8_t h, uint8_t s, uint8_t v) : hue(h), sat(s), val(v) {}
+};
+
+void hsv2rgb_rainbow(const CHSV& hsv, CRGB& rgb);
+
+struct CRGB {
+    union {
+        struct {
+            union { uint8_t r; uint8_t red; };
+            union { uint8_t g; uint8_t green; };
+            union { uint8_t b; uint8_t blue; };
+        };
+        uint8_t raw[3];
+    };
+
+    typedef enum {
+        Black = 0x000000,
+        Blue = 0x0000FF,
+        Cyan = 0x00FFFF,
+        Green = 0x008000,
+        Magenta = 0xFF00FF,
+        OrangeRed = 0xFF4500,
+        Purple = 0x800080,
+        Red = 0xFF0000,
+        White = 0xFFFFFF,
+        Yellow = 0xFFFF00,
+    } HTMLColorCode;
+
+    CRGB() : r(0), g(0), b(0) {}
+    CRGB(uint8_t ir, uint8_t ig, uint8_t ib) : r(ir), g(ig), b(ib) {}
+    CRGB(uint32_t colorcode) : r((colorcode >> 16) & 0xFF), g((colorcode >> 8) & 0xFF), b(colorcode & 0xFF) {}
+    CRGB(HTMLColorCode colorcode) : CRGB((uint32_t)colorcode) {}
+    CRGB(const CHSV& hsv) { hsv2rgb_rainbow(hsv, *this); }
+
+    uint8_t& operator[](uint8_t x) { return raw[x]; }
+    const uint8_t& operator[](uint8_t x) const { return raw[x]; }
+
+    CRGB& operator=(const CHSV& hsv) {
+        hsv2rgb_rainbow(hsv, *this);
+        return *this;
+    }
+
+    CRGB& setRGB(uint8_t nr, uint8_t ng, uint8_t nb) {
+        r = nr;
+        g = ng;
+        b = nb;
+        return *this;
+    }
+
+    CRGB& setHSV(uint8_t hue, uint8_t sat, uint8_t val) {
+        hsv2rgb_rainbow(CHSV(hue, sat, val), *this);
+        return *this;
+    }
+
+    CRGB& operator+=(const CRGB& rhs) {
+        r = qadd8(r, rhs.r);
+        g = qadd8(g, rhs.g);
+        b = qadd8(b, rhs.b);
+        return *this;
+    }
+
+    CRGB& operator-=(const CRGB& rhs) {
+        r = qsub8(r, rhs.r);
+        g = qsub8(g, rhs.g);
+        b = qsub8(b, rhs.b);
+        return *this;
+    }
+
+    CRGB& operator|=(const CRGB& rhs) {
+        if (rhs.r > r) r = rhs.r;
+        if (rhs.g > g) g = rhs.g;
+        if (rhs.b > b) b = rhs.b;
+        return *this;
+    }
+
+    CRGB& nscale8(uint8_t scaledown) {
+        r = scale8(r, scaledown);
+        g = scale8(g, scaledown);
+        b = scale8(b, scaledown);
+        return *this;
+    }
+
+    CRGB& fadeToBlackBy(uint8_t fadefactor) {
+        return nscale8(255 - fadefactor);
+    }
+
+    void maximizeBrightness(uint8_t limit = 255) {
+        uint8_t max = r;
+        if (g > max) max = g;
+        if (b > max) max = b;
+        if (max == 0) return;
+        uint16_t factor = ((uint16_t)(limit) * 256) / max;
+        r = (r * factor) / 256;
+        g = (g * factor) / 256;
+        b = (b * factor) / 256;
+    }
+
+    explicit operator bool() const { return r || g || b; }
+};
+
+inline bool operator==(const CRGB& lhs, const CRGB& rhs) {
+    return lhs.r == rhs.r && lhs.g == rhs.g && lhs.b == rhs.b;
+}
+
+inline bool operator!=(const CRGB& lhs, const CRGB& rhs) {
+    return !(lhs == rhs);
+}
+
+inline CRGB operator+(const CRGB& p1, const CRGB& p2) {
+    return CRGB(qadd8(p1.r, p2.r), qadd8(p1.g, p2.g), qadd8(p1.b, p2.b));
+}
+
+CRGB HeatColor(uint8_t temperature);
+
+void fill_solid(CRGB* leds, int numToFill, const CRGB& color);
+void fill_rainbow(CRGB* leds, int numToFill, uint8_t initialhue, uint8_t deltahue = 5);
+void nscale8(CRGB* leds, uint16_t numLeds, uint8_t scale);
+void fadeToBlackBy(CRGB* leds, uint16_t numLeds, uint8_t fadeBy);
+CRGB& nblend(CRGB& existing, const CRGB& overlay, fract8 amountOfOverlay);
+CRGB blend(const CRGB& p1, const CRGB& p2, fract8 amountOfP2);
+CRGB* blend(const CRGB* src1, const CRGB* src2, CRGB* dest, uint16_t count, fract8 amountOfsrc2);
+
+// =====================================================
+// Controllers
+// =====================================================
+
+enum LEDColorCorrection {
+    UncorrectedColor = 0xFFFFFF,
+    TypicalLEDStrip = 0xFFB0F0,
+};
+
+enum ColorTemperature {
+    UncorrectedTemperature = 0xFFFFFF,
+};
+
+// Channel order, one octal digit per wire byte
+enum EOrder {
+    RGB = 0012,
+    RBG = 0021,
+    GRB = 0102,
+    GBR = 0120,
+    BRG = 0201,
+    BGR = 0210,
+};
+
+#define RGB_BYTE0(X) ((X >> 6) & 0x3)
+#define RGB_BYTE1(X) ((X >> 3) & 0x3)
+#define RGB_BYTE2(X) ((X) & 0x3)
+
+class CLEDController {
+public:
+    virtual ~CLEDController() {}
+
+    CLEDController& setLeds(CRGB* data, int nLeds) {
+        leds = data;
+        count = nLeds;
+        return *this;
+    }
+
+    CLEDController& setCorrection(CRGB correction) {
+        colorCorrection = correction;
+        return *this;
+    }
+
+    CLEDController& setTemperature(CRGB temperature) {
+        colorTemperature = temperature;
+        return *this;
+    }
+
+    // Host only: a wire frame of size() * 3 bytes - brightness, colour
+    // adjustment and channel order applied (no dithering)
+    void showLeds(uint8_t brightness);
+    const uint8_t* getWireData() const { return wireData; }
+    int size() const { return count; }
+    uint32_t getShowCount() const { return showCount; }
+
+    static CRGB computeAdjustment(uint8_t scale, const CRGB& colorCorrection, const CRGB& colorTemperature);
+
+    CLEDController* next = nullptr;
+
+protected:
+    virtual EOrder getOrder() const = 0;
+
+private:
+    CRGB* leds = nullptr;
+    int count = 0;
+    CRGB colorCorrection = CRGB(UncorrectedColor);
+    CRGB colorTemperature = CRGB(UncorrectedTemperature);
+    uint8_t* wireData = nullptr;
+    int wireCapacity = 0;
+    uint32_t showCount = 0;
+};
+
+template <uint8_t DATA_PIN, EOrder RGB_ORDER>
+class WS2812B : public CLEDController {
+protected:
+    EOrder getOrder() const override { return RGB_ORDER; }
+};
+
+class CFastLED {
+public:
+    template <template <uint8_t DATA_PIN, EOrder RGB_ORDER> class CHIPSET, uint8_t DATA_PIN, EOrder RGB_ORDER>
+    CLEDController& addLeds(CRGB* data, int nLeds) {
+        static CHIPSET<DATA_PIN, RGB_ORDER> controller;
+        return addLeds(&controller, data, nLeds);
+    }
+
+    CLEDController& addLeds(CLEDController* controller, CRGB* data, int nLeds);
+
+    // Controllers in the order they were added
+    CLEDController& operator[](int index);
+    int count();
+
+    void setBrightness(uint8_t scale) { brightness = scale; }
+    uint8_t getBrightness() const { return brightness; }
+    void show();
+
+private:
+    CLEDController* first = nullptr;
+    uint8_t brightness = 255;
+};
+
+extern CFastLED FastLED;
+
+#endif
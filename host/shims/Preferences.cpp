@@ -0,0 +1,51 @@
+// Preferences.cpp - Host shim of the Arduino-ESP32 NVS preferences (host build only)
+#include "Preferences.h"
+#include <string.h>
+
+static std::map<std::string, std::map<std::string, std::vector<uint8_t>>> storage;
+
+bool Preferences::begin(const char* name, bool readOnly) {
+    current = &storage[name];
+    this->readOnly = readOnly;
+    return true;
+}
+
+void Preferences::end() {
+    current = nullptr;
+}
+
+bool Preferences::clear() {
+    if (current == nullptr || readOnly) return false;
+    current->clear();
+    return true;
+}
+
+bool Preferences::remove(const char* key) {
+    if (current == nullptr || readOnly) return false;
+    return current->erase(key) > 0;
+}
+
+bool Preferences::isKey(const char* key) {
+    return current != nullptr && current->count(key) > 0;
+}
+
+size_t Preferences::putBytes(const char* key, const void* value, size_t length) {
+    if (current == nullptr || readOnly) return 0;
+    const uint8_t* bytes = (const uint8_t*)value;
+    (*current)[key].assign(bytes, bytes + length);
+    return length;
+}
+
+size_t Preferences::getBytes(const char* key, void* buffer, size_t maxLength) {
+    if (current == nullptr) return 0;
+    Namespace::const_iterator entry = current->find(key);
+    if (entry == current->end() || entry->second.size() > maxLength) return 0;
+    memcpy(buffer, entry->second.data(), entry->second.size());
+    return entry->second.size();
+}
+
+size_t Preferences::getBytesLength(const char* key) {
+    if (current == nullptr) return 0;
+    Namespace::const_iterator entry = current->find(key);
+    return entry != current->end() ? entry->second.size() : 0;
+}
@@ -0,0 +1,9 @@
+// esp_idf_version.h - Host shim of the ESP-IDF version macros (host build only)
+#ifndef HOST_ESP_IDF_VERSION_H
+#define HOST_ESP_IDF_VERSION_H
+
+// The host build follows the esp32 core 3.x (ESP-IDF 5.1) code paths
+#define ESP_IDF_VERSION_VAL(major, minor, patch) (((major) << 16) | ((minor) << 8) | (patch))
+#define ESP_IDF_VERSION ESP_IDF_VERSION_VAL(5, 1, 0)
+
+#endif
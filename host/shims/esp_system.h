@@ -0,0 +1,27 @@
+// esp_system.h - Host shim of the ESP-IDF system API (host build only)
+#ifndef HOST_ESP_SYSTEM_H
+#define HOST_ESP_SYSTEM_H
+
+#include <stdint.h>
+
+typedef int esp_err_t;
+#define ESP_OK 0
+#define ESP_FAIL -1
+#define ESP_ERR_TIMEOUT 0x107
+#define ESP_ERR_NOT_SUPPORTED 0x106
+
+uint32_t esp_random();
+
+// The ESP object of the Arduino core. Cycle counts are derived from the host
+// clock at the S3's 240 MHz, so benchmark output reads like the device's.
+class HostEsp {
+public:
+    uint32_t getCycleCount();
+    uint32_t getCpuFreqMHz() { return 240; }
+    uint32_t getFreeHeap() { return 256 * 1024; }
+    void restart() {}
+};
+
+extern HostEsp ESP;
+
+#endif
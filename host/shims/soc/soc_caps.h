@@ -0,0 +1,10 @@
+// soc_caps.h - Host shim of the ESP32-S3 SoC capabilities (host build only)
+#ifndef HOST_SOC_CAPS_H
+#define HOST_SOC_CAPS_H
+
+#define SOC_ADC_DIGI_RESULT_BYTES 4
+#define SOC_ADC_DIGI_MAX_BITWIDTH 12
+#define SOC_RMT_TX_CANDIDATES_PER_GROUP 4
+#define SOC_RMT_MEM_WORDS_PER_CHANNEL 48
+
+#endif
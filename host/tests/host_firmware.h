@@ -0,0 +1,28 @@
+// host_firmware.h - Firmware start-up for the host tests (host build only)
+#ifndef HOST_FIRMWARE_H
+#define HOST_FIRMWARE_H
+
+#include "globals.h"
+#include "settings.h"
+#include "led_output.h"
+#include "geometry.h"
+#include "render_clock.h"
+#include "helpers.h"
+#include "eyes.h"
+#include "audio.h"
+
+// The render and audio part of setup() in the sketch, without console output
+static inline void setupFirmware() {
+    Serial.setMuted(true);
+    initSettings();
+    ledOutput.begin();
+    initializeGeometry();
+    FastLED.setBrightness(ledBrightness);
+    resetFrameClock();
+    initializeHelpers();
+    initializeEyes();
+    initializeAudio();
+    Serial.setMuted(false);
+}
+
+#endif
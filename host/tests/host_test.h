@@ -0,0 +1,36 @@
+// host_test.h - Minimal checks for the host tests (host build only)
+//
+// CHECK records a failure and carries on; a test returns testResult() from
+// main() so ctest sees the outcome.
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+#include <stdio.h>
+
+static int testFailures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            printf("%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #condition); \
+            testFailures++; \
+        } \
+    } while (0)
+
+#define CHECK_EQ(expected, actual) \
+    do { \
+        long long expectedValue = (long long)(expected); \
+        long long actualValue = (long long)(actual); \
+        if (expectedValue != actualValue) { \
+            printf("%s:%d: CHECK_EQ failed: %s == %s (%lld != %lld)\n", \
+                   __FILE__, __LINE__, #expected, #actual, expectedValue, actualValue); \
+            testFailures++; \
+        } \
+    } while (0)
+
+static inline int testResult(const char* name) {
+    printf("%s: %s\n", name, testFailures == 0 ? "PASSED" : "FAILED");
+    return testFailures == 0 ? 0 : 1;
+}
+
+#endif
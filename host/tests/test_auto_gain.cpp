@@ -0,0 +1,105 @@
+// test_auto_gain.cpp - Convergence and stability of the automatic gain control
+//
+// Synthetic mic and line-in material (a level per 10 ms reading, spread
+// around a loudness) drives AutoGain on the virtual clock. The threshold has
+// to reach the material's AGC_PERCENTILE level within a bounded time after
+// a change in loudness, ignore short spikes, and keep one state per input.
+#include "host_firmware.h"
+#include "host_test.h"
+#include "auto_gain.h"
+#include <algorithm>
+#include <vector>
+
+#define READING_MS 10           // readAudioLevel() takes a new reading this often
+#define ATTACK_LIMIT_S 4        // Quiet -> loud settles within this time
+#define RELEASE_LIMIT_S 30      // Loud -> quiet settles within this time
+#define SETTLED_RATIO 1.25f     // Settled: within this factor of the target
+#define SPIKE_LIMIT_RATIO 1.2f  // A 200 ms spike may move the threshold this much
+
+static uint32_t materialState = 12345;
+
+// Level spread uniformly over +/-50% of the loudness
+static int materialLevel(int loudness) {
+    materialState = materialState * 1664525UL + 1013904223UL;
+    return loudness / 2 + (int)((materialState >> 16) % (uint32_t)(loudness + 1));
+}
+
+static float percentileLevel(int loudness) {
+    return loudness / 2.0f + loudness * AGC_PERCENTILE / 100.0f;
+}
+
+static bool isSettled(float target) {
+    return audioThreshold <= target * SETTLED_RATIO && audioThreshold * SETTLED_RATIO >= target;
+}
+
+// Feeds material until the threshold stays settled for a second; returns the
+// time to the start of that second, or -1 if it did not start within limitMs
+static int32_t settleTime(int loudness, uint32_t limitMs) {
+    float target = percentileLevel(loudness);
+    int32_t settledSince = -1;
+    for (uint32_t t = 0; t < limitMs + 1000; t += READING_MS) {
+        advanceRenderClock(READING_MS);
+        autoGain.update(materialLevel(loudness));
+        if (!isSettled(target)) {
+            settledSince = -1;
+        } else if (settledSince < 0) {
+            settledSince = t;
+        } else if (t - settledSince >= 1000) {
+            return settledSince;
+        }
+    }
+    return -1;
+}
+
+static void feed(int loudness, uint32_t ms) {
+    for (uint32_t t = 0; t < ms; t += READING_MS) {
+        advanceRenderClock(READING_MS);
+        autoGain.update(materialLevel(loudness));
+    }
+}
+
+static void checkSettles(const char* name, int loudness, uint32_t limitS) {
+    int32_t ms = settleTime(loudness, limitS * 1000UL);
+    printf("  %-24s target %4.0f: threshold %3d after %5.1f s (limit %u s)\n",
+           name, percentileLevel(loudness), audioThreshold, ms / 1000.0f, limitS);
+    CHECK(ms >= 0);
+}
+
+int main() {
+    setupFirmware();
+    setRenderClockVirtual(0);
+    audioAutoGain = true;
+    autoGain.reset();
+
+    // Microphone: quiet room, music, quiet again
+    audioInputMode = INPUT_MIC;
+    feed(60, 20000);
+    checkSettles("mic quiet", 60, ATTACK_LIMIT_S);
+    checkSettles("mic quiet -> loud", 280, ATTACK_LIMIT_S);
+    checkSettles("mic loud -> quiet", 60, RELEASE_LIMIT_S);
+
+    // A short spike (door slam) barely moves it
+    uint16_t before = audioThreshold;
+    feed(1000, 200);
+    uint16_t highest = audioThreshold;
+    feed(60, 5000);
+    printf("  200 ms spike: threshold %u -> %u -> %u\n", before, highest, audioThreshold);
+    CHECK(highest <= before * SPIKE_LIMIT_RATIO);
+    CHECK(isSettled(percentileLevel(60)));
+
+    // Line-in keeps its own state; switching back restores the mic threshold
+    uint16_t micThreshold = audioThreshold;
+    audioInputMode = INPUT_LINE_IN;
+    checkSettles("line-in", 200, ATTACK_LIMIT_S);
+    uint16_t lineInThreshold = audioThreshold;
+
+    audioInputMode = INPUT_MIC;
+    advanceRenderClock(READING_MS);
+    autoGain.update(materialLevel(60));
+    printf("  input switch: line-in %u -> mic %u (was %u)\n", lineInThreshold, audioThreshold, micThreshold);
+    CHECK(abs((int)audioThreshold - (int)micThreshold) <= micThreshold / 10);
+    CHECK_EQ(lineInThreshold, autoGain.getThreshold(INPUT_LINE_IN));
+
+    setRenderClockLive();
+    return testResult("test_auto_gain");
+}
@@ -0,0 +1,64 @@
+// test_beat_detector.cpp - Tempo lock on synthetic click tracks
+//
+// Click tracks at known tempos run through the whole ADC path (replay source,
+// DC removal, block RMS, onset detector) on the virtual clock. The detector
+// has to lock within the tolerance and then count one beat per click.
+//
+//   test_beat_detector [--tolerance BPM]
+#include "host_firmware.h"
+#include "host_test.h"
+#include "adc_stream.h"
+#include "audio_replay.h"
+#include "beat_detector.h"
+
+#define CLICK_TRACK_SECONDS 12
+#define BEAT_COUNT_SECONDS 4   // Beats are counted over the end of the track
+#define FRAME_MS 20
+
+static void runClickTrack(uint8_t bpm, int toleranceBpm) {
+    ClickTrackSource clicks;
+    clicks.setTempo(bpm);
+    clicks.rewind();
+
+    setRenderClockVirtual(0);
+    beatDetector.reset();
+    adcStream.setSource(&clicks);
+
+    const uint32_t countFromMs = (CLICK_TRACK_SECONDS - BEAT_COUNT_SECONDS) * 1000UL;
+    uint32_t beatsAtCountStart = 0;
+    for (uint32_t ms = 0; ms < CLICK_TRACK_SECONDS * 1000UL; ms += FRAME_MS) {
+        if (ms == countFromMs) beatsAtCountStart = beatDetector.getBeatCount();
+        advanceRenderClock(FRAME_MS);
+        adcStream.service();
+    }
+    adcStream.setSource(nullptr);
+
+    int error10 = (int)beatDetector.getBpm10() - bpm * 10;
+    uint32_t beats = beatDetector.getBeatCount() - beatsAtCountStart;
+    uint32_t expectedBeats = (uint32_t)bpm * BEAT_COUNT_SECONDS / 60;
+    printf("  %3u BPM -> %s %u.%u BPM (error %+.1f), %u beats in the last %u s (expected %u)\n",
+           bpm, beatDetector.isLocked() ? "locked at" : "NOT locked,", beatDetector.getBpm10() / 10,
+           beatDetector.getBpm10() % 10, error10 / 10.0, beats, BEAT_COUNT_SECONDS, expectedBeats);
+
+    CHECK(beatDetector.isLocked());
+    CHECK(abs(error10) <= toleranceBpm * 10);
+    CHECK(abs((int)beats - (int)expectedBeats) <= 1);
+}
+
+int main(int argc, char** argv) {
+    int toleranceBpm = 2;
+    for (int i = 1; i + 1 < argc; i++) {
+        if (strcmp(argv[i], "--tolerance") == 0) toleranceBpm = atoi(argv[i + 1]);
+    }
+
+    setupFirmware();
+
+    static const uint8_t tempos[] = {90, 120, 140};
+    for (uint8_t t = 0; t < ARRAY_SIZE(tempos); t++) {
+        runClickTrack(tempos[t], toleranceBpm);
+    }
+
+    setRenderClockLive();
+    printf("Tolerance: +/-%d BPM\n", toleranceBpm);
+    return testResult("test_beat_detector");
+}
@@ -0,0 +1,97 @@
+// test_filter_bank.cpp - Biquad filter bank: band separation, envelopes and timing
+//
+// A sine at the centre of each band has to give that band the largest
+// envelope, full-scale input must not overflow the Q14 filters, the envelopes
+// have to release after the tone stops, and the cost per sample is printed
+// next to the firmware's own benchmark.
+#include "host_firmware.h"
+#include "host_test.h"
+#include "filter_bank.h"
+#include <chrono>
+
+#define TONE_AMPLITUDE 1000       // ADC counts, as in runBenchmark()
+#define SEPARATION_RATIO 2        // Tone band envelope over every other band
+#define TIMING_SAMPLES 1000000UL
+
+static FilterBank bank;
+
+static void playTone(float hz, int amplitude, uint32_t samples) {
+    for (uint32_t i = 0; i < samples; i++) {
+        bank.processSample((int)(amplitude * sinf(2.0f * (float)M_PI * hz * i / ADC_DMA_SAMPLE_RATE)));
+    }
+}
+
+static float bandCentreHz(uint8_t band) {
+    float high = (band + 1 < FILTER_BANK_BANDS) ? bank.getBandLowHz(band + 1) : FILTER_BANK_MAX_HZ;
+    return sqrtf((float)bank.getBandLowHz(band) * high);
+}
+
+static void checkToneBands() {
+    for (uint8_t band = 0; band < FILTER_BANK_BANDS; band++) {
+        bank.reset();
+        float hz = bandCentreHz(band);
+        playTone(hz, TONE_AMPLITUDE, ADC_DMA_SAMPLE_RATE / 2);
+
+        printf("  %5.0f Hz:", hz);
+        for (uint8_t b = 0; b < FILTER_BANK_BANDS; b++) {
+            printf(" %4u", bank.getEnvelope(b));
+            if (b != band) CHECK(bank.getEnvelope(band) >= SEPARATION_RATIO * bank.getEnvelope(b));
+        }
+        printf("\n");
+        CHECK(bank.getEnvelope(band) > TONE_AMPLITUDE / 2);
+    }
+}
+
+static void checkFullScale() {
+    // Square wave beyond the 12-bit range at the bottom band: clamped, no wrap
+    bank.reset();
+    uint16_t period = ADC_DMA_SAMPLE_RATE / (uint16_t)bandCentreHz(0);
+    for (uint32_t i = 0; i < ADC_DMA_SAMPLE_RATE; i++) {
+        bank.processSample((i % period < period / 2) ? 4095 : -4095);
+        for (uint8_t b = 0; b < FILTER_BANK_BANDS; b++) {
+            CHECK(bank.getEnvelope(b) < 4 * 2048);
+        }
+    }
+    CHECK(bank.getEnvelope(0) > 2048 / 2);
+}
+
+static void checkRelease() {
+    bank.reset();
+    playTone(bandCentreHz(1), TONE_AMPLITUDE, ADC_DMA_SAMPLE_RATE / 2);
+    uint16_t settled = bank.getEnvelope(1);
+
+    // 2^FILTER_RELEASE_SHIFT samples per time constant: five of them in silence
+    for (uint32_t i = 0; i < 5UL << FILTER_RELEASE_SHIFT; i++) {
+        bank.processSample(0);
+    }
+    printf("  release: %u -> %u after %lu ms\n", settled, bank.getEnvelope(1),
+           (5UL << FILTER_RELEASE_SHIFT) * 1000 / ADC_DMA_SAMPLE_RATE);
+    CHECK(bank.getEnvelope(1) < settled / 50);
+}
+
+static void printTiming() {
+    bank.reset();
+    uint16_t noise = 1;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < TIMING_SAMPLES; i++) {
+        noise = noise * 2053 + 13849;
+        bank.processSample((int16_t)noise >> 4);
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    printf("Host: %.1f ns per sample (%u biquads + envelopes), budget %lu ns at %u Hz\n",
+           ns / TIMING_SAMPLES, (unsigned)FILTER_BANK_BANDS, 1000000000UL / ADC_DMA_SAMPLE_RATE, (unsigned)ADC_DMA_SAMPLE_RATE);
+
+    FilterBank::runBenchmark(TIMING_SAMPLES / 10);
+}
+
+int main() {
+    setupFirmware();
+    bank.begin();
+
+    checkToneBands();
+    checkFullScale();
+    checkRelease();
+    printTiming();
+
+    return testResult("test_filter_bank");
+}
@@ -0,0 +1,176 @@
+// test_golden_frames.cpp - Golden-frame images of every body and mouth pattern
+//
+// Renders each pattern like "golden check" on the device and compares the
+// frames with host/golden/<set>_<pattern>.ppm (binary PPM, one row per frame,
+// one pixel per LED). A frame fails if any channel differs by more than the
+// tolerance; its expected, actual and difference rows go to a PPM in the diff
+// directory. --update rewrites the golden images instead.
+//
+//   test_golden_frames <golden dir> <diff dir> [--tolerance N] [--update]
+#include "golden_frames.h"
+#include "host_firmware.h"
+#include "host_test.h"
+#include <string>
+#include <vector>
+
+#define DIFF_PIXEL_SCALE 8   // Diff images show each LED as an 8x8 block
+#define DIFF_AMPLIFY 8       // Small differences stay visible
+
+static std::string goldenPath(const std::string& dir, uint8_t set, uint8_t pattern, const char* suffix) {
+    char name[32];
+    snprintf(name, sizeof(name), "%s_%02u%s.ppm", set == GOLDEN_BODY ? "body" : "mouth", pattern, suffix);
+    return dir + "/" + name;
+}
+
+static bool writePpm(const std::string& path, const char* comment, uint16_t width, uint16_t height,
+                     const std::vector<uint8_t>& pixels) {
+    FILE* file = fopen(path.c_str(), "wb");
+    if (file == nullptr) return false;
+    fprintf(file, "P6\n# %s\n%u %u\n255\n", comment, width, height);
+    bool ok = fwrite(pixels.data(), 1, pixels.size(), file) == pixels.size();
+    return fclose(file) == 0 && ok;
+}
+
+// Skips whitespace and comment lines between header fields
+static bool readPpmNumber(FILE* file, unsigned* value) {
+    int c = fgetc(file);
+    while (c == '#' || isspace(c)) {
+        if (c == '#') {
+            while (c != '\n' && c != EOF) c = fgetc(file);
+        }
+        c = fgetc(file);
+    }
+    ungetc(c, file);
+    return fscanf(file, "%u", value) == 1;
+}
+
+static bool readPpm(const std::string& path, uint16_t width, uint16_t height, std::vector<uint8_t>& pixels) {
+    FILE* file = fopen(path.c_str(), "rb");
+    if (file == nullptr) return false;
+
+    char magic[3] = {0};
+    unsigned fileWidth, fileHeight, maxValue;
+    bool ok = fread(magic, 1, 2, file) == 2 && strcmp(magic, "P6") == 0 &&
+              readPpmNumber(file, &fileWidth) && readPpmNumber(file, &fileHeight) &&
+              readPpmNumber(file, &maxValue) && fgetc(file) != EOF &&
+              fileWidth == width && fileHeight == height && maxValue == 255;
+    if (ok) {
+        pixels.resize(width * height * 3);
+        ok = fread(pixels.data(), 1, pixels.size(), file) == pixels.size();
+    }
+    fclose(file);
+    return ok;
+}
+
+static void appendDiffRow(std::vector<uint8_t>& image, const uint8_t* row, uint16_t leds) {
+    for (uint8_t y = 0; y < DIFF_PIXEL_SCALE; y++) {
+        for (uint16_t i = 0; i < leds; i++) {
+            for (uint8_t x = 0; x < DIFF_PIXEL_SCALE; x++) {
+                image.insert(image.end(), &row[i * 3], &row[i * 3 + 3]);
+            }
+        }
+    }
+}
+
+// Returns the number of frames outside the tolerance
+static uint8_t compareFrames(const std::vector<uint8_t>& expected, const std::vector<uint8_t>& actual,
+                             uint16_t leds, int tolerance, std::vector<uint8_t>& diffImage,
+                             uint8_t* maxDifference, uint8_t* firstFailure) {
+    uint8_t failedFrames = 0;
+    std::vector<uint8_t> difference(leds * 3);
+
+    for (uint8_t f = 0; f < GOLDEN_FRAMES; f++) {
+        const uint8_t* want = &expected[f * leds * 3];
+        const uint8_t* got = &actual[f * leds * 3];
+        bool failed = false;
+
+        for (uint16_t i = 0; i < leds * 3; i++) {
+            int delta = abs(want[i] - got[i]);
+            if (delta > *maxDifference) *maxDifference = delta;
+            if (delta > tolerance) failed = true;
+            difference[i] = min(delta * DIFF_AMPLIFY, 255);
+        }
+        if (!failed) continue;
+
+        if (failedFrames == 0) *firstFailure = f;
+        failedFrames++;
+        appendDiffRow(diffImage, want, leds);
+        appendDiffRow(diffImage, got, leds);
+        appendDiffRow(diffImage, difference.data(), leds);
+    }
+    return failedFrames;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        printf("usage: %s <golden dir> <diff dir> [--tolerance N] [--update]\n", argv[0]);
+        return 2;
+    }
+    std::string goldenDir = argv[1];
+    std::string diffDir = argv[2];
+    int tolerance = 0;
+    bool update = false;
+    for (int i = 3; i < argc; i++) {
+        if (strcmp(argv[i], "--update") == 0) {
+            update = true;
+        } else if (strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc) {
+            tolerance = atoi(argv[++i]);
+        }
+    }
+
+    setupFirmware();
+
+    uint8_t checked = 0;
+    for (uint8_t set = GOLDEN_BODY; set <= GOLDEN_MOUTH; set++) {
+        const uint16_t leds = GoldenFrames::ledCount(set);
+        for (uint8_t p = 0; p < goldenFrames.patternCount(set); p++) {
+            std::vector<CRGB> frames(GOLDEN_FRAMES * leds);
+            Serial.setMuted(true);
+            goldenFrames.capture(set, p, frames.data());
+            Serial.setMuted(false);
+
+            std::vector<uint8_t> actual(frames.size() * 3);
+            for (size_t i = 0; i < frames.size(); i++) {
+                memcpy(&actual[i * 3], frames[i].raw, 3);
+            }
+
+            const char* name = goldenFrames.patternName(set, p);
+            std::string path = goldenPath(goldenDir, set, p, "");
+            if (update) {
+                CHECK(writePpm(path, name, leds, GOLDEN_FRAMES, actual));
+                printf("  %s: %s written\n", name, path.c_str());
+                continue;
+            }
+
+            std::vector<uint8_t> expected;
+            if (!readPpm(path, leds, GOLDEN_FRAMES, expected)) {
+                printf("  %s: cannot read %s (run with --update to create it)\n", name, path.c_str());
+                testFailures++;
+                continue;
+            }
+
+            std::vector<uint8_t> diffImage;
+            uint8_t maxDifference = 0;
+            uint8_t firstFailure = 0;
+            uint8_t failedFrames = compareFrames(expected, actual, leds, tolerance, diffImage,
+                                                 &maxDifference, &firstFailure);
+            checked++;
+            if (failedFrames == 0) {
+                printf("  %s: OK (max difference %u)\n", name, maxDifference);
+                continue;
+            }
+
+            // Rows: expected, actual, amplified difference - for every failing frame
+            std::string diffPath = goldenPath(diffDir, set, p, "_diff");
+            writePpm(diffPath, name, leds * DIFF_PIXEL_SCALE, failedFrames * 3 * DIFF_PIXEL_SCALE, diffImage);
+            printf("  %s: FAIL - %u frames differ by more than %d (max %u, first: %u), see %s\n",
+                   name, failedFrames, tolerance, maxDifference, firstFailure, diffPath.c_str());
+            testFailures++;
+        }
+    }
+
+    if (!update) {
+        printf("%u patterns checked, tolerance %d\n", checked, tolerance);
+    }
+    return testResult("test_golden_frames");
+}
@@ -0,0 +1,119 @@
+// test_led_layout.cpp - Flat LED buffer against the former per-panel arrays
+//
+// Patterns render into views of allLEDs and every output is sent straight
+// from it. Each frame, the views are copied into separate panel arrays the
+// way v5.1 kept them (eyes and mouth joined by mapEyesMouthArrays()), and
+// the bytes on every output's wire must equal those of the copies.
+#include "host_firmware.h"
+#include "host_test.h"
+#include "pattern_arena.h"
+#include "pattern_registry.h"
+#include "patterns_mouth.h"
+#include "render_clock.h"
+
+#define LAYOUT_FRAMES 40
+#define LAYOUT_FRAME_MS 20
+
+static uint32_t sampleCount = 0;
+
+// Loud enough for the audio patterns to move
+static int readTestSample() {
+    return 2048 + (sin16(sampleCount++ * 900) >> 5);
+}
+
+static void checkViews() {
+    CHECK(eyesMouthLEDs == &allLEDs[TOTAL_BODY_LEDS]);
+    CHECK(DJLEDs_Eyes == eyesMouthLEDs);
+    CHECK(DJLEDs_Mouth == &eyesMouthLEDs[NUM_EYES]);
+
+    // The outputs tile allLEDs without gaps or overlap
+    uint16_t next = 0;
+    for (uint8_t i = 0; i < NUM_LED_OUTPUTS; i++) {
+        CHECK(ledOutputs[i].leds == &allLEDs[next]);
+        next += ledOutputs[i].count;
+    }
+    CHECK_EQ(NUM_TOTAL_LEDS, next);
+    CHECK_EQ(NUM_LED_OUTPUTS, FastLED.count());
+}
+
+// Encodes panel copies with the output's settings and compares the wire bytes
+static bool wireMatches(uint8_t output, CRGB* copy, uint16_t count) {
+    static WS2812B<0, COLOR_ORDER> reference;
+    reference.setLeds(copy, count);
+    reference.setCorrection(LED_COLOR_CORRECTION);
+    reference.setTemperature(LED_COLOR_TEMPERATURE);
+    reference.showLeds(FastLED.getBrightness());
+
+    CLEDController& controller = FastLED[output];
+    return controller.size() == count &&
+           memcmp(controller.getWireData(), reference.getWireData(), count * 3) == 0;
+}
+
+static void renderAndCompare(uint8_t bodyPattern, uint8_t mouth) {
+    CRGB right[NUM_LEDS_PER_PANEL], middle[NUM_LEDS_PER_PANEL], left[NUM_LEDS_PER_PANEL];
+    CRGB eyes[NUM_EYES], mouthLeds[NUM_MOUTH_LEDS];
+    CRGB eyesMouthChain[NUM_EYES_MOUTH_LEDS];
+
+    currentPattern = bodyPattern;
+    mouthPattern = mouth;
+    resetPatternArenas();
+
+    for (uint8_t f = 0; f < LAYOUT_FRAMES; f++) {
+        beginFrame(TIME_SCALE_DEFAULT);
+        updateAudio();
+        takeAudioSnapshot();
+        bodyArena.render(currentPattern);
+        updateEyes();
+        updateMouth();
+        ledOutput.showAll();
+        advanceRenderClock(LAYOUT_FRAME_MS);
+
+        memcpy(right, DJLEDs_Right, sizeof(right));
+        memcpy(middle, DJLEDs_Middle, sizeof(middle));
+        memcpy(left, DJLEDs_Left, sizeof(left));
+        memcpy(eyes, DJLEDs_Eyes, sizeof(eyes));
+        memcpy(mouthLeds, DJLEDs_Mouth, sizeof(mouthLeds));
+
+        // mapEyesMouthArrays()
+        memcpy(eyesMouthChain, eyes, sizeof(eyes));
+        memcpy(&eyesMouthChain[NUM_EYES], mouthLeds, sizeof(mouthLeds));
+
+        bool ok = wireMatches(OUTPUT_RIGHT, right, NUM_LEDS_PER_PANEL) &&
+                  wireMatches(OUTPUT_MIDDLE, middle, NUM_LEDS_PER_PANEL) &&
+                  wireMatches(OUTPUT_LEFT, left, NUM_LEDS_PER_PANEL) &&
+                  wireMatches(OUTPUT_EYES_MOUTH, eyesMouthChain, NUM_EYES_MOUTH_LEDS);
+        if (!ok) {
+            printf("  body %u, mouth %s, eye mode %u: frame %u differs\n",
+                   bodyPattern, mouthPatterns[mouth].name, eyeMode, f);
+            testFailures++;
+            return;
+        }
+    }
+}
+
+int main() {
+    setupFirmware();
+    checkViews();
+
+    setRenderClockVirtual(0);
+    setAdcSource(readTestSample);
+    mouthEnabled = true;
+    Serial.setMuted(true);  // Debug mouth pattern prints every frame
+
+    // Every mouth pattern with every eye mode, flickering and static;
+    // the body cycles through its patterns alongside
+    uint8_t body = 1;
+    for (uint8_t flicker = 0; flicker < 2; flicker++) {
+        eyeFlickerEnabled = flicker;
+        for (eyeMode = 0; eyeMode < 3; eyeMode++) {
+            for (uint8_t mouth = 0; mouth < NUM_MOUTH_PATTERNS; mouth++) {
+                renderAndCompare(body, mouth);
+                body = (body + 1) % NUM_PATTERNS;
+            }
+        }
+    }
+
+    setAdcSource(nullptr);
+    setRenderClockLive();
+    return testResult("test_led_layout");
+}
@@ -0,0 +1,50 @@
+// test_render_clock.cpp - Render clock and ADC source seam on the host
+#include "render_clock.h"
+#include "host_test.h"
+
+static int fixedSample() {
+    return 1234;
+}
+
+int main() {
+    // The virtual clock only moves when advanced
+    setRenderClockVirtual(1000);
+    CHECK(isRenderClockVirtual());
+    CHECK_EQ(1000, renderMillis());
+    advanceRenderClock(20);
+    CHECK_EQ(1020, renderMillis());
+
+    // The animation clock follows at timeScale percent and FastLED reads it
+    resetFrameClock();
+    uint32_t start = frameContext().now;
+    advanceRenderClock(20);
+    const FrameContext& frame = beginFrame(100);
+    CHECK_EQ(20, frame.dt);
+    CHECK_EQ(start + 20, frame.now);
+    CHECK_EQ(frame.now, get_millisecond_timer());
+
+    advanceRenderClock(20);
+    CHECK_EQ(10, beginFrame(50).dt);
+    advanceRenderClock(1);
+    CHECK_EQ(0, beginFrame(50).dt);  // Half a millisecond is carried...
+    advanceRenderClock(1);
+    CHECK_EQ(1, beginFrame(50).dt);  // ...into the next frame
+
+    // The same animation time gives the same beat, the next frame a new one
+    uint8_t beat = beatsin8(60);
+    CHECK_EQ(beat, beatsin8(60));
+    advanceRenderClock(250);
+    beginFrame(100);
+    CHECK(beat != beatsin8(60));
+
+    // ADC seam: the host has no microphone, an injected source replaces it
+    CHECK_EQ(2048, readAdcSample());
+    setAdcSource(fixedSample);
+    CHECK_EQ(1234, readAdcSample());
+    setAdcSource(nullptr);
+    CHECK_EQ(2048, readAdcSample());
+
+    setRenderClockLive();
+    CHECK(!isRenderClockVirtual());
+    return testResult("test_render_clock");
+}
@@ -0,0 +1,94 @@
+// test_spectrum.cpp - FFT spectrum analyzer: band placement and timing
+//
+// A sine at the centre of each band has to come out strongest in that band,
+// the peak has to hold after the tone stops, and the cost of an update is
+// printed next to the firmware's own benchmark.
+#include "host_firmware.h"
+#include "host_test.h"
+#include "spectrum.h"
+#include <chrono>
+
+#define TONE_AMPLITUDE 100       // ADC counts around the DC offset
+#define TIMING_UPDATES 2000
+
+static float toneHz = 0;
+static uint32_t sampleCount = 0;
+
+static int readTone() {
+    float phase = 2.0f * (float)M_PI * toneHz * sampleCount++ / SPECTRUM_SAMPLE_RATE;
+    return adcDCOffset + (int)(TONE_AMPLITUDE * sinf(phase));
+}
+
+static void updateOnce() {
+    advanceRenderClock(SPECTRUM_INTERVAL_MS);
+    spectrumAnalyzer.update();
+}
+
+static float bandCentreHz(uint8_t band) {
+    float low = spectrumAnalyzer.getBandLowHz(band);
+    float high = (band + 1 < SPECTRUM_BANDS) ? spectrumAnalyzer.getBandLowHz(band + 1) : SPECTRUM_SAMPLE_RATE / 2.0f;
+    // Geometric centre, kept inside the top band below Nyquist
+    return min(sqrtf(low * high), SPECTRUM_SAMPLE_RATE * 0.45f);
+}
+
+static void checkToneBands() {
+    for (uint8_t band = 0; band < SPECTRUM_BANDS; band++) {
+        spectrumAnalyzer.reset();
+        toneHz = bandCentreHz(band);
+        updateOnce();
+
+        uint8_t strongest = 0;
+        for (uint8_t b = 1; b < SPECTRUM_BANDS; b++) {
+            if (spectrumAnalyzer.getBand(b) > spectrumAnalyzer.getBand(strongest)) strongest = b;
+        }
+        printf("  %5.0f Hz -> band %u (level %u)\n", toneHz, strongest, spectrumAnalyzer.getBand(strongest));
+        CHECK_EQ(band, strongest);
+        CHECK(spectrumAnalyzer.getBand(band) > 128);
+    }
+}
+
+static void checkPeakHold() {
+    spectrumAnalyzer.reset();
+    toneHz = bandCentreHz(3);
+    updateOnce();
+    uint8_t peak = spectrumAnalyzer.getPeak(3);
+
+    // Silence: the band decays at once, the peak only after the hold time
+    toneHz = 0;
+    for (uint32_t t = SPECTRUM_INTERVAL_MS; t < SPECTRUM_PEAK_HOLD_MS; t += SPECTRUM_INTERVAL_MS) {
+        updateOnce();
+    }
+    CHECK(spectrumAnalyzer.getBand(3) < peak);
+    CHECK_EQ(peak, spectrumAnalyzer.getPeak(3));
+    for (uint8_t i = 0; i < 4; i++) {
+        updateOnce();
+    }
+    CHECK(spectrumAnalyzer.getPeak(3) < peak);
+}
+
+static void printTiming() {
+    toneHz = 1000;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (uint16_t i = 0; i < TIMING_UPDATES; i++) {
+        updateOnce();
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    printf("Host: %.0f ns per update (capture + %u-point FFT + bands), budget %u us per %u ms\n",
+           ns / TIMING_UPDATES, SPECTRUM_FFT_SIZE, SPECTRUM_INTERVAL_MS * 1000, SPECTRUM_INTERVAL_MS);
+
+    spectrumAnalyzer.runBenchmark(TIMING_UPDATES);
+}
+
+int main() {
+    setupFirmware();
+    setRenderClockVirtual(0);
+    setAdcSource(readTone);
+
+    checkToneBands();
+    checkPeakHold();
+    printTiming();
+
+    setAdcSource(nullptr);
+    setRenderClockLive();
+    return testResult("test_spectrum");
+}
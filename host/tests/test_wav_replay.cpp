@@ -0,0 +1,277 @@
+// test_wav_replay.cpp - WAV parsing, streaming and the emulated ADC front end
+//
+// WAV images are built in memory, so every format corner can be covered
+// without sample files: layouts, resampling, looping, rejected files, and a
+// tone streamed through the ADC path faster than real time.
+#include "host_firmware.h"
+#include "host_test.h"
+#include "adc_stream.h"
+#include "audio_replay.h"
+#include <chrono>
+#include <vector>
+
+#define NOISE_LSB 2        // emulateAdcSample() adds +-2 LSB
+#define STREAM_SECONDS 60
+
+// Minimal RIFF/WAVE writer; extra chunks and field overrides for broken files
+struct WavBuilder {
+    uint16_t format = 1;
+    uint16_t channels = 1;
+    uint32_t rate = ADC_DMA_SAMPLE_RATE;
+    uint16_t bits = 16;
+    bool listChunk = false;    // Odd-sized chunk before "fmt "
+    bool dataChunk = true;
+    uint32_t truncateBy = 0;   // Bytes cut off the end of the file
+    std::vector<uint8_t> data;
+
+    void addSample(int32_t value) {
+        if (bits == 8) {
+            data.push_back((uint8_t)value);
+        } else {
+            data.push_back(value & 0xFF);
+            data.push_back((value >> 8) & 0xFF);
+        }
+    }
+
+    std::vector<uint8_t> build() const {
+        std::vector<uint8_t> wav;
+        append(wav, "RIFF", 0);
+        putId(wav, "WAVE");
+        if (listChunk) {
+            append(wav, "LIST", 3);
+            wav.insert(wav.end(), {'a', 'b', 'c', 0});  // Padding byte
+        }
+        append(wav, "fmt ", 16);
+        put16(wav, format);
+        put16(wav, channels);
+        put32(wav, rate);
+        put32(wav, rate * channels * bits / 8);
+        put16(wav, channels * bits / 8);
+        put16(wav, bits);
+        if (dataChunk) {
+            append(wav, "data", data.size());
+            wav.insert(wav.end(), data.begin(), data.end());
+        }
+        uint32_t riffSize = wav.size() - 8;
+        memcpy(&wav[4], &riffSize, 4);
+        wav.resize(wav.size() - truncateBy);
+        return wav;
+    }
+
+    static void put16(std::vector<uint8_t>& wav, uint16_t value) {
+        wav.push_back(value & 0xFF);
+        wav.push_back(value >> 8);
+    }
+
+    static void put32(std::vector<uint8_t>& wav, uint32_t value) {
+        put16(wav, value & 0xFFFF);
+        put16(wav, value >> 16);
+    }
+
+    static void putId(std::vector<uint8_t>& wav, const char* id) {
+        for (uint8_t i = 0; i < 4; i++) wav.push_back(id[i]);
+    }
+
+    static void append(std::vector<uint8_t>& wav, const char* id, uint32_t size) {
+        putId(wav, id);
+        put32(wav, size);
+    }
+};
+
+static int expectedAdc(int32_t pcmQ15) {
+    int32_t fullScale = (audioInputMode == INPUT_LINE_IN) ? REPLAY_LINE_IN_FULL_SCALE : REPLAY_MIC_FULL_SCALE;
+    return constrain(REPLAY_DC_OFFSET + ((pcmQ15 * fullScale) >> 15), 0, 4095);
+}
+
+static bool nearAdc(int actual, int32_t pcmQ15) {
+    return abs(actual - expectedAdc(pcmQ15)) <= NOISE_LSB;
+}
+
+static void checkFormats() {
+    // 16-bit mono at the ADC rate: one frame per sample, then it loops
+    WavBuilder mono;
+    const int16_t ramp[] = {0, 8192, 16384, 32767, -8192, -32768};
+    for (int16_t value : ramp) mono.addSample(value);
+    std::vector<uint8_t> image = mono.build();
+    WavSource wav;
+    CHECK(wav.open(image.data(), image.size()));
+    CHECK_EQ(ADC_DMA_SAMPLE_RATE, wav.getSampleRate());
+    CHECK_EQ(1, wav.getChannels());
+    CHECK_EQ(16, wav.getBits());
+    for (uint8_t pass = 0; pass < 2; pass++) {
+        for (int16_t value : ramp) CHECK(nearAdc(wav.nextSample(), value));
+    }
+    wav.rewind();
+    CHECK(nearAdc(wav.nextSample(), ramp[0]));
+
+    // Stereo is mixed to mono
+    WavBuilder stereo;
+    stereo.channels = 2;
+    stereo.addSample(20000);
+    stereo.addSample(-20000);
+    stereo.addSample(10000);
+    stereo.addSample(10000);
+    image = stereo.build();
+    CHECK(wav.open(image.data(), image.size()));
+    CHECK(nearAdc(wav.nextSample(), 0));
+    CHECK(nearAdc(wav.nextSample(), 10000));
+
+    // 8-bit unsigned around 128
+    WavBuilder eightBit;
+    eightBit.bits = 8;
+    eightBit.addSample(128);
+    eightBit.addSample(255);
+    eightBit.addSample(0);
+    image = eightBit.build();
+    CHECK(wav.open(image.data(), image.size()));
+    CHECK_EQ(8, wav.getBits());
+    CHECK(nearAdc(wav.nextSample(), 0));
+    CHECK(nearAdc(wav.nextSample(), 127 * 256));
+    CHECK(nearAdc(wav.nextSample(), -128 * 256));
+
+    // Line-in uses the wider input range
+    audioInputMode = INPUT_LINE_IN;
+    wav.rewind();
+    wav.nextSample();
+    int lineIn = wav.nextSample();
+    audioInputMode = INPUT_MIC;
+    CHECK(nearAdc(lineIn, 127 * 256 * REPLAY_LINE_IN_FULL_SCALE / REPLAY_MIC_FULL_SCALE));
+
+    // Unknown chunks are skipped, including an odd-sized one
+    WavBuilder listed;
+    listed.listChunk = true;
+    listed.addSample(16384);
+    image = listed.build();
+    CHECK(wav.open(image.data(), image.size()));
+    CHECK(nearAdc(wav.nextSample(), 16384));
+}
+
+static void checkResampling() {
+    // 20 kHz: every other frame; 5 kHz: every frame twice
+    WavBuilder fast;
+    fast.rate = 2 * ADC_DMA_SAMPLE_RATE;
+    for (int16_t i = 0; i < 8; i++) fast.addSample(i * 4096);
+    std::vector<uint8_t> image = fast.build();
+    WavSource wav;
+    CHECK(wav.open(image.data(), image.size()));
+    CHECK_EQ(8 * 1000 / (2 * ADC_DMA_SAMPLE_RATE), wav.getDurationMs());
+    for (int16_t i = 0; i < 4; i++) CHECK(nearAdc(wav.nextSample(), i * 8192));
+    CHECK(nearAdc(wav.nextSample(), 0));  // Looped
+
+    WavBuilder slow;
+    slow.rate = ADC_DMA_SAMPLE_RATE / 2;
+    slow.addSample(4096);
+    slow.addSample(-4096);
+    image = slow.build();
+    CHECK(wav.open(image.data(), image.size()));
+    CHECK(nearAdc(wav.nextSample(), 4096));
+    CHECK(nearAdc(wav.nextSample(), 4096));
+    CHECK(nearAdc(wav.nextSample(), -4096));
+    CHECK(nearAdc(wav.nextSample(), -4096));
+
+    // A file shorter than one resampling step still loops inside its frames
+    WavBuilder tiny;
+    tiny.rate = 44100;
+    for (int16_t i = 0; i < 3; i++) tiny.addSample(1000 * (i + 1));
+    image = tiny.build();
+    CHECK(wav.open(image.data(), image.size()));
+    for (uint16_t i = 0; i < 1000; i++) {
+        int sample = wav.nextSample();
+        CHECK(nearAdc(sample, 1000) || nearAdc(sample, 2000) || nearAdc(sample, 3000));
+    }
+}
+
+static void checkRejected() {
+    WavSource wav;
+    WavBuilder valid;
+    valid.addSample(0);
+    valid.addSample(0);
+
+    WavBuilder builder = valid;
+    builder.format = 3;  // IEEE float
+    std::vector<uint8_t> image = builder.build();
+    CHECK(!wav.open(image.data(), image.size()));
+
+    builder = valid;
+    builder.bits = 24;
+    image = builder.build();
+    CHECK(!wav.open(image.data(), image.size()));
+
+    builder = valid;
+    builder.channels = 3;
+    image = builder.build();
+    CHECK(!wav.open(image.data(), image.size()));
+
+    builder = valid;
+    builder.rate = 0;
+    image = builder.build();
+    CHECK(!wav.open(image.data(), image.size()));
+
+    builder = valid;
+    builder.dataChunk = false;
+    image = builder.build();
+    CHECK(!wav.open(image.data(), image.size()));
+
+    builder = valid;
+    builder.data.clear();
+    image = builder.build();
+    CHECK(!wav.open(image.data(), image.size()));
+
+    image = valid.build();
+    image[0] = 'X';
+    CHECK(!wav.open(image.data(), image.size()));
+    CHECK(!wav.open(image.data(), 11));
+    CHECK(!wav.isOpen());
+    CHECK_EQ(REPLAY_DC_OFFSET, wav.nextSample());
+
+    // A truncated data chunk plays the complete frames that are there
+    builder = WavBuilder();
+    builder.addSample(12000);
+    builder.addSample(-12000);
+    builder.truncateBy = 1;
+    image = builder.build();
+    CHECK(wav.open(image.data(), image.size()));
+    CHECK(nearAdc(wav.nextSample(), 12000));
+    CHECK(nearAdc(wav.nextSample(), 12000));
+}
+
+// A 1 kHz tone through the ADC stream on the virtual clock
+static void checkStreaming() {
+    const int16_t amplitude = 16384;
+    WavBuilder tone;
+    for (uint16_t i = 0; i < ADC_DMA_SAMPLE_RATE; i++) {
+        tone.addSample((int32_t)(amplitude * sinf(2.0f * (float)M_PI * 1000 * i / ADC_DMA_SAMPLE_RATE)));
+    }
+    std::vector<uint8_t> image = tone.build();
+    WavSource wav;
+    CHECK(wav.open(image.data(), image.size()));
+
+    setRenderClockVirtual(0);
+    adcStream.setSource(&wav);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (uint32_t ms = 0; ms < STREAM_SECONDS * 1000UL; ms += FRAME_DELAY_MS) {
+        advanceRenderClock(FRAME_DELAY_MS);
+        adcStream.service();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    adcStream.setSource(nullptr);
+
+    // DC removed, RMS of the sine in ADC counts
+    int expectedRms = (int)(amplitude * REPLAY_MIC_FULL_SCALE / 32768 / sqrtf(2.0f));
+    printf("  %u s streamed in %.3f s (%.0fx real time), block RMS %u (expected %d)\n",
+           STREAM_SECONDS, seconds, STREAM_SECONDS / seconds, adcStream.getRms(), expectedRms);
+    CHECK(abs(adcStream.getRms() - expectedRms) <= expectedRms / 20);
+}
+
+int main() {
+    setupFirmware();
+    audioInputMode = INPUT_MIC;
+
+    checkFormats();
+    checkResampling();
+    checkRejected();
+    checkStreaming();
+
+    setRenderClockLive();
+    return testResult("test_wav_replay");
+}